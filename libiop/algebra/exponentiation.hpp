@@ -22,6 +22,14 @@ template<typename FieldT>
 std::vector<FieldT> subspace_element_powers(const affine_subspace<FieldT> &S,
                                             const std::size_t exponent);
 
+/** Returns subspace_element_powers(S, exponents[i]) for every i, sharing work between the
+ *  exponents: each x^{2^j} table is computed once, and each exponent starts from the largest
+ *  exponent already computed whose bits are a subset of its own. */
+template<typename FieldT>
+std::vector<std::vector<FieldT>> subspace_element_powers_for_exponents(
+    const affine_subspace<FieldT> &S,
+    const std::vector<std::size_t> &exponents);
+
 template<typename FieldT>
 std::vector<FieldT> coset_element_powers(const multiplicative_coset<FieldT> &S,
                                          const std::size_t exponent);
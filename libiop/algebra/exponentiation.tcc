@@ -1,3 +1,9 @@
+#include <algorithm>
+#include <bitset>
+#include <numeric>
+
+#include "libiop/common/parallel.hpp"
+
 namespace libiop {
 
 template<typename FieldT>
@@ -53,6 +59,97 @@ std::vector<FieldT> subspace_element_powers(const affine_subspace<FieldT> &S,
     return result;
 }
 
+template<typename FieldT>
+std::vector<std::vector<FieldT>> subspace_element_powers_for_exponents(
+    const affine_subspace<FieldT> &S,
+    const std::vector<std::size_t> &exponents)
+{
+    const std::size_t num_bits = 8 * sizeof(std::size_t);
+    std::vector<std::size_t> order(exponents.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&exponents](const std::size_t a, const std::size_t b) {
+        return exponents[a] < exponents[b];
+    });
+
+    /* How many of the remaining exponents have bit j set, so that the x^{2^j} table
+       can be freed once none does. */
+    std::vector<std::size_t> remaining_uses(num_bits, 0);
+    for (const std::size_t exponent : exponents)
+    {
+        for (std::size_t j = 0; j < num_bits; ++j)
+        {
+            remaining_uses[j] += (exponent >> j) & 1;
+        }
+    }
+    std::vector<std::vector<FieldT>> two_to_j_powers(num_bits);
+
+    std::vector<std::vector<FieldT>> result(exponents.size());
+    for (std::size_t k = 0; k < order.size(); ++k)
+    {
+        const std::size_t exponent = exponents[order[k]];
+
+        /* Start from the computed exponent sharing the most bits with this one */
+        std::size_t base = 0;
+        std::size_t base_index = 0;
+        for (std::size_t l = 0; l < k; ++l)
+        {
+            const std::size_t candidate = exponents[order[l]];
+            if ((candidate & ~exponent) == 0 &&
+                std::bitset<8 * sizeof(std::size_t)>(candidate).count() >
+                std::bitset<8 * sizeof(std::size_t)>(base).count())
+            {
+                base = candidate;
+                base_index = order[l];
+            }
+        }
+
+        std::vector<FieldT> &powers = result[order[k]];
+        if (base != 0)
+        {
+            powers = result[base_index];
+        }
+        for (std::size_t j = 0; j < num_bits; ++j)
+        {
+            if (!((exponent >> j) & 1))
+            {
+                continue;
+            }
+            if (!((base >> j) & 1))
+            {
+                if (two_to_j_powers[j].empty())
+                {
+                    two_to_j_powers[j] = subspace_to_power_of_two(S, 1ull << j);
+                }
+                if (powers.empty())
+                {
+                    powers = two_to_j_powers[j];
+                }
+                else
+                {
+                    const std::vector<FieldT> &factor = two_to_j_powers[j];
+#ifdef MULTICORE
+                    #pragma omp parallel for if (powers.size() >= parallel_min_size)
+#endif
+                    for (std::size_t i = 0; i < powers.size(); ++i)
+                    {
+                        powers[i] *= factor[i];
+                    }
+                }
+            }
+            if (--remaining_uses[j] == 0)
+            {
+                std::vector<FieldT>().swap(two_to_j_powers[j]);
+            }
+        }
+        if (exponent == 0)
+        {
+            powers.assign(S.num_elements(), FieldT::one());
+        }
+    }
+
+    return result;
+}
+
 template<typename FieldT>
 std::vector<FieldT> coset_element_powers(const multiplicative_coset<FieldT> &S,
                                          const std::size_t exponent)
@@ -1,6 +1,6 @@
 /**@file
  *****************************************************************************
- Implementation of Gao-Mateer for the additive FFT/IFFT,
+ Implementation of Gao-Mateer and Cantor for the additive FFT/IFFT,
  implementation of Nlog(d) Cooley-Tukey for the multiplicative FFT,
  and wrappers to libfqfft for the multiplicative IFFT.
  *****************************************************************************
@@ -15,6 +15,7 @@
 #include "libiop/algebra/field_subset/field_subset.hpp"
 #include "libiop/algebra/field_subset/subspace.hpp"
 #include "libiop/algebra/field_subset/subgroup.hpp"
+#include "libiop/algebra/field_subset/additive_fft_plan.hpp"
 #include <libff/common/utils.hpp>
 
 namespace libiop {
@@ -33,6 +34,52 @@ template<typename FieldT>
 std::vector<FieldT> additive_IFFT(const std::vector<FieldT> &evals,
                                   const affine_subspace<FieldT> &domain);
 
+/* Cantor's additive FFT, over an affine subspace whose basis is a Cantor basis
+   (basis[0] = 1 and basis[i-1] = basis[i]^2 + basis[i]), with an arbitrary shift. */
+template<typename FieldT>
+std::vector<FieldT> cantor_additive_FFT(const std::vector<FieldT> &poly_coeffs,
+                                        const affine_subspace<FieldT> &domain);
+
+template<typename FieldT>
+std::vector<FieldT> cantor_additive_IFFT(const std::vector<FieldT> &evals,
+                                         const affine_subspace<FieldT> &domain);
+
+/* In-place variants of the additive transforms. The FFT grows v to the domain size. */
+template<typename FieldT>
+void additive_FFT_in_place(std::vector<FieldT> &v,
+                           const affine_subspace<FieldT> &domain);
+
+template<typename FieldT>
+void additive_IFFT_in_place(std::vector<FieldT> &v,
+                            const affine_subspace<FieldT> &domain);
+
+template<typename FieldT>
+void cantor_additive_FFT_in_place(std::vector<FieldT> &v,
+                                  const affine_subspace<FieldT> &domain);
+
+template<typename FieldT>
+void cantor_additive_IFFT_in_place(std::vector<FieldT> &v,
+                                   const affine_subspace<FieldT> &domain);
+
+/* Batched variants, which transform several vectors over the same domain at once.
+   The per-domain twiddles are computed once, and the vectors are interleaved so that
+   each twiddle is applied to all of them together. */
+template<typename FieldT>
+std::vector<std::vector<FieldT>> additive_batch_FFT(const std::vector<std::vector<FieldT>> &polys_coeffs,
+                                                    const affine_subspace<FieldT> &domain);
+
+template<typename FieldT>
+std::vector<std::vector<FieldT>> additive_batch_IFFT(const std::vector<std::vector<FieldT>> &evals,
+                                                     const affine_subspace<FieldT> &domain);
+
+template<typename FieldT>
+std::vector<std::vector<FieldT>> cantor_additive_batch_FFT(const std::vector<std::vector<FieldT>> &polys_coeffs,
+                                                           const affine_subspace<FieldT> &domain);
+
+template<typename FieldT>
+std::vector<std::vector<FieldT>> cantor_additive_batch_IFFT(const std::vector<std::vector<FieldT>> &evals,
+                                                            const affine_subspace<FieldT> &domain);
+
 /* Calls additive_FFT but adds trace data */
 template<typename FieldT>
 std::vector<FieldT> additive_FFT_wrapper(const std::vector<FieldT> &v,
@@ -43,6 +90,40 @@ template<typename FieldT>
 std::vector<FieldT> additive_IFFT_wrapper(const std::vector<FieldT> &v,
                                           const affine_subspace<FieldT> &H);
 
+template<typename FieldT>
+void additive_FFT_in_place_wrapper(std::vector<FieldT> &v,
+                                   const affine_subspace<FieldT> &H);
+
+template<typename FieldT>
+void additive_IFFT_in_place_wrapper(std::vector<FieldT> &v,
+                                    const affine_subspace<FieldT> &H);
+
+/* Calls additive_batch_FFT but adds trace data */
+template<typename FieldT>
+std::vector<std::vector<FieldT>> additive_batch_FFT_wrapper(const std::vector<std::vector<FieldT>> &v,
+                                                            const affine_subspace<FieldT> &H);
+
+/* Calls additive_batch_IFFT but adds trace data */
+template<typename FieldT>
+std::vector<std::vector<FieldT>> additive_batch_IFFT_wrapper(const std::vector<std::vector<FieldT>> &v,
+                                                             const affine_subspace<FieldT> &H);
+
+template<typename FieldT>
+void multiplicative_FFT_in_place(std::vector<FieldT> &a,
+                                 const multiplicative_coset<FieldT> &domain);
+
+template<typename FieldT>
+void multiplicative_IFFT_in_place(std::vector<FieldT> &a,
+                                  const multiplicative_coset<FieldT> &domain);
+
+template<typename FieldT>
+void multiplicative_FFT_in_place_wrapper(std::vector<FieldT> &v,
+                                         const multiplicative_coset<FieldT> &H);
+
+template<typename FieldT>
+void multiplicative_IFFT_in_place_wrapper(std::vector<FieldT> &v,
+                                          const multiplicative_coset<FieldT> &H);
+
 template<typename FieldT>
 std::vector<FieldT> multiplicative_FFT(const std::vector<FieldT> &poly_coeffs,
                                        const multiplicative_coset<FieldT> &domain);
@@ -60,32 +141,76 @@ std::vector<FieldT> multiplicative_IFFT_wrapper(const std::vector<FieldT> &v,
                                                 const multiplicative_coset<FieldT> &H);
 
 template<typename FieldT>
-std::vector<FieldT> FFT_over_field_subset(const std::vector<typename libff::enable_if<libff::is_multiplicative<FieldT>::value, FieldT>::type> coeffs,
-                                            field_subset<FieldT> domain);
+std::vector<FieldT> FFT_over_field_subset(const std::vector<typename libff::enable_if<libff::is_multiplicative<FieldT>::value, FieldT>::type> &coeffs,
+                                          const field_subset<FieldT> &domain);
+
+template<typename FieldT>
+std::vector<FieldT> FFT_over_field_subset(const std::vector<typename libff::enable_if<libff::is_additive<FieldT>::value, FieldT>::type> &coeffs,
+                                          const field_subset<FieldT> &domain);
+
+template<typename FieldT>
+std::vector<FieldT> IFFT_over_field_subset(const std::vector<typename libff::enable_if<libff::is_multiplicative<FieldT>::value, FieldT>::type> &evals,
+                                           const field_subset<FieldT> &domain);
+
+template<typename FieldT>
+std::vector<FieldT> IFFT_over_field_subset(const std::vector<typename libff::enable_if<libff::is_additive<FieldT>::value, FieldT>::type> &evals,
+                                           const field_subset<FieldT> &domain);
+
+/* In-place variants of the transforms above. The input vector is overwritten with the result
+   and, for the FFT, grown to the domain size, so callers that reserve domain.num_elements()
+   up front avoid allocating for the result. The exception is a serial build transforming a
+   Cantor-basis subspace at full size, which goes through the external Cantor kernel: that
+   kernel returns its result in a new vector, so one result buffer is allocated. */
+template<typename FieldT>
+void FFT_over_field_subset_in_place(std::vector<typename libff::enable_if<libff::is_multiplicative<FieldT>::value, FieldT>::type> &v,
+                                    const field_subset<FieldT> &domain);
+
+template<typename FieldT>
+void FFT_over_field_subset_in_place(std::vector<typename libff::enable_if<libff::is_additive<FieldT>::value, FieldT>::type> &v,
+                                    const field_subset<FieldT> &domain);
+
+template<typename FieldT>
+void IFFT_over_field_subset_in_place(std::vector<typename libff::enable_if<libff::is_multiplicative<FieldT>::value, FieldT>::type> &v,
+                                     const field_subset<FieldT> &domain);
+
+template<typename FieldT>
+void IFFT_over_field_subset_in_place(std::vector<typename libff::enable_if<libff::is_additive<FieldT>::value, FieldT>::type> &v,
+                                     const field_subset<FieldT> &domain);
+
+/* Transforms every vector in the batch over the same domain. For additive domains this shares
+   the per-domain precomputation across the batch; for multiplicative domains it reuses the FFT
+   cache and the evaluation domain. */
+template<typename FieldT>
+std::vector<std::vector<FieldT>> batch_FFT_over_field_subset(
+    const std::vector<std::vector<typename libff::enable_if<libff::is_multiplicative<FieldT>::value, FieldT>::type>> &coeffs,
+    const field_subset<FieldT> &domain);
 
 template<typename FieldT>
-std::vector<FieldT> FFT_over_field_subset(const std::vector<typename libff::enable_if<libff::is_additive<FieldT>::value, FieldT>::type> coeffs,
-                                            field_subset<FieldT> domain);
+std::vector<std::vector<FieldT>> batch_FFT_over_field_subset(
+    const std::vector<std::vector<typename libff::enable_if<libff::is_additive<FieldT>::value, FieldT>::type>> &coeffs,
+    const field_subset<FieldT> &domain);
 
 template<typename FieldT>
-std::vector<FieldT> IFFT_over_field_subset(const std::vector<typename libff::enable_if<libff::is_multiplicative<FieldT>::value, FieldT>::type> evals,
-                                             field_subset<FieldT> domain);
+std::vector<std::vector<FieldT>> batch_IFFT_over_field_subset(
+    const std::vector<std::vector<typename libff::enable_if<libff::is_multiplicative<FieldT>::value, FieldT>::type>> &evals,
+    const field_subset<FieldT> &domain);
 
 template<typename FieldT>
-std::vector<FieldT> IFFT_over_field_subset(const std::vector<typename libff::enable_if<libff::is_additive<FieldT>::value, FieldT>::type> evals,
-                                             field_subset<FieldT> domain);
+std::vector<std::vector<FieldT>> batch_IFFT_over_field_subset(
+    const std::vector<std::vector<typename libff::enable_if<libff::is_additive<FieldT>::value, FieldT>::type>> &evals,
+    const field_subset<FieldT> &domain);
 
 template<typename FieldT>
 std::vector<FieldT> IFFT_of_known_degree_over_field_subset(
-    const std::vector<typename libff::enable_if<libff::is_multiplicative<FieldT>::value, FieldT>::type> evals,
+    const std::vector<typename libff::enable_if<libff::is_multiplicative<FieldT>::value, FieldT>::type> &evals,
     size_t degree_bound,
-    field_subset<FieldT> domain);
+    const field_subset<FieldT> &domain);
 
 template<typename FieldT>
 std::vector<FieldT> IFFT_of_known_degree_over_field_subset(
-    const std::vector<typename libff::enable_if<libff::is_additive<FieldT>::value, FieldT>::type> evals,
+    const std::vector<typename libff::enable_if<libff::is_additive<FieldT>::value, FieldT>::type> &evals,
     size_t degree_bound,
-    field_subset<FieldT> domain);
+    const field_subset<FieldT> &domain);
 
 } // namespace libiop
 
@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <cstddef>
+#include <utility>
 
 #include <cstdint>
 #include <libfqfft/evaluation_domain/domains/basic_radix2_domain.hpp>
@@ -6,9 +8,10 @@
 
 #include <libff/common/profiling.hpp>
 #include <libff/algebra/field_utils/field_utils.hpp>
+#include "libiop/algebra/field_kernels.hpp"
 #include "libiop/algebra/utils.hpp"
+#include "libiop/common/parallel.hpp"
 #include "depends/additive-fft/C++/Cantor/fft.hpp"
-#include "depends/additive-fft/C++/LCH/fft.hpp"
 
 namespace libiop {
 
@@ -39,138 +42,227 @@ std::vector<FieldT> naive_FFT(const std::vector<FieldT> &poly_coeffs,
     return result;
 }
 
+/** The additive FFT kernels below work in place over a batch of width vectors, stored interleaved:
+ *  element i of vector v is S[i * width + v]. All twiddles depend only on the domain, so they are
+ *  computed once per batch, and each butterfly applies one twiddle to width consecutive elements. */
 template<typename FieldT>
-std::vector<FieldT> additive_FFT(const std::vector<FieldT> &poly_coeffs,
-                                 const affine_subspace<FieldT> &domain)
+std::vector<FieldT> interleave_vectors(const std::vector<std::vector<FieldT>> &vectors,
+                                       const size_t num_elements)
 {
-    std::vector<FieldT> S(poly_coeffs);
-    S.resize(domain.num_elements(), FieldT::zero());
+    const size_t width = vectors.size();
+    std::vector<FieldT> S(num_elements * width, FieldT::zero());
+    for (size_t v = 0; v < width; ++v)
+    {
+        assert(vectors[v].size() <= num_elements);
+        for (size_t i = 0; i < vectors[v].size(); ++i)
+        {
+            S[i * width + v] = vectors[v][i];
+        }
+    }
 
-    const size_t n = S.size();
-    const size_t m = domain.dimension();
-    assert(n == (1ull<<m));
+    return S;
+}
 
-    std::vector<FieldT> recursed_betas((m+1)*m/2, FieldT(0));
-    std::vector<FieldT> recursed_shifts(m, FieldT(0));
-    size_t recursed_betas_ptr = 0;
+template<typename FieldT>
+size_t max_vector_size(const std::vector<std::vector<FieldT>> &vectors)
+{
+    size_t max_size = 0;
+    for (const std::vector<FieldT> &v : vectors)
+    {
+        max_size = std::max(max_size, v.size());
+    }
+    return max_size;
+}
 
-    std::vector<FieldT> betas2(domain.basis());
-    FieldT shift2 = domain.shift();
-    for (size_t j = 0; j < m; ++j)
+template<typename FieldT>
+std::vector<std::vector<FieldT>> deinterleave_vectors(const std::vector<FieldT> &S,
+                                                      const size_t width)
+{
+    const size_t num_elements = S.size() / width;
+    std::vector<std::vector<FieldT>> vectors(width, std::vector<FieldT>(num_elements));
+    for (size_t i = 0; i < num_elements; ++i)
+    {
+        for (size_t v = 0; v < width; ++v)
+        {
+            vectors[v][i] = S[i * width + v];
+        }
+    }
+
+    return vectors;
+}
+
+/** Bit-reverses the order of the first 2^log_n points of S, which holds width interleaved vectors. */
+template<typename FieldT>
+void bitreverse_interleaved(std::vector<FieldT> &S, const size_t width, const size_t log_n)
+{
+    const size_t n = 1ull<<log_n;
+    assert(n * width <= S.size());
+    if (width == 1 && n == S.size())
+    {
+        bitreverse_vector<FieldT>(S);
+        return;
+    }
+
+#ifdef MULTICORE
+    #pragma omp parallel for if (n * width >= parallel_min_size)
+#endif
+    for (size_t k = 0; k < n; ++k)
     {
-        FieldT beta = betas2[m-1-j];
-        FieldT betai(1);
+        const size_t rk = libff::bitreverse(k, log_n);
+        if (k < rk)
+        {
+            std::swap_ranges(S.begin() + k * width, S.begin() + (k+1) * width, S.begin() + rk * width);
+        }
+    }
+}
+
+/** Gao-Mateer additive FFT. Only the first 2^log_num_coeffs points of S may be non-zero,
+ *  i.e. the polynomials have degree < 2^log_num_coeffs.
+ *
+ *  The forward recursion never moves coefficients past 2^log_num_coeffs, so its levels only
+ *  touch that prefix, and levels j >= log_num_coeffs (twists by beta^0 and radix conversions of
+ *  zeros) are skipped. After the bit reversal, the non-zero points sit at multiples of
+ *  2^{m - log_num_coeffs}, so the first m - log_num_coeffs unwinding levels only copy each of them
+ *  over the following points. Both are done directly, leaving log_num_coeffs levels of butterflies
+ *  over the whole domain, like multiplicative_FFT_degree_aware. */
+template<typename FieldT>
+void additive_FFT_interleaved(std::vector<FieldT> &S,
+                              const size_t width,
+                              const additive_fft_plan<FieldT> &plan,
+                              const size_t log_num_coeffs)
+{
+    assert(plan.type() == gao_mateer_additive_fft);
+    const size_t m = plan.dimension();
+    const size_t n = 1ull<<m;
+    assert(S.size() == n * width);
+    assert(log_num_coeffs <= m);
+    const size_t total = S.size();
+
+    const size_t num_coeffs = 1ull<<log_num_coeffs;
+    const size_t coeffs_total = num_coeffs * width;
+    for (size_t j = 0; j < log_num_coeffs; ++j)
+    {
+        const FieldT beta = plan.twist(j);
 
         /* twist by beta. TODO: this can often be elided by a careful choice of betas */
-        for (size_t ofs = 0; ofs < n; ofs += (1ull<<j))
+        const size_t num_twist_blocks = num_coeffs >> j;
+        const size_t block_size = (1ull<<j) * width;
+        const size_t num_chunks = num_parallel_chunks(num_twist_blocks);
+#ifdef MULTICORE
+        #pragma omp parallel for if (coeffs_total >= parallel_min_size)
+#endif
+        for (size_t c = 0; c < num_chunks; ++c)
         {
-            for (size_t p = 0; p < (1ull<<j); ++p)
+            const size_t first_block = chunk_begin(c, num_chunks, num_twist_blocks);
+            const size_t last_block = chunk_begin(c+1, num_chunks, num_twist_blocks);
+            FieldT betai = libff::power(beta, first_block);
+            for (size_t ofs = first_block * block_size; ofs < last_block * block_size; ofs += block_size)
             {
-                S[ofs + p] *= betai;
+                mul_by_constant<FieldT>(&S[ofs], block_size, betai);
+                betai *= beta;
             }
-
-            betai *= beta;
         }
 
         /* perform radix conversion */
-        for (size_t stride = n/4; stride >= (1ul << j); stride >>= 1)
+        for (size_t stride = num_coeffs/4; stride >= (1ul << j); stride >>= 1)
         {
-            for (size_t ofs = 0; ofs < n; ofs += stride*4)
+            const size_t wide_stride = stride * width;
+#ifdef MULTICORE
+            #pragma omp parallel for collapse(2) if (coeffs_total >= parallel_min_size)
+#endif
+            for (size_t ofs = 0; ofs < coeffs_total; ofs += wide_stride*4)
             {
-                for (size_t i = 0; i < stride; ++i)
+                for (size_t i = 0; i < wide_stride; ++i)
                 {
-                    S[ofs+2*stride+i] += S[ofs+3*stride+i];
-                    S[ofs+1*stride+i] += S[ofs+2*stride+i];
+                    S[ofs+2*wide_stride+i] += S[ofs+3*wide_stride+i];
+                    S[ofs+1*wide_stride+i] += S[ofs+2*wide_stride+i];
                 }
             }
         }
+    }
 
-        /* compute deltas used in the reverse process */
-        FieldT betainv = beta.inverse();
-        for (size_t i = 0; i < m-1-j; ++i)
+    bitreverse_interleaved<FieldT>(S, width, log_num_coeffs);
+
+    const size_t log_num_copies = m - log_num_coeffs;
+    if (log_num_copies > 0)
+    {
+        /* point k of the prefix goes to position k * 2^log_num_copies, and is copied over the
+           2^log_num_copies positions starting there */
+        const std::vector<FieldT> coeffs(S.begin(), S.begin() + coeffs_total);
+        const size_t copies_size = (1ull<<log_num_copies) * width;
+#ifdef MULTICORE
+        #pragma omp parallel for if (total >= parallel_min_size)
+#endif
+        for (size_t k = 0; k < num_coeffs; ++k)
         {
-            FieldT newbeta = betas2[i] * betainv;
-            recursed_betas[recursed_betas_ptr++] = newbeta;
-            betas2[i] = newbeta.squared() - newbeta;
+            for (size_t ofs = k * copies_size; ofs < (k+1) * copies_size; ofs += width)
+            {
+                std::copy_n(coeffs.begin() + k * width, width, S.begin() + ofs);
+            }
         }
-
-        FieldT newshift = shift2 * betainv;
-        recursed_shifts[j] = newshift;
-        shift2 = newshift.squared() - newshift;
     }
 
-    bitreverse_vector<FieldT>(S);
-
     /* unwind the recursion */
-    for (size_t j = 0; j < m; ++j)
+    for (size_t j = log_num_copies; j < m; ++j)
     {
-        recursed_betas_ptr -= j;
-        /* note that this devolves to empty range for the first loop iteration */
-        std::vector<FieldT> popped_betas = std::vector<FieldT>(recursed_betas.begin()+recursed_betas_ptr,
-                                                               recursed_betas.begin()+recursed_betas_ptr+j);
-        const FieldT popped_shift = recursed_shifts[m-1-j];
-        std::vector<FieldT> sums = all_subset_sums<FieldT>(popped_betas, popped_shift);
+        /* the butterflies of recursion level m-1-j */
+        const std::vector<FieldT> &sums = plan.twiddles(m-1-j);
 
         size_t stride = 1ull<<j;
+#ifdef MULTICORE
+        #pragma omp parallel for collapse(2) if (total >= parallel_min_size)
+#endif
         for (size_t ofs = 0; ofs < n; ofs += 2*stride)
         {
             for (size_t i = 0; i < stride; ++i)
             {
-                S[ofs+i] += S[ofs+stride+i] * sums[i];
-                S[ofs+stride+i] += S[ofs+i];
+                FieldT *lo = &S[(ofs+i) * width];
+                FieldT *hi = &S[(ofs+stride+i) * width];
+                fma_by_constant<FieldT>(lo, hi, width, sums[i]);
+                for (size_t v = 0; v < width; ++v)
+                {
+                    hi[v] += lo[v];
+                }
             }
         }
     }
-    assert(recursed_betas_ptr == 0);
-
-    return S;
 }
 
 template<typename FieldT>
-std::vector<FieldT> additive_IFFT(const std::vector<FieldT> &evals,
-                                  const affine_subspace<FieldT> &domain)
+void additive_IFFT_interleaved(std::vector<FieldT> &S,
+                               const size_t width,
+                               const additive_fft_plan<FieldT> &plan)
 {
-    const size_t n = evals.size();
-    const size_t m = domain.dimension();
-    assert(n == (1ull<<m));
-
-    std::vector<FieldT> S(evals);
-    std::vector<FieldT> recursed_twists(m, FieldT(0));
+    assert(plan.type() == gao_mateer_additive_fft);
+    const size_t m = plan.dimension();
+    const size_t n = 1ull<<m;
+    assert(S.size() == n * width);
+    const size_t total = S.size();
 
-    std::vector<FieldT> betas2(domain.basis());
-    FieldT shift2 = domain.shift();
     for (size_t j = 0; j < m; ++j)
     {
-        const FieldT beta = betas2[m-1-j];
-        const FieldT betainv = beta.inverse();
-        recursed_twists[j] = betainv;
-
-        std::vector<FieldT> newbetas(m-1-j, FieldT(0));
-
-        for (size_t i = 0; i < m-1-j; ++i)
-        {
-            FieldT newbeta = betas2[i] * betainv;
-            newbetas[i] = newbeta;
-            betas2[i] = newbeta.squared() - newbeta;
-        }
-
-        FieldT newshift = shift2 * betainv;
-        shift2 = newshift.squared() - newshift;
-
-        const std::vector<FieldT> sums = all_subset_sums<FieldT>(newbetas, newshift);
+        const std::vector<FieldT> &sums = plan.twiddles(j);
 
         const size_t half = 1ull<<(m-1-j);
+#ifdef MULTICORE
+        #pragma omp parallel for collapse(2) if (total >= parallel_min_size)
+#endif
         for (size_t ofs = 0; ofs < n; ofs += 2*half)
         {
             for (size_t p = 0; p < half; ++p)
             {
-                S[ofs + half + p] += S[ofs + p];
-                S[ofs + p] += S[ofs + half + p] * sums[p];
+                FieldT *lo = &S[(ofs+p) * width];
+                FieldT *hi = &S[(ofs+half+p) * width];
+                for (size_t v = 0; v < width; ++v)
+                {
+                    hi[v] += lo[v];
+                }
+                fma_by_constant<FieldT>(lo, hi, width, sums[p]);
             }
         }
     }
 
-    bitreverse_vector<FieldT>(S);
+    bitreverse_interleaved<FieldT>(S, width, m);
 
     for (size_t j = 0; j < m; ++j)
     {
@@ -178,104 +270,508 @@ std::vector<FieldT> additive_IFFT(const std::vector<FieldT> &evals,
         /* perform radix combinations */
         while (N <= n)
         {
-            const size_t quarter = N/4;
-            for (size_t ofs = 0; ofs < n; ofs += N)
+            const size_t wide_quarter = (N/4) * width;
+#ifdef MULTICORE
+            #pragma omp parallel for collapse(2) if (total >= parallel_min_size)
+#endif
+            for (size_t ofs = 0; ofs < total; ofs += 4*wide_quarter)
             {
-                for (size_t i = 0; i < quarter; ++i)
+                for (size_t i = 0; i < wide_quarter; ++i)
                 {
-                    S[ofs+1*quarter+i] += S[ofs+2*quarter+i];
-                    S[ofs+2*quarter+i] += S[ofs+3*quarter+i];
+                    S[ofs+1*wide_quarter+i] += S[ofs+2*wide_quarter+i];
+                    S[ofs+2*wide_quarter+i] += S[ofs+3*wide_quarter+i];
                 }
             }
             N *= 2;
         }
 
         /* twist by \beta^{-1} */
-        const FieldT betainv = recursed_twists[m-1-j];
-        FieldT betainvi(1);
-        for (size_t ofs = 0; ofs < n; ofs += (1ull<<(m-1-j)))
+        const FieldT &betainv = plan.inverse_twist(m-1-j);
+        const size_t block_size = (1ull<<(m-1-j)) * width;
+        const size_t num_twist_blocks = total / block_size;
+        const size_t num_chunks = num_parallel_chunks(num_twist_blocks);
+#ifdef MULTICORE
+        #pragma omp parallel for if (total >= parallel_min_size)
+#endif
+        for (size_t c = 0; c < num_chunks; ++c)
         {
-            for (size_t p = 0; p < (1ull<<(m-1-j)); ++p)
+            const size_t first_block = chunk_begin(c, num_chunks, num_twist_blocks);
+            const size_t last_block = chunk_begin(c+1, num_chunks, num_twist_blocks);
+            FieldT betainvi = libff::power(betainv, first_block);
+            for (size_t ofs = first_block * block_size; ofs < last_block * block_size; ofs += block_size)
             {
-                S[ofs + p] *= betainvi;
+                mul_by_constant<FieldT>(&S[ofs], block_size, betainvi);
+                betainvi *= betainv;
             }
-            betainvi *= betainv;
         }
     }
+}
 
+/** Returns the plan cached by the domain if it is of the given type.
+ *  Otherwise (e.g. a Gao-Mateer transform over a Cantor basis) a plan is built for this call only. */
+template<typename FieldT>
+std::shared_ptr<additive_fft_plan<FieldT>> additive_fft_plan_of_type(const affine_subspace<FieldT> &domain,
+                                                                     const additive_fft_type type)
+{
+    std::shared_ptr<additive_fft_plan<FieldT>> plan = domain.fft_plan();
+    if (plan->type() != type)
+    {
+        plan = std::make_shared<additive_fft_plan<FieldT>>(domain, type);
+    }
+    return plan;
+}
+
+template<typename FieldT>
+void additive_FFT_in_place(std::vector<FieldT> &S,
+                           const affine_subspace<FieldT> &domain)
+{
+    assert(S.size() <= domain.num_elements());
+    const size_t log_num_coeffs = libff::log2(S.size());
+    S.resize(domain.num_elements(), FieldT::zero());
+    additive_FFT_interleaved<FieldT>(S, 1, *additive_fft_plan_of_type(domain, gao_mateer_additive_fft),
+                                     log_num_coeffs);
+}
+
+template<typename FieldT>
+void additive_IFFT_in_place(std::vector<FieldT> &S,
+                            const affine_subspace<FieldT> &domain)
+{
+    assert(S.size() == domain.num_elements());
+    additive_IFFT_interleaved<FieldT>(S, 1, *additive_fft_plan_of_type(domain, gao_mateer_additive_fft));
+}
+
+template<typename FieldT>
+std::vector<FieldT> additive_FFT(const std::vector<FieldT> &poly_coeffs,
+                                 const affine_subspace<FieldT> &domain)
+{
+    std::vector<FieldT> S;
+    S.reserve(domain.num_elements());
+    S.insert(S.end(), poly_coeffs.begin(), poly_coeffs.end());
+    additive_FFT_in_place<FieldT>(S, domain);
     return S;
 }
 
 template<typename FieldT>
-std::vector<FieldT> additive_FFT_wrapper(const std::vector<FieldT> &v,
-                                         const affine_subspace<FieldT> &H)
+std::vector<FieldT> additive_IFFT(const std::vector<FieldT> &evals,
+                                  const affine_subspace<FieldT> &domain)
 {
-    libff::enter_block("Call to additive_FFT_wrapper");
-    libff::print_indent(); printf("* Vector size: %zu\n", v.size());
-    libff::print_indent(); printf("* Subspace size: %zu\n", H.num_elements());
-    std::vector<FieldT> result; 
-
-    int h_dim = 0;
-    if (H.shift() != FieldT::zero()){
-        std::vector<uint64_t> h_shift_words = H.shift().to_words();
-        for ( int i = 0; i < 32; ++i ){
-            if(    (FieldT::extension_degree() == 128 && h_shift_words[0] == cantor_in_gf2to128[i][0] && h_shift_words[1] == cantor_in_gf2to128[i][1])
-                || (FieldT::extension_degree() == 192 && h_shift_words[0] == cantor_in_gf2to192[i][0] && h_shift_words[1] == cantor_in_gf2to192[i][1] && h_shift_words[2] == cantor_in_gf2to192[i][2])
-                || (FieldT::extension_degree() == 256 && h_shift_words[0] == cantor_in_gf2to256[i][0] && h_shift_words[1] == cantor_in_gf2to256[i][1] && h_shift_words[2] == cantor_in_gf2to256[i][2] && h_shift_words[3] == cantor_in_gf2to256[i][3])
-                ) 
+    std::vector<FieldT> S(evals);
+    additive_IFFT_in_place<FieldT>(S, domain);
+    return S;
+}
+
+template<typename FieldT>
+std::vector<std::vector<FieldT>> additive_batch_FFT(const std::vector<std::vector<FieldT>> &polys_coeffs,
+                                                    const affine_subspace<FieldT> &domain)
+{
+    if (polys_coeffs.empty())
+    {
+        return {};
+    }
+
+    std::vector<FieldT> S = interleave_vectors<FieldT>(polys_coeffs, domain.num_elements());
+    additive_FFT_interleaved<FieldT>(S, polys_coeffs.size(), *additive_fft_plan_of_type(domain, gao_mateer_additive_fft),
+                                     libff::log2(max_vector_size(polys_coeffs)));
+    return deinterleave_vectors<FieldT>(S, polys_coeffs.size());
+}
+
+template<typename FieldT>
+std::vector<std::vector<FieldT>> additive_batch_IFFT(const std::vector<std::vector<FieldT>> &evals,
+                                                     const affine_subspace<FieldT> &domain)
+{
+    if (evals.empty())
+    {
+        return {};
+    }
+
+    std::vector<FieldT> S = interleave_vectors<FieldT>(evals, domain.num_elements());
+    additive_IFFT_interleaved<FieldT>(S, evals.size(), *additive_fft_plan_of_type(domain, gao_mateer_additive_fft));
+    return deinterleave_vectors<FieldT>(S, evals.size());
+}
+
+/** The k-th subspace vanishing polynomial of a Cantor basis is s_k(x) = sum_{j \subseteq k} x^{2^j},
+ *  where j ranges over the bitwise subsets of k. Reducing by it therefore only takes additions.
+ *  This divides every block of 2^{k+1} coefficients of S by s_k, in place:
+ *  the lower half of the block ends up holding the remainder, and the upper half the quotient.
+ *
+ *  The leading term x^{2^k} of coefficient i is folded into coefficients i - 2^k + 2^j, for every
+ *  other term x^{2^j} of s_k. Since 2^j <= 2^{k-1}, the upper quarter of a block only feeds the
+ *  lower three quarters, and the second quarter only feeds the lower half.
+ *  So each quarter can be processed in parallel, once the quarter above it is done.
+ *  S holds width interleaved vectors. */
+template<typename FieldT>
+void cantor_divide_by_vanishing_polynomial(std::vector<FieldT> &S, const size_t k, const size_t width = 1)
+{
+    if (k == 0)
+    {
+        /* s_0(x) = x, so the block is already (remainder, quotient) */
+        return;
+    }
+
+    const size_t total = S.size();
+    const size_t half = (1ull<<k) * width;
+    const size_t quarter = half/2;
+    for (size_t q = 2; q-- > 0; )
+    {
+        for (size_t j = 0; j < k; ++j)
+        {
+            if ((j & k) != j)
+            {
+                continue;
+            }
+
+            const size_t src = half + q * quarter;
+            const size_t dst = src - half + (1ull<<j) * width;
+#ifdef MULTICORE
+            #pragma omp parallel for collapse(2) if (total >= parallel_min_size)
+#endif
+            for (size_t ofs = 0; ofs < total; ofs += 2*half)
             {
-                h_dim = i;
-                break;
+                for (size_t i = 0; i < quarter; ++i)
+                {
+                    S[ofs + dst + i] += S[ofs + src + i];
+                }
             }
         }
-        // std::cout << "Using Cantor basis with shift: " << H.shift() << std::endl;
-        // std::cout << "Domain dimension (h.dimension()): " << H.dimension() << std::endl;
-        // std::cout << "h_dim: " << h_dim << std::endl;
     }
+}
 
-    if(H.is_cantor_basis()){
-        libff::print_indent(); printf("* Using the Cantor FFT\n");
-        result = cantor::additive_FFT(v, H.dimension(), H.shift() == FieldT::zero() ? 0 : h_dim);
+/** Inverse of cantor_divide_by_vanishing_polynomial: every block of 2^{k+1} elements of S
+ *  holding (remainder, quotient) is replaced by the coefficients of quotient * s_k + remainder. */
+template<typename FieldT>
+void cantor_multiply_by_vanishing_polynomial(std::vector<FieldT> &S, const size_t k, const size_t width = 1)
+{
+    if (k == 0)
+    {
+        return;
+    }
+
+    const size_t total = S.size();
+    const size_t half = (1ull<<k) * width;
+    const size_t quarter = half/2;
+    for (size_t q = 0; q < 2; ++q)
+    {
+        for (size_t j = 0; j < k; ++j)
+        {
+            if ((j & k) != j)
+            {
+                continue;
+            }
+
+            const size_t src = half + q * quarter;
+            const size_t dst = src - half + (1ull<<j) * width;
+#ifdef MULTICORE
+            #pragma omp parallel for collapse(2) if (total >= parallel_min_size)
+#endif
+            for (size_t ofs = 0; ofs < total; ofs += 2*half)
+            {
+                for (size_t i = 0; i < quarter; ++i)
+                {
+                    S[ofs + dst + i] += S[ofs + src + i];
+                }
+            }
+        }
+    }
+}
+
+/** Cantor butterflies are split into runs of at most this many elements, which stay in cache between
+ *  the multiply-add and the addition, and give the MULTICORE build work to share out in late rounds. */
+const size_t cantor_butterfly_run_size = 1ull << 10;
+
+/** Cantor's additive FFT. Round k (from m-1 down to 0) splits every block of 2^{k+1} coefficients,
+ *  representing a polynomial f to be evaluated over a coset x + span(basis[0], ..., basis[k]),
+ *  into f mod (s_k - s_k(x)) and f mod (s_k - s_k(x) - 1), which are the polynomials to be
+ *  evaluated over the cosets x + span(basis[0], ..., basis[k-1]) and that plus basis[k].
+ *  With f = q * s_k + r, these are r + s_k(x) * q and r + s_k(x) * q + q,
+ *  so each round costs one multiplication per pair of elements.
+ *  The s_k(x) of round k are plan.twiddles(k). Using s_k(basis[k+1+t]) = basis[1+t], these are
+ *  all subset sums of basis[1], ..., basis[m-1-k], shifted by s_k(domain.shift()).
+ *
+ *  Only the first 2^log_num_coeffs points of S may be non-zero. In rounds k >= log_num_coeffs,
+ *  f has degree < 2^k, so q = 0 and both halves of every block end up equal to f.
+ *  These rounds are replaced by copying f into every block of 2^log_num_coeffs points. */
+template<typename FieldT>
+void cantor_additive_FFT_interleaved(std::vector<FieldT> &S,
+                                     const size_t width,
+                                     const additive_fft_plan<FieldT> &plan,
+                                     const size_t log_num_coeffs)
+{
+    assert(plan.type() == cantor_additive_fft);
+    const size_t m = plan.dimension();
+    assert(S.size() == (1ull<<m) * width);
+    assert(log_num_coeffs <= m);
+    const size_t total = S.size();
+
+    const size_t coeffs_total = (1ull<<log_num_coeffs) * width;
+#ifdef MULTICORE
+    #pragma omp parallel for if (total >= parallel_min_size)
+#endif
+    for (size_t ofs = coeffs_total; ofs < total; ofs += coeffs_total)
+    {
+        std::copy_n(S.begin(), coeffs_total, S.begin() + ofs);
+    }
+
+    for (size_t k = log_num_coeffs; k-- > 0; )
+    {
+        cantor_divide_by_vanishing_polynomial<FieldT>(S, k, width);
+
+        const std::vector<FieldT> &twiddles = plan.twiddles(k);
+        const size_t half = (1ull<<k) * width;
+        /* each block applies one twiddle to a run of half elements, in runs of at most run_size */
+        const size_t run_size = std::min(half, cantor_butterfly_run_size);
+#ifdef MULTICORE
+        #pragma omp parallel for collapse(2) if (total >= parallel_min_size)
+#endif
+        for (size_t b = 0; b < twiddles.size(); ++b)
+        {
+            for (size_t r = 0; r < half; r += run_size)
+            {
+                FieldT *lo = &S[b * 2 * half + r];
+                FieldT *hi = lo + half;
+                fma_by_constant<FieldT>(lo, hi, run_size, twiddles[b]);
+                for (size_t i = 0; i < run_size; ++i)
+                {
+                    hi[i] += lo[i];
+                }
+            }
+        }
+    }
+}
+
+template<typename FieldT>
+void cantor_additive_IFFT_interleaved(std::vector<FieldT> &S,
+                                      const size_t width,
+                                      const additive_fft_plan<FieldT> &plan)
+{
+    assert(plan.type() == cantor_additive_fft);
+    const size_t m = plan.dimension();
+    assert(S.size() == (1ull<<m) * width);
+    const size_t total = S.size();
+
+    for (size_t k = 0; k < m; ++k)
+    {
+        const std::vector<FieldT> &twiddles = plan.twiddles(k);
+        const size_t half = (1ull<<k) * width;
+        const size_t run_size = std::min(half, cantor_butterfly_run_size);
+#ifdef MULTICORE
+        #pragma omp parallel for collapse(2) if (total >= parallel_min_size)
+#endif
+        for (size_t b = 0; b < twiddles.size(); ++b)
+        {
+            for (size_t r = 0; r < half; r += run_size)
+            {
+                FieldT *lo = &S[b * 2 * half + r];
+                FieldT *hi = lo + half;
+                for (size_t i = 0; i < run_size; ++i)
+                {
+                    hi[i] += lo[i];
+                }
+                fma_by_constant<FieldT>(lo, hi, run_size, twiddles[b]);
+            }
+        }
+
+        cantor_multiply_by_vanishing_polynomial<FieldT>(S, k, width);
+    }
+}
+
+template<typename FieldT>
+void cantor_additive_FFT_in_place(std::vector<FieldT> &S,
+                                  const affine_subspace<FieldT> &domain)
+{
+    assert(S.size() <= domain.num_elements());
+    const size_t log_num_coeffs = libff::log2(S.size());
+    S.resize(domain.num_elements(), FieldT::zero());
+    cantor_additive_FFT_interleaved<FieldT>(S, 1, *additive_fft_plan_of_type(domain, cantor_additive_fft),
+                                            log_num_coeffs);
+}
+
+template<typename FieldT>
+void cantor_additive_IFFT_in_place(std::vector<FieldT> &S,
+                                   const affine_subspace<FieldT> &domain)
+{
+    assert(S.size() == domain.num_elements());
+    cantor_additive_IFFT_interleaved<FieldT>(S, 1, *additive_fft_plan_of_type(domain, cantor_additive_fft));
+}
+
+template<typename FieldT>
+std::vector<FieldT> cantor_additive_FFT(const std::vector<FieldT> &poly_coeffs,
+                                        const affine_subspace<FieldT> &domain)
+{
+    std::vector<FieldT> S;
+    S.reserve(domain.num_elements());
+    S.insert(S.end(), poly_coeffs.begin(), poly_coeffs.end());
+    cantor_additive_FFT_in_place<FieldT>(S, domain);
+    return S;
+}
+
+template<typename FieldT>
+std::vector<FieldT> cantor_additive_IFFT(const std::vector<FieldT> &evals,
+                                         const affine_subspace<FieldT> &domain)
+{
+    std::vector<FieldT> S(evals);
+    cantor_additive_IFFT_in_place<FieldT>(S, domain);
+    return S;
+}
+
+template<typename FieldT>
+std::vector<std::vector<FieldT>> cantor_additive_batch_FFT(const std::vector<std::vector<FieldT>> &polys_coeffs,
+                                                           const affine_subspace<FieldT> &domain)
+{
+    if (polys_coeffs.empty())
+    {
+        return {};
+    }
+
+    std::vector<FieldT> S = interleave_vectors<FieldT>(polys_coeffs, domain.num_elements());
+    cantor_additive_FFT_interleaved<FieldT>(S, polys_coeffs.size(), *additive_fft_plan_of_type(domain, cantor_additive_fft),
+                                            libff::log2(max_vector_size(polys_coeffs)));
+    return deinterleave_vectors<FieldT>(S, polys_coeffs.size());
+}
+
+template<typename FieldT>
+std::vector<std::vector<FieldT>> cantor_additive_batch_IFFT(const std::vector<std::vector<FieldT>> &evals,
+                                                            const affine_subspace<FieldT> &domain)
+{
+    if (evals.empty())
+    {
+        return {};
+    }
+
+    std::vector<FieldT> S = interleave_vectors<FieldT>(evals, domain.num_elements());
+    cantor_additive_IFFT_interleaved<FieldT>(S, evals.size(), *additive_fft_plan_of_type(domain, cantor_additive_fft));
+    return deinterleave_vectors<FieldT>(S, evals.size());
+}
+
+template<typename FieldT>
+void additive_FFT_in_place_wrapper(std::vector<FieldT> &v,
+                                   const affine_subspace<FieldT> &H)
+{
+    libff::enter_block("Call to additive_FFT_wrapper");
+    libff::print_indent(); printf("* Vector size: %zu\n", v.size());
+    libff::print_indent(); printf("* Subspace size: %zu\n", H.num_elements());
+
+    assert(v.size() <= H.num_elements());
+    const size_t log_num_coeffs = libff::log2(v.size());
+    const std::shared_ptr<additive_fft_plan<FieldT>> plan = H.fft_plan();
+    if (plan->type() == cantor_additive_fft)
+    {
+#ifndef MULTICORE
+        if (log_num_coeffs == H.dimension() && plan->has_cantor_shift_index())
+        {
+            /* The external kernel returns its result in a vector of its own, which replaces v,
+               so this path allocates one result buffer */
+            libff::print_indent(); printf("* Using the Cantor FFT\n");
+            v = cantor::additive_FFT(v, H.dimension(), plan->cantor_shift_index());
+        }
+        else
+#endif
+        {
+            /* The in-tree kernel skips the rounds that only see zero padding, and supports any shift */
+            libff::print_indent(); printf("* Using the degree-aware Cantor FFT\n");
+            v.resize(H.num_elements(), FieldT::zero());
+            cantor_additive_FFT_interleaved<FieldT>(v, 1, *plan, log_num_coeffs);
+        }
     }
     else
-        result = additive_FFT(v, H);
+    {
+        v.resize(H.num_elements(), FieldT::zero());
+        additive_FFT_interleaved<FieldT>(v, 1, *plan, log_num_coeffs);
+    }
     libff::leave_block("Call to additive_FFT_wrapper");
-    return result;
 }
 
 template<typename FieldT>
-std::vector<FieldT> additive_IFFT_wrapper(const std::vector<FieldT> &v,
-                                          const affine_subspace<FieldT> &H)
+void additive_IFFT_in_place_wrapper(std::vector<FieldT> &v,
+                                    const affine_subspace<FieldT> &H)
 {
     libff::enter_block("Call to additive_IFFT_wrapper");
     libff::print_indent(); printf("* Vector size: %zu\n", v.size());
     libff::print_indent(); printf("* Subspace size: %zu\n", H.num_elements());
+    assert(v.size() == H.num_elements());
 
-    int h_dim = 0;
-    if (H.shift() != FieldT::zero()){
-        std::vector<uint64_t> h_shift_words = H.shift().to_words();
-        for ( int i = 0; i < 32; ++i ){
-            if(    (FieldT::extension_degree() == 128 && h_shift_words[0] == cantor_in_gf2to128[i][0] && h_shift_words[1] == cantor_in_gf2to128[i][1])
-                || (FieldT::extension_degree() == 192 && h_shift_words[0] == cantor_in_gf2to192[i][0] && h_shift_words[1] == cantor_in_gf2to192[i][1] && h_shift_words[2] == cantor_in_gf2to192[i][2])
-                || (FieldT::extension_degree() == 256 && h_shift_words[0] == cantor_in_gf2to256[i][0] && h_shift_words[1] == cantor_in_gf2to256[i][1] && h_shift_words[2] == cantor_in_gf2to256[i][2] && h_shift_words[3] == cantor_in_gf2to256[i][3])
-                ) 
-            {
-                h_dim = i;
-                break;
-            }
+    const std::shared_ptr<additive_fft_plan<FieldT>> plan = H.fft_plan();
+    if (plan->type() == cantor_additive_fft)
+    {
+#ifndef MULTICORE
+        if (plan->has_cantor_shift_index())
+        {
+            /* Allocates one result buffer, as for the FFT */
+            libff::print_indent(); printf("* Using the Cantor IFFT\n");
+            v = cantor::additive_IFFT(v, H.dimension(), plan->cantor_shift_index());
         }
-        // std::cout << "Using Cantor basis with shift: " << H.shift() << std::endl;
-        // std::cout << "Domain dimension (h.dimension()): " << H.dimension() << std::endl;
-        // std::cout << "h_dim: " << h_dim << std::endl;
+        else
+#endif
+        {
+            libff::print_indent(); printf("* Using the in-tree Cantor IFFT\n");
+            cantor_additive_IFFT_interleaved<FieldT>(v, 1, *plan);
+        }
+    }
+    else
+    {
+        additive_IFFT_interleaved<FieldT>(v, 1, *plan);
     }
-    std::vector<FieldT> result; 
-    if(H.is_cantor_basis()){
+    libff::leave_block("Call to additive_IFFT_wrapper");
+}
+
+template<typename FieldT>
+std::vector<FieldT> additive_FFT_wrapper(const std::vector<FieldT> &v,
+                                         const affine_subspace<FieldT> &H)
+{
+    std::vector<FieldT> result;
+    result.reserve(H.num_elements());
+    result.insert(result.end(), v.begin(), v.end());
+    additive_FFT_in_place_wrapper<FieldT>(result, H);
+    return result;
+}
+
+template<typename FieldT>
+std::vector<FieldT> additive_IFFT_wrapper(const std::vector<FieldT> &v,
+                                          const affine_subspace<FieldT> &H)
+{
+    std::vector<FieldT> result(v);
+    additive_IFFT_in_place_wrapper<FieldT>(result, H);
+    return result;
+}
+
+template<typename FieldT>
+std::vector<std::vector<FieldT>> additive_batch_FFT_wrapper(const std::vector<std::vector<FieldT>> &v,
+                                                            const affine_subspace<FieldT> &H)
+{
+    libff::enter_block("Call to additive_batch_FFT_wrapper");
+    libff::print_indent(); printf("* Number of vectors: %zu\n", v.size());
+    libff::print_indent(); printf("* Subspace size: %zu\n", H.num_elements());
+    std::vector<std::vector<FieldT>> result;
+    if (H.fft_plan()->type() == cantor_additive_fft)
+    {
+        libff::print_indent(); printf("* Using the Cantor FFT\n");
+        result = cantor_additive_batch_FFT(v, H);
+    }
+    else
+    {
+        result = additive_batch_FFT(v, H);
+    }
+    libff::leave_block("Call to additive_batch_FFT_wrapper");
+    return result;
+}
+
+template<typename FieldT>
+std::vector<std::vector<FieldT>> additive_batch_IFFT_wrapper(const std::vector<std::vector<FieldT>> &v,
+                                                             const affine_subspace<FieldT> &H)
+{
+    libff::enter_block("Call to additive_batch_IFFT_wrapper");
+    libff::print_indent(); printf("* Number of vectors: %zu\n", v.size());
+    libff::print_indent(); printf("* Subspace size: %zu\n", H.num_elements());
+    std::vector<std::vector<FieldT>> result;
+    if (H.fft_plan()->type() == cantor_additive_fft)
+    {
         libff::print_indent(); printf("* Using the Cantor IFFT\n");
-        result = cantor::additive_IFFT(v, H.dimension(), h_dim);
+        result = cantor_additive_batch_IFFT(v, H);
     }
     else
-        result = additive_IFFT(v, H);
-    libff::leave_block("Call to additive_IFFT_wrapper");
+    {
+        result = additive_batch_IFFT(v, H);
+    }
+    libff::leave_block("Call to additive_batch_IFFT_wrapper");
     return result;
 }
 
@@ -286,23 +782,22 @@ std::vector<FieldT> additive_IFFT_wrapper(const std::vector<FieldT> &v,
  *  The libfqfft implementation uses pseudocode from [CLRS 2n Ed, pp. 864].
  */
 template<typename FieldT>
-std::vector<FieldT> multiplicative_FFT_degree_aware(const std::vector<FieldT> &poly_coeffs,
-                                                    const multiplicative_subgroup_base<FieldT> &coset,
-                                                    const FieldT &shift)
+void multiplicative_FFT_degree_aware_in_place(std::vector<FieldT> &a,
+                                              const multiplicative_subgroup_base<FieldT> &coset,
+                                              const FieldT &shift)
 {
-    assert(poly_coeffs.size() <= coset.num_elements());
+    assert(a.size() <= coset.num_elements());
     const size_t n = coset.num_elements(), logn = libff::log2(n);
 
-    std::vector<FieldT> a(poly_coeffs);
     /** If there is a coset shift x, the degree i term of the polynomial is multiplied by x^i */
     if (shift != FieldT::one())
     {
         libfqfft::_multiply_by_coset<FieldT>(a, shift);
     }
-    a.resize(n, FieldT::zero());
 
-    const size_t poly_dimension = libff::log2(poly_coeffs.size());
-    const size_t poly_size = poly_coeffs.size();
+    const size_t poly_dimension = libff::log2(a.size());
+    const size_t poly_size = a.size();
+    a.resize(n, FieldT::zero());
     /** When the polynomial is of size k*|coset|, for k < 2^i,
      *  the first i iterations of Cooley Tukey are easily predictable.
      *  This is because they will be combining g(w^2) + wh(w^2), but g or h will always refer
@@ -365,83 +860,110 @@ std::vector<FieldT> multiplicative_FFT_degree_aware(const std::vector<FieldT> &p
         asm volatile ("/* post-inner */");
         m *= 2;
     }
+}
+
+template<typename FieldT>
+std::vector<FieldT> multiplicative_FFT_degree_aware(const std::vector<FieldT> &poly_coeffs,
+                                                    const multiplicative_subgroup_base<FieldT> &coset,
+                                                    const FieldT &shift)
+{
+    std::vector<FieldT> a;
+    a.reserve(coset.num_elements());
+    a.insert(a.end(), poly_coeffs.begin(), poly_coeffs.end());
+    multiplicative_FFT_degree_aware_in_place<FieldT>(a, coset, shift);
     return a;
 }
 
 template<typename FieldT>
-std::vector<FieldT> multiplicative_FFT_internal(
-    const std::vector<typename libff::enable_if<libff::is_multiplicative<FieldT>::value, FieldT>::type> &poly_coeffs,
+void multiplicative_FFT_in_place_internal(
+    std::vector<typename libff::enable_if<libff::is_multiplicative<FieldT>::value, FieldT>::type> &a,
     const multiplicative_subgroup_base<FieldT> &domain, const FieldT shift)
 {
-    assert(poly_coeffs.size() <= domain.num_elements());
-    return multiplicative_FFT_degree_aware<FieldT>(poly_coeffs, domain, shift);
+    assert(a.size() <= domain.num_elements());
+    multiplicative_FFT_degree_aware_in_place<FieldT>(a, domain, shift);
 }
 
 template<typename FieldT>
-std::vector<FieldT> multiplicative_FFT_internal(
-    const std::vector<typename libff::enable_if<libff::is_additive<FieldT>::value, FieldT>::type> &poly_coeffs,
+void multiplicative_FFT_in_place_internal(
+    std::vector<typename libff::enable_if<libff::is_additive<FieldT>::value, FieldT>::type> &a,
     const multiplicative_subgroup_base<FieldT> &domain, const FieldT shift)
 {
     throw std::invalid_argument("attempting to perform multiplicative IFFT with non-multiplicative field type");
 }
 
+template<typename FieldT>
+void multiplicative_FFT_in_place(std::vector<FieldT> &a,
+                                 const multiplicative_coset<FieldT> &domain)
+{
+    multiplicative_FFT_in_place_internal(a, domain, domain.shift());
+}
+
 template<typename FieldT>
 std::vector<FieldT> multiplicative_FFT(const std::vector<FieldT> &poly_coeffs,
                                        const multiplicative_coset<FieldT> &domain)
 {
-    return multiplicative_FFT_internal(poly_coeffs, domain, domain.shift());
+    std::vector<FieldT> a;
+    a.reserve(domain.num_elements());
+    a.insert(a.end(), poly_coeffs.begin(), poly_coeffs.end());
+    multiplicative_FFT_in_place<FieldT>(a, domain);
+    return a;
 }
 
 template<typename FieldT>
-std::vector<FieldT> multiplicative_IFFT_internal(
-    const std::vector<typename libff::enable_if<libff::is_multiplicative<FieldT>::value, FieldT>::type> &evals,
+void multiplicative_IFFT_in_place_internal(
+    std::vector<typename libff::enable_if<libff::is_multiplicative<FieldT>::value, FieldT>::type> &a,
     const multiplicative_subgroup_base<FieldT> &domain, const FieldT shift)
 {
-    assert(domain.num_elements() == evals.size());
+    assert(domain.num_elements() == a.size());
 
     libfqfft::basic_radix2_domain<FieldT> eval_domain = domain.FFT_eval_domain();
 
-    std::vector<FieldT> vec = evals;
     // Handle separately, as icosetFFT requires more multiplications
     if (shift == FieldT::one()) {
-        eval_domain.iFFT(vec);
+        eval_domain.iFFT(a);
     } else {
-        eval_domain.icosetFFT(vec, shift);
+        eval_domain.icosetFFT(a, shift);
     }
-
-    return vec;
 }
 
 template<typename FieldT>
-std::vector<FieldT> multiplicative_IFFT_internal(
-    const std::vector<typename libff::enable_if<libff::is_additive<FieldT>::value, FieldT>::type> &evals,
+void multiplicative_IFFT_in_place_internal(
+    std::vector<typename libff::enable_if<libff::is_additive<FieldT>::value, FieldT>::type> &a,
     const multiplicative_subgroup_base<FieldT> &domain, const FieldT shift)
 {
     throw std::invalid_argument("attempting to perform multiplicative IFFT with non-multiplicative field type");
 }
 
+template<typename FieldT>
+void multiplicative_IFFT_in_place(std::vector<FieldT> &a,
+                                  const multiplicative_coset<FieldT> &domain)
+{
+    multiplicative_IFFT_in_place_internal(a, domain, domain.shift());
+}
+
 template<typename FieldT>
 std::vector<FieldT> multiplicative_IFFT(const std::vector<FieldT> &evals,
                                         const multiplicative_coset<FieldT> &domain)
 {
-    return multiplicative_IFFT_internal(evals, domain, domain.shift());
+    std::vector<FieldT> a(evals);
+    multiplicative_IFFT_in_place<FieldT>(a, domain);
+    return a;
 }
 
 template<typename FieldT>
-std::vector<FieldT> multiplicative_FFT_wrapper(const std::vector<FieldT> &v,
-                                               const multiplicative_coset<FieldT> &H)
+void multiplicative_FFT_in_place_wrapper(std::vector<FieldT> &v,
+                                         const multiplicative_coset<FieldT> &H)
 {
     libff::enter_block("Call to multiplicative_FFT_wrapper");
     libff::print_indent(); printf("* Vector size: %zu\n", v.size());
     libff::print_indent(); printf("* Subgroup size: %zu\n", H.num_elements());
-    const std::vector<FieldT> result = multiplicative_FFT(v, H);
+    multiplicative_FFT_in_place(v, H);
     libff::leave_block("Call to multiplicative_FFT_wrapper");
-    return result;
 }
 
 template<typename FieldT>
-std::vector<FieldT> multiplicative_IFFT_wrapper(const std::vector<FieldT> &v,
-                                                const multiplicative_coset<FieldT> &H)
+void multiplicative_IFFT_in_place_wrapper(std::vector<FieldT> &v,
+                                          const multiplicative_coset<FieldT> &H)
 {
     libff::enter_block("Call to multiplicative_IFFT_wrapper");
     libff::print_indent(); printf("* Vector size: %zu\n", v.size());
@@ -449,46 +971,167 @@ std::vector<FieldT> multiplicative_IFFT_wrapper(const std::vector<FieldT> &v,
     if (v.size() == 1)
     {
         libff::leave_block("Call to multiplicative_IFFT_wrapper");
-        return {v[0]};
+        return;
     }
-    const std::vector<FieldT> result = multiplicative_IFFT(v, H);
+    multiplicative_IFFT_in_place(v, H);
     libff::leave_block("Call to multiplicative_IFFT_wrapper");
+}
+
+template<typename FieldT>
+std::vector<FieldT> multiplicative_FFT_wrapper(const std::vector<FieldT> &v,
+                                               const multiplicative_coset<FieldT> &H)
+{
+    std::vector<FieldT> result;
+    result.reserve(H.num_elements());
+    result.insert(result.end(), v.begin(), v.end());
+    multiplicative_FFT_in_place_wrapper<FieldT>(result, H);
     return result;
 }
 
 template<typename FieldT>
-std::vector<FieldT> FFT_over_field_subset(const std::vector<typename libff::enable_if<libff::is_multiplicative<FieldT>::value, FieldT>::type> coeffs,
-                                          field_subset<FieldT> domain)
+std::vector<FieldT> multiplicative_IFFT_wrapper(const std::vector<FieldT> &v,
+                                                const multiplicative_coset<FieldT> &H)
+{
+    std::vector<FieldT> result(v);
+    multiplicative_IFFT_in_place_wrapper<FieldT>(result, H);
+    return result;
+}
+
+template<typename FieldT>
+void FFT_over_field_subset_in_place(std::vector<typename libff::enable_if<libff::is_multiplicative<FieldT>::value, FieldT>::type> &v,
+                                    const field_subset<FieldT> &domain)
+{
+    multiplicative_FFT_in_place_wrapper<FieldT>(v, domain.coset());
+}
+
+template<typename FieldT>
+void FFT_over_field_subset_in_place(std::vector<typename libff::enable_if<libff::is_additive<FieldT>::value, FieldT>::type> &v,
+                                    const field_subset<FieldT> &domain)
+{
+    additive_FFT_in_place_wrapper<FieldT>(v, domain.subspace());
+}
+
+template<typename FieldT>
+void IFFT_over_field_subset_in_place(std::vector<typename libff::enable_if<libff::is_multiplicative<FieldT>::value, FieldT>::type> &v,
+                                     const field_subset<FieldT> &domain)
+{
+    multiplicative_IFFT_in_place_wrapper<FieldT>(v, domain.coset());
+}
+
+template<typename FieldT>
+void IFFT_over_field_subset_in_place(std::vector<typename libff::enable_if<libff::is_additive<FieldT>::value, FieldT>::type> &v,
+                                     const field_subset<FieldT> &domain)
+{
+    additive_IFFT_in_place_wrapper<FieldT>(v, domain.subspace());
+}
+
+template<typename FieldT>
+std::vector<FieldT> FFT_over_field_subset(const std::vector<typename libff::enable_if<libff::is_multiplicative<FieldT>::value, FieldT>::type> &coeffs,
+                                          const field_subset<FieldT> &domain)
 {
     return multiplicative_FFT_wrapper<FieldT>(coeffs, domain.coset());
 }
 
 template<typename FieldT>
-std::vector<FieldT> FFT_over_field_subset(const std::vector<typename libff::enable_if<libff::is_additive<FieldT>::value, FieldT>::type> coeffs,
-                                          field_subset<FieldT> domain)
+std::vector<FieldT> FFT_over_field_subset(const std::vector<typename libff::enable_if<libff::is_additive<FieldT>::value, FieldT>::type> &coeffs,
+                                          const field_subset<FieldT> &domain)
 {
     return additive_FFT_wrapper<FieldT>(coeffs, domain.subspace());
 }
 
 template<typename FieldT>
-std::vector<FieldT> IFFT_over_field_subset(const std::vector<typename libff::enable_if<libff::is_multiplicative<FieldT>::value, FieldT>::type> evals,
-                                           field_subset<FieldT> domain)
+std::vector<FieldT> IFFT_over_field_subset(const std::vector<typename libff::enable_if<libff::is_multiplicative<FieldT>::value, FieldT>::type> &evals,
+                                           const field_subset<FieldT> &domain)
 {
     return multiplicative_IFFT_wrapper<FieldT>(evals, domain.coset());
 }
 
 template<typename FieldT>
-std::vector<FieldT> IFFT_over_field_subset(const std::vector<typename libff::enable_if<libff::is_additive<FieldT>::value, FieldT>::type> evals,
-                                           field_subset<FieldT> domain)
+std::vector<FieldT> IFFT_over_field_subset(const std::vector<typename libff::enable_if<libff::is_additive<FieldT>::value, FieldT>::type> &evals,
+                                           const field_subset<FieldT> &domain)
 {
     return additive_IFFT_wrapper<FieldT>(evals, domain.subspace());
 }
 
+template<typename FieldT>
+std::vector<std::vector<FieldT>> batch_FFT_over_field_subset(
+    const std::vector<std::vector<typename libff::enable_if<libff::is_multiplicative<FieldT>::value, FieldT>::type>> &coeffs,
+    const field_subset<FieldT> &domain)
+{
+    libff::enter_block("Call to multiplicative batch FFT");
+    libff::print_indent(); printf("* Number of vectors: %zu\n", coeffs.size());
+    libff::print_indent(); printf("* Coset size: %zu\n", domain.num_elements());
+    /* All calls share the FFT cache of the coset */
+    const multiplicative_coset<FieldT> coset = domain.coset();
+    std::vector<std::vector<FieldT>> result;
+    result.reserve(coeffs.size());
+    for (const std::vector<FieldT> &c : coeffs)
+    {
+        result.emplace_back(multiplicative_FFT<FieldT>(c, coset));
+    }
+    libff::leave_block("Call to multiplicative batch FFT");
+    return result;
+}
+
+template<typename FieldT>
+std::vector<std::vector<FieldT>> batch_FFT_over_field_subset(
+    const std::vector<std::vector<typename libff::enable_if<libff::is_additive<FieldT>::value, FieldT>::type>> &coeffs,
+    const field_subset<FieldT> &domain)
+{
+    return additive_batch_FFT_wrapper<FieldT>(coeffs, domain.subspace());
+}
+
+template<typename FieldT>
+std::vector<std::vector<FieldT>> batch_IFFT_over_field_subset(
+    const std::vector<std::vector<typename libff::enable_if<libff::is_multiplicative<FieldT>::value, FieldT>::type>> &evals,
+    const field_subset<FieldT> &domain)
+{
+    libff::enter_block("Call to multiplicative batch IFFT");
+    libff::print_indent(); printf("* Number of vectors: %zu\n", evals.size());
+    libff::print_indent(); printf("* Coset size: %zu\n", domain.num_elements());
+    const multiplicative_coset<FieldT> coset = domain.coset();
+    std::vector<std::vector<FieldT>> result;
+    result.reserve(evals.size());
+    if (coset.num_elements() == 1)
+    {
+        for (const std::vector<FieldT> &e : evals)
+        {
+            result.emplace_back(std::vector<FieldT>({e[0]}));
+        }
+        libff::leave_block("Call to multiplicative batch IFFT");
+        return result;
+    }
+
+    /* The evaluation domain is constructed once for the whole batch */
+    libfqfft::basic_radix2_domain<FieldT> eval_domain = coset.FFT_eval_domain();
+    for (const std::vector<FieldT> &e : evals)
+    {
+        assert(e.size() == coset.num_elements());
+        std::vector<FieldT> vec(e);
+        if (coset.shift() == FieldT::one()) {
+            eval_domain.iFFT(vec);
+        } else {
+            eval_domain.icosetFFT(vec, coset.shift());
+        }
+        result.emplace_back(std::move(vec));
+    }
+    libff::leave_block("Call to multiplicative batch IFFT");
+    return result;
+}
+
+template<typename FieldT>
+std::vector<std::vector<FieldT>> batch_IFFT_over_field_subset(
+    const std::vector<std::vector<typename libff::enable_if<libff::is_additive<FieldT>::value, FieldT>::type>> &evals,
+    const field_subset<FieldT> &domain)
+{
+    return additive_batch_IFFT_wrapper<FieldT>(evals, domain.subspace());
+}
+
 template<typename FieldT>
 std::vector<FieldT> IFFT_of_known_degree_over_field_subset(
-    const std::vector<typename libff::enable_if<libff::is_multiplicative<FieldT>::value, FieldT>::type> evals,
+    const std::vector<typename libff::enable_if<libff::is_multiplicative<FieldT>::value, FieldT>::type> &evals,
     size_t degree,
-    field_subset<FieldT> domain)
+    const field_subset<FieldT> &domain)
 {
     /** We do an IFFT over the minimal subgroup needed for this known degree.
      *  We take the subgroup with the coset's shift as an element.
@@ -504,14 +1147,15 @@ std::vector<FieldT> IFFT_of_known_degree_over_field_subset(
     {
         evals_in_minimal_coset.emplace_back(evals[i]);
     }
-    return multiplicative_IFFT_wrapper<FieldT>(evals_in_minimal_coset, minimal_coset.coset());
+    multiplicative_IFFT_in_place_wrapper<FieldT>(evals_in_minimal_coset, minimal_coset.coset());
+    return evals_in_minimal_coset;
 }
 
 template<typename FieldT>
 std::vector<FieldT> IFFT_of_known_degree_over_field_subset(
-    const std::vector<typename libff::enable_if<libff::is_additive<FieldT>::value, FieldT>::type> evals,
+    const std::vector<typename libff::enable_if<libff::is_additive<FieldT>::value, FieldT>::type> &evals,
     size_t degree,
-    field_subset<FieldT> domain)
+    const field_subset<FieldT> &domain)
 {
     /** We do an IFFT over the minimal subspace needed for this known degree.
      *  We take the subspace spanned by the first basis vectors of domain,
@@ -523,7 +1167,8 @@ std::vector<FieldT> IFFT_of_known_degree_over_field_subset(
     std::vector<FieldT> evals_in_minimal_subspace;
     evals_in_minimal_subspace.insert(
         evals_in_minimal_subspace.end(), evals.begin(), evals.begin() + closest_power_of_two);
-    return additive_IFFT_wrapper<FieldT>(evals_in_minimal_subspace, minimal_subspace.subspace());
+    additive_IFFT_in_place_wrapper<FieldT>(evals_in_minimal_subspace, minimal_subspace.subspace());
+    return evals_in_minimal_subspace;
 }
 
 } // namespace libiop
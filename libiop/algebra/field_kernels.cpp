@@ -0,0 +1,112 @@
+#include "libiop/algebra/field_kernels.hpp"
+
+#if defined(USE_ASM) && defined(__PCLMUL__) && defined(__SSE4_1__) && defined(__x86_64__)
+#define LIBIOP_HAVE_PCLMUL_KERNELS
+#include "libiop/algebra/field_kernels_clmul.tcc"
+#endif
+
+namespace libiop {
+
+#ifdef LIBIOP_HAVE_AVX2_VPCLMULQDQ
+/* defined in field_kernels_avx2.cpp, which is compiled with AVX2 and VPCLMULQDQ enabled */
+const binary_field_kernels *avx2_vpclmul_kernels_for(const std::size_t num_words);
+#endif
+
+#ifdef LIBIOP_HAVE_AVX512_VPCLMULQDQ
+/* defined in field_kernels_avx512.cpp, which is compiled with AVX-512 and VPCLMULQDQ enabled */
+const binary_field_kernels *avx512_vpclmul_kernels_for(const std::size_t num_words);
+#endif
+
+#ifdef LIBIOP_HAVE_PCLMUL_KERNELS
+static const binary_field_kernels pclmul_kernel_table[3] = {
+    { pclmul_binary_field_kernels,
+      clmul_kernels<sse_clmul, 2>::mul_by_constant, clmul_kernels<sse_clmul, 2>::fma_by_constant },
+    { pclmul_binary_field_kernels,
+      clmul_word_kernels<3>::mul_by_constant, clmul_word_kernels<3>::fma_by_constant },
+    { pclmul_binary_field_kernels,
+      clmul_kernels<sse_clmul, 4>::mul_by_constant, clmul_kernels<sse_clmul, 4>::fma_by_constant },
+};
+#endif
+
+static bool cpu_supports(const binary_field_kernel_isa isa)
+{
+    switch (isa)
+    {
+#ifdef LIBIOP_HAVE_PCLMUL_KERNELS
+        case pclmul_binary_field_kernels:
+            return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+#endif
+#ifdef LIBIOP_HAVE_AVX2_VPCLMULQDQ
+        case avx2_vpclmul_binary_field_kernels:
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("vpclmulqdq");
+#endif
+#ifdef LIBIOP_HAVE_AVX512_VPCLMULQDQ
+        case avx512_vpclmul_binary_field_kernels:
+            return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("vpclmulqdq");
+#endif
+        default:
+            return false;
+    }
+}
+
+static const binary_field_kernels *compiled_kernels(const std::size_t num_words,
+                                                    const binary_field_kernel_isa isa)
+{
+    switch (isa)
+    {
+#ifdef LIBIOP_HAVE_PCLMUL_KERNELS
+        case pclmul_binary_field_kernels:
+            return &pclmul_kernel_table[num_words - 2];
+#endif
+#ifdef LIBIOP_HAVE_AVX2_VPCLMULQDQ
+        case avx2_vpclmul_binary_field_kernels:
+            return avx2_vpclmul_kernels_for(num_words);
+#endif
+#ifdef LIBIOP_HAVE_AVX512_VPCLMULQDQ
+        case avx512_vpclmul_binary_field_kernels:
+            return avx512_vpclmul_kernels_for(num_words);
+#endif
+        default:
+            return nullptr;
+    }
+}
+
+binary_field_kernel_isa best_binary_field_kernel_isa()
+{
+    static const binary_field_kernel_isa best = []() {
+        for (int isa = avx512_vpclmul_binary_field_kernels; isa > portable_binary_field_kernels; --isa)
+        {
+            if (cpu_supports((binary_field_kernel_isa) isa))
+            {
+                return (binary_field_kernel_isa) isa;
+            }
+        }
+        return portable_binary_field_kernels;
+    }();
+    return best;
+}
+
+const binary_field_kernels *binary_field_kernels_for(const std::size_t num_words,
+                                                     const binary_field_kernel_isa isa)
+{
+    if (num_words < 2 || num_words > 4)
+    {
+        return nullptr;
+    }
+
+    for (int i = isa; i > portable_binary_field_kernels; --i)
+    {
+        if (cpu_supports((binary_field_kernel_isa) i))
+        {
+            const binary_field_kernels *kernels = compiled_kernels(num_words, (binary_field_kernel_isa) i);
+            if (kernels != nullptr)
+            {
+                return kernels;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+} // namespace libiop
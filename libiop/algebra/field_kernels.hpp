@@ -0,0 +1,61 @@
+/**@file
+ *****************************************************************************
+ Batched field operations against a single constant, such as scaling a run of
+ coefficients or applying one FFT twiddle to a run of butterflies.
+
+ For GF(2^128), GF(2^192) and GF(2^256) these run on carry-less multiply
+ kernels, picked at runtime from what the CPU supports: VPCLMULQDQ on AVX-512
+ or AVX2, then PCLMULQDQ. Every other field, and every CPU without them, uses
+ the field's own arithmetic.
+ *****************************************************************************
+ * @author     This file is part of libiop (see AUTHORS)
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+#ifndef LIBIOP_ALGEBRA_FIELD_KERNELS_HPP_
+#define LIBIOP_ALGEBRA_FIELD_KERNELS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace libiop {
+
+/** Sets v[i] *= c, for i < n. */
+template<typename FieldT>
+void mul_by_constant(FieldT *v, const std::size_t n, const FieldT &c);
+
+/** Sets out[i] += in[i] * c, for i < n. out and in must not overlap. */
+template<typename FieldT>
+void fma_by_constant(FieldT *out, const FieldT *in, const std::size_t n, const FieldT &c);
+
+/** Runs shorter than this are not worth a call into the kernels. */
+const std::size_t field_kernels_min_size = 4;
+
+enum binary_field_kernel_isa {
+    portable_binary_field_kernels = 0,
+    pclmul_binary_field_kernels = 1,
+    avx2_vpclmul_binary_field_kernels = 2,
+    avx512_vpclmul_binary_field_kernels = 3
+};
+
+/** Kernels over GF(2^{64 num_words}), with elements stored as num_words little endian 64-bit words
+ *  and reduced by libff's modulus for that field. */
+struct binary_field_kernels {
+    binary_field_kernel_isa isa;
+    void (*mul_by_constant)(std::uint64_t *v, const std::size_t n, const std::uint64_t *c);
+    void (*fma_by_constant)(std::uint64_t *out, const std::uint64_t *in, const std::size_t n, const std::uint64_t *c);
+};
+
+/** The fastest kernel set this build and CPU support. */
+binary_field_kernel_isa best_binary_field_kernel_isa();
+
+/** Kernels for 2, 3 or 4 words using the given instruction set. Returns nullptr when the field size is
+ *  not supported, or the instruction set is not compiled in or not supported by the CPU.
+ *  Instruction sets without a kernel for this field size fall back to the next best one. */
+const binary_field_kernels *binary_field_kernels_for(const std::size_t num_words,
+                                                     const binary_field_kernel_isa isa = best_binary_field_kernel_isa());
+
+} // namespace libiop
+
+#include "libiop/algebra/field_kernels.tcc"
+
+#endif // LIBIOP_ALGEBRA_FIELD_KERNELS_HPP_
@@ -0,0 +1,114 @@
+#include <vector>
+
+#include <libff/algebra/field_utils/field_utils.hpp>
+
+namespace libiop {
+
+/** The kernels read field elements as raw words, so they are only used for a field after they agree
+ *  with its own multiplication on a few fixed elements. This also checks that the field's value is
+ *  stored as little endian 64-bit words, in the same order as to_words(). */
+template<typename FieldT>
+const binary_field_kernels *checked_binary_field_kernels(const binary_field_kernels *kernels)
+{
+    const std::size_t num_words = sizeof(FieldT) / sizeof(std::uint64_t);
+    if (kernels == nullptr ||
+        sizeof(FieldT) != num_words * sizeof(std::uint64_t) ||
+        FieldT::extension_degree() != 64 * num_words)
+    {
+        return nullptr;
+    }
+
+    /* enough elements to cover the vector bodies of every kernel, plus a tail */
+    const std::size_t n = 11;
+    std::vector<FieldT> v(n);
+    FieldT c;
+    std::uint64_t pattern = 0x9e3779b97f4a7c15ull;
+    for (std::size_t i = 0; i <= n; ++i)
+    {
+        std::vector<std::uint64_t> words(num_words);
+        for (std::size_t w = 0; w < num_words; ++w)
+        {
+            pattern = pattern * 6364136223846793005ull + 1442695040888963407ull;
+            words[w] = pattern;
+        }
+        (i < n ? v[i] : c).from_words(words);
+    }
+
+    std::vector<FieldT> products(v);
+    kernels->mul_by_constant(reinterpret_cast<std::uint64_t*>(products.data()), n,
+                             reinterpret_cast<const std::uint64_t*>(&c));
+    std::vector<FieldT> sums(v);
+    kernels->fma_by_constant(reinterpret_cast<std::uint64_t*>(sums.data()),
+                             reinterpret_cast<const std::uint64_t*>(v.data()), n,
+                             reinterpret_cast<const std::uint64_t*>(&c));
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (products[i] != v[i] * c || sums[i] != v[i] + v[i] * c)
+        {
+            return nullptr;
+        }
+    }
+
+    return kernels;
+}
+
+template<typename FieldT, bool is_binary_field = libff::is_additive<FieldT>::value>
+struct field_kernels_selector {
+    static const binary_field_kernels *kernels()
+    {
+        return nullptr;
+    }
+};
+
+template<typename FieldT>
+struct field_kernels_selector<FieldT, true> {
+    static const binary_field_kernels *kernels()
+    {
+        static const binary_field_kernels *const checked =
+            checked_binary_field_kernels<FieldT>(binary_field_kernels_for(sizeof(FieldT) / sizeof(std::uint64_t)));
+        return checked;
+    }
+};
+
+template<typename FieldT>
+void mul_by_constant(FieldT *v, const std::size_t n, const FieldT &c)
+{
+    if (n >= field_kernels_min_size)
+    {
+        const binary_field_kernels *kernels = field_kernels_selector<FieldT>::kernels();
+        if (kernels != nullptr)
+        {
+            kernels->mul_by_constant(reinterpret_cast<std::uint64_t*>(v), n,
+                                     reinterpret_cast<const std::uint64_t*>(&c));
+            return;
+        }
+    }
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        v[i] *= c;
+    }
+}
+
+template<typename FieldT>
+void fma_by_constant(FieldT *out, const FieldT *in, const std::size_t n, const FieldT &c)
+{
+    if (n >= field_kernels_min_size)
+    {
+        const binary_field_kernels *kernels = field_kernels_selector<FieldT>::kernels();
+        if (kernels != nullptr)
+        {
+            kernels->fma_by_constant(reinterpret_cast<std::uint64_t*>(out),
+                                     reinterpret_cast<const std::uint64_t*>(in), n,
+                                     reinterpret_cast<const std::uint64_t*>(&c));
+            return;
+        }
+    }
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        out[i] += in[i] * c;
+    }
+}
+
+} // namespace libiop
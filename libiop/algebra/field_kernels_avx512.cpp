@@ -0,0 +1,28 @@
+/* Compiled with AVX-512 and VPCLMULQDQ enabled (see libiop/CMakeLists.txt). Only called after
+   field_kernels.cpp has checked that the CPU supports them. */
+#include "libiop/algebra/field_kernels_clmul.tcc"
+
+namespace libiop {
+
+static const binary_field_kernels avx512_vpclmul_kernel_table[2] = {
+    { avx512_vpclmul_binary_field_kernels,
+      clmul_kernels<avx512_vpclmul, 2>::mul_by_constant, clmul_kernels<avx512_vpclmul, 2>::fma_by_constant },
+    { avx512_vpclmul_binary_field_kernels,
+      clmul_kernels<avx512_vpclmul, 4>::mul_by_constant, clmul_kernels<avx512_vpclmul, 4>::fma_by_constant },
+};
+
+/* GF(2^192) elements don't split into 128-bit lanes, so they use the PCLMULQDQ kernels */
+const binary_field_kernels *avx512_vpclmul_kernels_for(const std::size_t num_words)
+{
+    switch (num_words)
+    {
+        case 2:
+            return &avx512_vpclmul_kernel_table[0];
+        case 4:
+            return &avx512_vpclmul_kernel_table[1];
+        default:
+            return nullptr;
+    }
+}
+
+} // namespace libiop
@@ -0,0 +1,376 @@
+/**@file
+ *****************************************************************************
+ Carry-less multiply kernels for field_kernels, shared by the translation units
+ that compile them for each instruction set. Everything here has internal
+ linkage, so that code built with wider ISA flags never leaks into the others.
+ *****************************************************************************
+ * @author     This file is part of libiop (see AUTHORS)
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+#include <cstddef>
+#include <cstdint>
+
+#include <immintrin.h>
+
+#include "libiop/algebra/field_kernels.hpp"
+
+namespace libiop {
+namespace {
+
+/** libff's reduction polynomials, as x^{64 num_words} = r(x) */
+template<std::size_t num_words>
+struct binary_field_modulus;
+
+template<> struct binary_field_modulus<2> { static const std::uint64_t value = 0b10000111; };      /* x^128 + x^7 + x^2 + x + 1 */
+template<> struct binary_field_modulus<3> { static const std::uint64_t value = 0b10000111; };      /* x^192 + x^7 + x^2 + x + 1 */
+template<> struct binary_field_modulus<4> { static const std::uint64_t value = 0b10000100101; };   /* x^256 + x^10 + x^5 + x^2 + 1 */
+
+/** Multiplies an element of num_words words by c, one 64 x 64 bit carry-less multiply at a time.
+ *  Works for any number of words, and handles the field sizes and tails the vector kernels don't. */
+template<std::size_t num_words>
+inline void clmul_multiply_words(const std::uint64_t *a, const __m128i *c, const __m128i r, std::uint64_t *result)
+{
+    std::uint64_t prod[2*num_words + 1] = {0};
+    for (std::size_t i = 0; i < num_words; ++i)
+    {
+        const __m128i ai = _mm_cvtsi64_si128((long long) a[i]);
+        for (std::size_t j = 0; j < num_words; ++j)
+        {
+            const __m128i p = _mm_clmulepi64_si128(ai, c[j], 0x00);
+            prod[i+j] ^= (std::uint64_t) _mm_cvtsi128_si64(p);
+            prod[i+j+1] ^= (std::uint64_t) _mm_extract_epi64(p, 1);
+        }
+    }
+
+    /* fold the upper words down, the top one first, so that its overflow into word num_words is folded too */
+    for (std::size_t i = 2*num_words - 1; i >= num_words; --i)
+    {
+        const __m128i p = _mm_clmulepi64_si128(_mm_cvtsi64_si128((long long) prod[i]), r, 0x00);
+        prod[i - num_words] ^= (std::uint64_t) _mm_cvtsi128_si64(p);
+        prod[i - num_words + 1] ^= (std::uint64_t) _mm_extract_epi64(p, 1);
+    }
+
+    for (std::size_t i = 0; i < num_words; ++i)
+    {
+        result[i] = prod[i];
+    }
+}
+
+template<std::size_t num_words>
+struct clmul_word_kernels {
+    static void load_constant(const std::uint64_t *c, __m128i *c_words)
+    {
+        for (std::size_t j = 0; j < num_words; ++j)
+        {
+            c_words[j] = _mm_cvtsi64_si128((long long) c[j]);
+        }
+    }
+
+    static void mul_by_constant(std::uint64_t *v, const std::size_t n, const std::uint64_t *c)
+    {
+        __m128i c_words[num_words];
+        load_constant(c, c_words);
+        const __m128i r = _mm_cvtsi64_si128((long long) binary_field_modulus<num_words>::value);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            clmul_multiply_words<num_words>(v + i * num_words, c_words, r, v + i * num_words);
+        }
+    }
+
+    static void fma_by_constant(std::uint64_t *out, const std::uint64_t *in, const std::size_t n, const std::uint64_t *c)
+    {
+        __m128i c_words[num_words];
+        load_constant(c, c_words);
+        const __m128i r = _mm_cvtsi64_si128((long long) binary_field_modulus<num_words>::value);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            std::uint64_t prod[num_words];
+            clmul_multiply_words<num_words>(in + i * num_words, c_words, r, prod);
+            for (std::size_t w = 0; w < num_words; ++w)
+            {
+                out[i * num_words + w] ^= prod[w];
+            }
+        }
+    }
+};
+
+/** Kernels over registers of V::lanes 128-bit lanes, each lane working on a different element.
+ *  An element of num_words words is split into num_words/2 "digits" of 128 bits, and digit d of
+ *  every element is gathered into register d. V supplies:
+ *    reg                              the register type
+ *    lanes                            the number of 128-bit lanes, i.e. elements per register
+ *    clmul<imm>(a, b)                 carry-less multiply of one 64-bit word of each lane
+ *    add(a, b)                        xor
+ *    shift_up(a), shift_down(a)       move the low word of each lane up, resp. the high word down
+ *    broadcast(p)                     the 128 bits at p, in every lane
+ *    load<num_words>(p, digits)       gather the digits of V::lanes consecutive elements
+ *    store<num_words>(p, digits)      and scatter them back */
+template<typename V, std::size_t num_words>
+struct clmul_lane_kernels {
+    typedef typename V::reg reg;
+    static const std::size_t num_digits = num_words / 2;
+
+    struct constant {
+        reg c[num_digits];
+        reg r;
+    };
+
+    static constant load_constant(const std::uint64_t *c)
+    {
+        constant result;
+        for (std::size_t e = 0; e < num_digits; ++e)
+        {
+            result.c[e] = V::broadcast(c + 2*e);
+        }
+        const std::uint64_t r[2] = { binary_field_modulus<num_words>::value, 0 };
+        result.r = V::broadcast(r);
+        return result;
+    }
+
+    static inline void multiply(const reg *a, const constant &c, reg *result)
+    {
+        /* acc[t] holds the 128-bit sum of the word products a_i * c_j with i + j = t */
+        reg acc[2*num_words - 1];
+        for (std::size_t t = 0; t < 2*num_words - 1; ++t)
+        {
+            acc[t] = V::zero();
+        }
+        for (std::size_t d = 0; d < num_digits; ++d)
+        {
+            for (std::size_t e = 0; e < num_digits; ++e)
+            {
+                const std::size_t t = 2*(d+e);
+                acc[t] = V::add(acc[t], V::template clmul<0x00>(a[d], c.c[e]));
+                acc[t+1] = V::add(acc[t+1], V::add(V::template clmul<0x01>(a[d], c.c[e]),
+                                                   V::template clmul<0x10>(a[d], c.c[e])));
+                acc[t+2] = V::add(acc[t+2], V::template clmul<0x11>(a[d], c.c[e]));
+            }
+        }
+
+        /* the 2 num_words words of the product, as 128-bit digits */
+        reg prod[num_words];
+        for (std::size_t u = 0; u < num_words; ++u)
+        {
+            prod[u] = acc[2*u];
+            if (u > 0)
+            {
+                prod[u] = V::add(prod[u], V::shift_down(acc[2*u-1]));
+            }
+            if (2*u + 1 < 2*num_words - 1)
+            {
+                prod[u] = V::add(prod[u], V::shift_up(acc[2*u+1]));
+            }
+        }
+
+        /* fold the upper digits down with x^{64 num_words} = r(x). Only the top word overflows past
+           word num_words, by less than 64 bits, so one more multiply by r folds that too. */
+        reg overflow = V::zero();
+        for (std::size_t u = num_digits; u < num_words; ++u)
+        {
+            const std::size_t v = u - num_digits;
+            prod[v] = V::add(prod[v], V::template clmul<0x00>(prod[u], c.r));
+            const reg high = V::template clmul<0x01>(prod[u], c.r);
+            prod[v] = V::add(prod[v], V::shift_up(high));
+            if (v + 1 < num_digits)
+            {
+                prod[v+1] = V::add(prod[v+1], V::shift_down(high));
+            }
+            else
+            {
+                overflow = V::shift_down(high);
+            }
+        }
+        prod[0] = V::add(prod[0], V::template clmul<0x00>(overflow, c.r));
+
+        for (std::size_t d = 0; d < num_digits; ++d)
+        {
+            result[d] = prod[d];
+        }
+    }
+
+    /** Returns the number of elements processed; the caller finishes the remaining tail. */
+    static std::size_t mul_by_constant(std::uint64_t *v, const std::size_t n, const std::uint64_t *c)
+    {
+        const constant cst = load_constant(c);
+        std::size_t i = 0;
+        for (; i + V::lanes <= n; i += V::lanes)
+        {
+            reg a[num_digits], result[num_digits];
+            V::template load<num_words>(v + i * num_words, a);
+            multiply(a, cst, result);
+            V::template store<num_words>(v + i * num_words, result);
+        }
+        return i;
+    }
+
+    static std::size_t fma_by_constant(std::uint64_t *out, const std::uint64_t *in, const std::size_t n, const std::uint64_t *c)
+    {
+        const constant cst = load_constant(c);
+        std::size_t i = 0;
+        for (; i + V::lanes <= n; i += V::lanes)
+        {
+            reg a[num_digits], o[num_digits], result[num_digits];
+            V::template load<num_words>(in + i * num_words, a);
+            V::template load<num_words>(out + i * num_words, o);
+            multiply(a, cst, result);
+            for (std::size_t d = 0; d < num_digits; ++d)
+            {
+                result[d] = V::add(result[d], o[d]);
+            }
+            V::template store<num_words>(out + i * num_words, result);
+        }
+        return i;
+    }
+};
+
+struct sse_clmul {
+    typedef __m128i reg;
+    static const std::size_t lanes = 1;
+
+    template<int imm>
+    static inline reg clmul(const reg a, const reg b) { return _mm_clmulepi64_si128(a, b, imm); }
+    static inline reg add(const reg a, const reg b) { return _mm_xor_si128(a, b); }
+    static inline reg zero() { return _mm_setzero_si128(); }
+    static inline reg shift_up(const reg a) { return _mm_slli_si128(a, 8); }
+    static inline reg shift_down(const reg a) { return _mm_srli_si128(a, 8); }
+    static inline reg broadcast(const std::uint64_t *p) { return _mm_loadu_si128((const __m128i*) p); }
+
+    template<std::size_t num_words>
+    static inline void load(const std::uint64_t *p, reg *digits)
+    {
+        for (std::size_t d = 0; d < num_words / 2; ++d)
+        {
+            digits[d] = _mm_loadu_si128((const __m128i*) (p + 2*d));
+        }
+    }
+
+    template<std::size_t num_words>
+    static inline void store(std::uint64_t *p, const reg *digits)
+    {
+        for (std::size_t d = 0; d < num_words / 2; ++d)
+        {
+            _mm_storeu_si128((__m128i*) (p + 2*d), digits[d]);
+        }
+    }
+};
+
+#if defined(__AVX2__) && defined(__VPCLMULQDQ__)
+struct avx2_vpclmul {
+    typedef __m256i reg;
+    static const std::size_t lanes = 2;
+
+    template<int imm>
+    static inline reg clmul(const reg a, const reg b) { return _mm256_clmulepi64_epi128(a, b, imm); }
+    static inline reg add(const reg a, const reg b) { return _mm256_xor_si256(a, b); }
+    static inline reg zero() { return _mm256_setzero_si256(); }
+    static inline reg shift_up(const reg a) { return _mm256_slli_si256(a, 8); }
+    static inline reg shift_down(const reg a) { return _mm256_srli_si256(a, 8); }
+    static inline reg broadcast(const std::uint64_t *p)
+    {
+        return _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*) p));
+    }
+
+    template<std::size_t num_words>
+    static inline void load(const std::uint64_t *p, reg *digits)
+    {
+        if (num_words == 2)
+        {
+            digits[0] = _mm256_loadu_si256((const __m256i*) p);
+        }
+        else
+        {
+            /* two elements of two digits each: transpose so that each register holds one digit */
+            const reg x = _mm256_loadu_si256((const __m256i*) p);
+            const reg y = _mm256_loadu_si256((const __m256i*) (p + 4));
+            digits[0] = _mm256_permute2x128_si256(x, y, 0x20);
+            digits[1] = _mm256_permute2x128_si256(x, y, 0x31);
+        }
+    }
+
+    template<std::size_t num_words>
+    static inline void store(std::uint64_t *p, const reg *digits)
+    {
+        if (num_words == 2)
+        {
+            _mm256_storeu_si256((__m256i*) p, digits[0]);
+        }
+        else
+        {
+            _mm256_storeu_si256((__m256i*) p, _mm256_permute2x128_si256(digits[0], digits[1], 0x20));
+            _mm256_storeu_si256((__m256i*) (p + 4), _mm256_permute2x128_si256(digits[0], digits[1], 0x31));
+        }
+    }
+};
+#endif
+
+#if defined(__AVX512F__) && defined(__VPCLMULQDQ__)
+/* The broadcasts and shuffles below use the zero-masked forms with a full mask: the unmasked forms
+   start from _mm512_undefined_epi32(), which some GCC versions warn about under -Wall. */
+struct avx512_vpclmul {
+    typedef __m512i reg;
+    static const std::size_t lanes = 4;
+
+    template<int imm>
+    static inline reg clmul(const reg a, const reg b) { return _mm512_clmulepi64_epi128(a, b, imm); }
+    static inline reg add(const reg a, const reg b) { return _mm512_xor_si512(a, b); }
+    static inline reg zero() { return _mm512_setzero_si512(); }
+    /* in-lane byte shifts need AVX512BW, so move the words with AVX512F permutes instead */
+    static inline reg shift_up(const reg a) { return _mm512_maskz_permutex_epi64(0xAA, a, _MM_SHUFFLE(2, 2, 0, 0)); }
+    static inline reg shift_down(const reg a) { return _mm512_maskz_permutex_epi64(0x55, a, _MM_SHUFFLE(3, 3, 1, 1)); }
+    static inline reg broadcast(const std::uint64_t *p)
+    {
+        return _mm512_maskz_broadcast_i32x4(0xFFFF, _mm_loadu_si128((const __m128i*) p));
+    }
+
+    template<std::size_t num_words>
+    static inline void load(const std::uint64_t *p, reg *digits)
+    {
+        if (num_words == 2)
+        {
+            digits[0] = _mm512_loadu_si512((const void*) p);
+        }
+        else
+        {
+            const reg x = _mm512_loadu_si512((const void*) p);
+            const reg y = _mm512_loadu_si512((const void*) (p + 8));
+            digits[0] = _mm512_maskz_shuffle_i64x2(0xFF, x, y, _MM_SHUFFLE(2, 0, 2, 0));
+            digits[1] = _mm512_maskz_shuffle_i64x2(0xFF, x, y, _MM_SHUFFLE(3, 1, 3, 1));
+        }
+    }
+
+    template<std::size_t num_words>
+    static inline void store(std::uint64_t *p, const reg *digits)
+    {
+        if (num_words == 2)
+        {
+            _mm512_storeu_si512((void*) p, digits[0]);
+        }
+        else
+        {
+            const reg low = _mm512_maskz_shuffle_i64x2(0xFF, digits[0], digits[1], _MM_SHUFFLE(1, 0, 1, 0));
+            const reg high = _mm512_maskz_shuffle_i64x2(0xFF, digits[0], digits[1], _MM_SHUFFLE(3, 2, 3, 2));
+            _mm512_storeu_si512((void*) p, _mm512_maskz_shuffle_i64x2(0xFF, low, low, _MM_SHUFFLE(3, 1, 2, 0)));
+            _mm512_storeu_si512((void*) (p + 8), _mm512_maskz_shuffle_i64x2(0xFF, high, high, _MM_SHUFFLE(3, 1, 2, 0)));
+        }
+    }
+};
+#endif
+
+/** Runs the lane kernels of V over the bulk of the input, and the word kernels over the tail. */
+template<typename V, std::size_t num_words>
+struct clmul_kernels {
+    static void mul_by_constant(std::uint64_t *v, const std::size_t n, const std::uint64_t *c)
+    {
+        const std::size_t done = clmul_lane_kernels<V, num_words>::mul_by_constant(v, n, c);
+        clmul_word_kernels<num_words>::mul_by_constant(v + done * num_words, n - done, c);
+    }
+
+    static void fma_by_constant(std::uint64_t *out, const std::uint64_t *in, const std::size_t n, const std::uint64_t *c)
+    {
+        const std::size_t done = clmul_lane_kernels<V, num_words>::fma_by_constant(out, in, n, c);
+        clmul_word_kernels<num_words>::fma_by_constant(out + done * num_words, in + done * num_words, n - done, c);
+    }
+};
+
+} // namespace
+} // namespace libiop
@@ -0,0 +1,66 @@
+/**@file
+ *****************************************************************************
+ Precomputed twiddle tables for the additive FFT/IFFT over an affine subspace.
+ *****************************************************************************
+ * @author     This file is part of libiop (see AUTHORS)
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+#ifndef LIBIOP_ALGEBRA_FIELD_SUBSET_ADDITIVE_FFT_PLAN_HPP_
+#define LIBIOP_ALGEBRA_FIELD_SUBSET_ADDITIVE_FFT_PLAN_HPP_
+
+#include <cstddef>
+#include <vector>
+
+#include "libiop/algebra/field_subset/subspace.hpp"
+
+namespace libiop {
+
+enum additive_fft_type {
+    gao_mateer_additive_fft = 1,
+    cantor_additive_fft = 2
+};
+
+/** Everything the additive FFT and IFFT over a fixed affine subspace compute before touching
+ *  their input. A plan is built once per subspace and cached by it (see affine_subspace::fft_plan),
+ *  so repeated transforms over the same domain skip all setup.
+ *
+ *  Gao-Mateer: level j of the recursion twists by twist(j), and its butterflies use twiddles(j).
+ *  The FFT runs the butterflies of the levels in reverse order, the IFFT in order.
+ *
+ *  Cantor: round k has one twiddle per coset of span(basis[0], ..., basis[k]), see cantor_additive_FFT.
+ *  The plan also records the position of the shift in the Cantor basis tables,
+ *  which is what the external Cantor kernel takes as its shift argument.
+ *  That kernel only supports a zero shift or a shift found in the tables. */
+template<typename FieldT>
+class additive_fft_plan {
+protected:
+    additive_fft_type type_ = gao_mateer_additive_fft;
+    std::size_t dimension_ = 0;
+    std::vector<FieldT> twists_;
+    std::vector<FieldT> inverse_twists_;
+    std::vector<std::vector<FieldT>> twiddles_;
+    std::size_t cantor_shift_index_ = 0;
+    bool has_cantor_shift_index_ = false;
+
+    void construct_gao_mateer(const affine_subspace<FieldT> &domain);
+    void construct_cantor(const affine_subspace<FieldT> &domain);
+public:
+    /** Uses Cantor's algorithm if the domain has a Cantor basis, and Gao-Mateer otherwise. */
+    explicit additive_fft_plan(const affine_subspace<FieldT> &domain);
+    additive_fft_plan(const affine_subspace<FieldT> &domain, const additive_fft_type type);
+
+    additive_fft_type type() const;
+    std::size_t dimension() const;
+
+    const FieldT& twist(const std::size_t level) const;
+    const FieldT& inverse_twist(const std::size_t level) const;
+    const std::vector<FieldT>& twiddles(const std::size_t level) const;
+    bool has_cantor_shift_index() const;
+    std::size_t cantor_shift_index() const;
+};
+
+} // namespace libiop
+
+#include "libiop/algebra/field_subset/additive_fft_plan.tcc"
+
+#endif // LIBIOP_ALGEBRA_FIELD_SUBSET_ADDITIVE_FFT_PLAN_HPP_
@@ -0,0 +1,153 @@
+#include <cassert>
+#include <stdexcept>
+
+#include "libiop/algebra/utils.hpp"
+#include "libiop/algebra/field_subset/cantor_basis.hpp"
+
+namespace libiop {
+
+template<typename FieldT>
+additive_fft_plan<FieldT>::additive_fft_plan(const affine_subspace<FieldT> &domain) :
+    additive_fft_plan<FieldT>(domain, domain.is_cantor_basis() ? cantor_additive_fft : gao_mateer_additive_fft)
+{
+}
+
+template<typename FieldT>
+additive_fft_plan<FieldT>::additive_fft_plan(const affine_subspace<FieldT> &domain,
+                                             const additive_fft_type type) :
+    type_(type),
+    dimension_(domain.dimension()),
+    cantor_shift_index_(0)
+{
+    if (type == gao_mateer_additive_fft)
+    {
+        this->construct_gao_mateer(domain);
+    }
+    else if (type == cantor_additive_fft)
+    {
+        if (!domain.is_cantor_basis())
+        {
+            throw std::invalid_argument("Cantor's additive FFT requires a domain with a Cantor basis");
+        }
+        this->construct_cantor(domain);
+    }
+    else
+    {
+        throw std::invalid_argument("unknown additive FFT type");
+    }
+}
+
+template<typename FieldT>
+void additive_fft_plan<FieldT>::construct_gao_mateer(const affine_subspace<FieldT> &domain)
+{
+    const size_t m = this->dimension_;
+    this->twists_.reserve(m);
+    this->inverse_twists_.reserve(m);
+    this->twiddles_.reserve(m);
+
+    std::vector<FieldT> betas2(domain.basis());
+    FieldT shift2 = domain.shift();
+    for (size_t j = 0; j < m; ++j)
+    {
+        const FieldT beta = betas2[m-1-j];
+        const FieldT betainv = beta.inverse();
+        this->twists_.emplace_back(beta);
+        this->inverse_twists_.emplace_back(betainv);
+
+        std::vector<FieldT> newbetas(m-1-j, FieldT(0));
+        for (size_t i = 0; i < m-1-j; ++i)
+        {
+            FieldT newbeta = betas2[i] * betainv;
+            newbetas[i] = newbeta;
+            betas2[i] = newbeta.squared() - newbeta;
+        }
+
+        FieldT newshift = shift2 * betainv;
+        shift2 = newshift.squared() - newshift;
+
+        this->twiddles_.emplace_back(all_subset_sums<FieldT>(newbetas, newshift));
+    }
+}
+
+template<typename FieldT>
+void additive_fft_plan<FieldT>::construct_cantor(const affine_subspace<FieldT> &domain)
+{
+    const size_t m = this->dimension_;
+    assert(m == 0 || domain.basis()[0] == FieldT::one());
+    this->twiddles_.reserve(m);
+
+    /* In round k the twiddles are all subset sums of basis[1], ..., basis[m-1-k],
+       shifted by s_k(shift), where s_k(x) = s_{k-1}(x)^2 + s_{k-1}(x) */
+    const std::vector<FieldT> &basis = domain.basis();
+    FieldT shift_image = domain.shift();
+    for (size_t k = 0; k < m; ++k)
+    {
+        const std::vector<FieldT> coset_basis(basis.begin() + 1, basis.begin() + (m - k));
+        this->twiddles_.emplace_back(all_subset_sums<FieldT>(coset_basis, shift_image));
+        shift_image = shift_image.squared() + shift_image;
+    }
+
+    this->has_cantor_shift_index_ = (domain.shift() == FieldT::zero());
+    if (domain.shift() != FieldT::zero())
+    {
+        const std::vector<uint64_t> shift_words = domain.shift().to_words();
+        for (size_t i = 0; i < 32; ++i)
+        {
+            if (   (FieldT::extension_degree() == 128 && shift_words[0] == cantor_in_gf2to128[i][0] && shift_words[1] == cantor_in_gf2to128[i][1])
+                || (FieldT::extension_degree() == 192 && shift_words[0] == cantor_in_gf2to192[i][0] && shift_words[1] == cantor_in_gf2to192[i][1] && shift_words[2] == cantor_in_gf2to192[i][2])
+                || (FieldT::extension_degree() == 256 && shift_words[0] == cantor_in_gf2to256[i][0] && shift_words[1] == cantor_in_gf2to256[i][1] && shift_words[2] == cantor_in_gf2to256[i][2] && shift_words[3] == cantor_in_gf2to256[i][3]))
+            {
+                this->cantor_shift_index_ = i;
+                this->has_cantor_shift_index_ = true;
+                break;
+            }
+        }
+    }
+}
+
+template<typename FieldT>
+additive_fft_type additive_fft_plan<FieldT>::type() const
+{
+    return this->type_;
+}
+
+template<typename FieldT>
+std::size_t additive_fft_plan<FieldT>::dimension() const
+{
+    return this->dimension_;
+}
+
+template<typename FieldT>
+const FieldT& additive_fft_plan<FieldT>::twist(const std::size_t level) const
+{
+    assert(this->type_ == gao_mateer_additive_fft);
+    return this->twists_[level];
+}
+
+template<typename FieldT>
+const FieldT& additive_fft_plan<FieldT>::inverse_twist(const std::size_t level) const
+{
+    assert(this->type_ == gao_mateer_additive_fft);
+    return this->inverse_twists_[level];
+}
+
+template<typename FieldT>
+const std::vector<FieldT>& additive_fft_plan<FieldT>::twiddles(const std::size_t level) const
+{
+    return this->twiddles_[level];
+}
+
+template<typename FieldT>
+bool additive_fft_plan<FieldT>::has_cantor_shift_index() const
+{
+    return this->has_cantor_shift_index_;
+}
+
+template<typename FieldT>
+std::size_t additive_fft_plan<FieldT>::cantor_shift_index() const
+{
+    assert(this->type_ == cantor_additive_fft);
+    return this->cantor_shift_index_;
+}
+
+} // namespace libiop
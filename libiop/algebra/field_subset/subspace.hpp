@@ -9,6 +9,8 @@
 #define LIBIOP_ALGEBRA_SUBSPACES_HPP_
 
 #include <cstddef>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <libff/algebra/field_utils/field_utils.hpp>
 
@@ -50,10 +52,21 @@ public:
     bool operator!=(const linear_subspace<FieldT> &other) const;
 };
 
+template<typename FieldT>
+class additive_fft_plan;
+
+/** The FFT plan of a subspace, built at most once, even when several threads ask for it together. */
+template<typename FieldT>
+struct affine_subspace_fft_plan_slot {
+    std::once_flag built;
+    std::shared_ptr<additive_fft_plan<FieldT>> plan;
+};
+
 template<typename FieldT>
 class affine_subspace : public linear_subspace<FieldT> {
 protected:
     FieldT shift_;
+    std::shared_ptr<affine_subspace_fft_plan_slot<FieldT>> fft_plan_;
 
 public:
     affine_subspace() = default;
@@ -69,6 +82,10 @@ public:
     bool element_in_subset(const FieldT x) const;
     FieldT element_outside_of_subset() const;
 
+    /* Computed on first use, and shared by all copies of this subspace. The plan holds about
+       |subspace| twiddles, which are freed with the last copy of the subspace. */
+    std::shared_ptr<additive_fft_plan<FieldT>> fft_plan() const;
+
     static affine_subspace<FieldT> shifted_standard_basis(
         const std::size_t dimension,
         const FieldT& shift);
@@ -2,6 +2,7 @@
 
 #include "libiop/algebra/utils.hpp"
 #include "libiop/algebra/field_subset/cantor_basis.hpp"
+#include "libiop/algebra/field_subset/additive_fft_plan.hpp"
 
 namespace libiop {
 
@@ -152,7 +153,8 @@ bool linear_subspace<FieldT>::operator!=(const linear_subspace<FieldT> &other) c
 template<typename FieldT>
 affine_subspace<FieldT>::affine_subspace(const std::vector<FieldT> &basis,
                                          const FieldT &shift) :
-    linear_subspace<FieldT>(basis), shift_(shift)
+    linear_subspace<FieldT>(basis), shift_(shift),
+    fft_plan_(std::make_shared<affine_subspace_fft_plan_slot<FieldT>>())
 {
 }
 
@@ -161,7 +163,8 @@ affine_subspace<FieldT>::affine_subspace(
     const linear_subspace<FieldT> &base_space,
     const FieldT &shift) :
     linear_subspace<FieldT>(base_space),
-    shift_(shift)
+    shift_(shift),
+    fft_plan_(std::make_shared<affine_subspace_fft_plan_slot<FieldT>>())
 {
 }
 
@@ -170,7 +173,8 @@ affine_subspace<FieldT>::affine_subspace(
     linear_subspace<FieldT> &&base_space,
     const FieldT &shift) :
     linear_subspace<FieldT>(std::move(base_space)),
-    shift_(shift)
+    shift_(shift),
+    fft_plan_(std::make_shared<affine_subspace_fft_plan_slot<FieldT>>())
 {
 }
 
@@ -193,6 +197,21 @@ FieldT affine_subspace<FieldT>::element_by_index(const std::size_t index) const
 }
 
 
+template<typename FieldT>
+std::shared_ptr<additive_fft_plan<FieldT>> affine_subspace<FieldT>::fft_plan() const
+{
+    if (!this->fft_plan_)
+    {
+        /* Default constructed subspace, which has no cache to fill */
+        return std::make_shared<additive_fft_plan<FieldT>>(*this);
+    }
+    affine_subspace_fft_plan_slot<FieldT> &slot = *this->fft_plan_;
+    std::call_once(slot.built, [this, &slot]() {
+        slot.plan = std::make_shared<additive_fft_plan<FieldT>>(*this);
+    });
+    return slot.plan;
+}
+
 template<typename FieldT>
 bool internal_element_in_subset(const typename libff::enable_if<libff::is_multiplicative<FieldT>::value, FieldT>::type x,
     FieldT shift, size_t dimension)
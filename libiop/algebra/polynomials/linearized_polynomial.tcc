@@ -1,5 +1,6 @@
 #include <algorithm>
 
+#include "libiop/algebra/field_kernels.hpp"
 #include "libiop/algebra/field_subset/field_subset.hpp"
 #include "libiop/algebra/polynomials/polynomial.hpp"
 #include "libiop/algebra/fft.hpp"
@@ -199,9 +200,7 @@ void add_scalar_multiple_at_shift(std::vector<FieldT> &result,
     if (factor == FieldT::zero()) {
         return;
     }
-    for (std::size_t i = 0; i < p.size(); i++) {
-        result[i + shift] += p[i] * factor;
-    }
+    fma_by_constant<FieldT>(result.data() + shift, p.data(), p.size(), factor);
 }
 
 template<typename FieldT>
@@ -1,5 +1,6 @@
 #include <algorithm>
 
+#include "libiop/algebra/field_kernels.hpp"
 #include "libiop/algebra/field_subset/field_subset.hpp"
 #include "libiop/algebra/fft.hpp"
 
@@ -46,8 +47,7 @@ bool polynomial<FieldT>::coefficients_equivalent_with(const polynomial<FieldT> &
 template<typename FieldT>
 void polynomial<FieldT>::multiply_coefficients_by(const FieldT &other)
 {
-    std::for_each(this->coefficients_.begin(), this->coefficients_.end(),
-                  [other](FieldT &el) { el *= other; });
+    mul_by_constant<FieldT>(this->coefficients_.data(), this->coefficients_.size(), other);
 }
 
 template<typename FieldT>
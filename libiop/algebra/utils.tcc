@@ -3,6 +3,8 @@
 
 #include <libff/common/utils.hpp>
 
+#include "libiop/common/parallel.hpp"
+
 namespace libiop {
 
 template<typename T>
@@ -148,6 +150,9 @@ void bitreverse_vector(std::vector<T> &a)
     const size_t logn = libff::log2(n);
     assert(n == 1ull<<logn);
 
+#ifdef MULTICORE
+    #pragma omp parallel for if (n >= parallel_min_size)
+#endif
     for (size_t k = 0; k < n; ++k)
     {
         const size_t rk = libff::bitreverse(k, logn);
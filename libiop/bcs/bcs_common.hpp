@@ -11,6 +11,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <map>
+#include <string>
 #include <vector>
 
 #include "libiop/iop/iop.hpp"
@@ -31,6 +32,11 @@ struct bcs_transformation_parameters {
     std::shared_ptr<hashchain<FieldT, MT_hash_type>> hashchain_;
     std::shared_ptr<leafhash<FieldT, MT_hash_type>> leafhasher_;
     two_to_one_hash_function<MT_hash_type> compression_hasher;
+
+    /* When set, the prover moves each round's oracles out of memory into a temporary
+       file in this directory ("" for $TMPDIR) once their Merkle trees are built. */
+    bool spill_oracles_ = false;
+    std::string oracle_spill_directory_;
 };
 
 template<typename FieldT, typename MT_hash_type>
@@ -95,10 +101,21 @@ class bcs_transformation_transcript {
     std::size_t size_in_bytes_without_pruning() const;
 
 
+    /* Legacy text format. deserialize also accepts the binary format, which it recognizes by its magic. */
     std::ostream& serialize(
         std::ostream &out) const;
     std::istream& deserialize(
         std::istream &in);
+
+    /* Versioned binary format, see bcs_common.tcc. Field elements are stored as their in-memory limbs,
+       so deserializing from a buffer (e.g. a memory-mapped file) copies each vector of them at once.
+       Malformed input throws std::invalid_argument. */
+    std::ostream& serialize_binary(
+        std::ostream &out) const;
+    std::istream& deserialize_binary(
+        std::istream &in);
+    void deserialize_binary(
+        const unsigned char *data, const std::size_t size);
     // friend std::ostream& operator<< <FieldT, MT_hash_type>(std::ostream &out, 
     //     const bcs_transformation_transcript<FieldT, MT_hash_type>> &t);
     // friend std::istream& operator>> <FieldT, MT_hash_type>(std::istream &in, 
@@ -1,6 +1,11 @@
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
 #include <numeric>
 #include <set>
+#include <stdexcept>
+#include <type_traits>
 #include <libff/algebra/field_utils/bigint.hpp>
 #include <libff/common/profiling.hpp>
 
@@ -383,12 +388,308 @@ std::ostream& bcs_transformation_transcript<FieldT, MT_hash_type>::serialize(std
     return serialize_transcript_internal<FieldT, MT_hash_type>(FieldT::zero(), FieldT::zero(), out, *this);
 }
 
+/** Binary transcript format, version 1. Integers are little endian.
+ *
+ *    "LIOP" | u32 version | u32 field element size s | the s bytes of FieldT::one()
+ *    prover_messages_ | MT_roots_ | query_positions_ | query_responses_ | MT_leaf_positions_ |
+ *    MT_set_membership_proofs_ (auxiliary_hashes, then randomness_hashes, for each) |
+ *    proof_of_work_ | u64 total_depth_without_pruning
+ *
+ *  Vectors are a u64 length followed by their entries, and positions are u64s. Field elements are
+ *  their s in-memory bytes (Montgomery form for prime fields), so that a vector of them is copied at once.
+ *  The bytes of one identify the field, its representation and the byte order.
+ *  Binary hash digests are a u8 length followed by their bytes. */
+const char bcs_binary_transcript_magic[4] = {'L', 'I', 'O', 'P'};
+const std::uint32_t bcs_binary_transcript_version = 1;
+
+inline void write_binary_transcript_uint(std::ostream &out, std::uint64_t x, const std::size_t num_bytes)
+{
+    char bytes[sizeof(std::uint64_t)];
+    for (std::size_t i = 0; i < num_bytes; ++i)
+    {
+        bytes[i] = (char) (x & 0xFF);
+        x >>= 8;
+    }
+    out.write(bytes, num_bytes);
+}
+
+/** Reads a binary transcript out of a buffer, checking every read against its end. */
+class binary_transcript_reader {
+protected:
+    const unsigned char *next_;
+    const unsigned char *end_;
+public:
+    binary_transcript_reader(const unsigned char *data, const std::size_t size) :
+        next_(data), end_(data + size) {}
+
+    std::size_t remaining() const { return end_ - next_; }
+
+    const unsigned char *take(const std::size_t num_bytes)
+    {
+        if (num_bytes > this->remaining())
+        {
+            throw std::invalid_argument("Binary transcript is truncated.");
+        }
+        const unsigned char *bytes = next_;
+        next_ += num_bytes;
+        return bytes;
+    }
+
+    std::uint64_t read_uint(const std::size_t num_bytes)
+    {
+        const unsigned char *bytes = this->take(num_bytes);
+        std::uint64_t x = 0;
+        for (std::size_t i = num_bytes; i-- > 0; )
+        {
+            x = (x << 8) | bytes[i];
+        }
+        return x;
+    }
+
+    /* Checked against the bytes left, so that a corrupt length can not cause a huge allocation */
+    std::size_t read_length(const std::size_t min_bytes_per_entry)
+    {
+        const std::uint64_t length = this->read_uint(sizeof(std::uint64_t));
+        if (length > this->remaining() / min_bytes_per_entry)
+        {
+            throw std::invalid_argument("Binary transcript has an invalid vector length.");
+        }
+        return (std::size_t) length;
+    }
+};
+
+/* Prime field elements are only valid when their Montgomery form is reduced */
+template<typename FieldT>
+bool field_elems_are_reduced(
+    const typename libff::enable_if<libff::is_multiplicative<FieldT>::value, FieldT>::type *v,
+    const std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (mpn_cmp(v[i].mont_repr.data, FieldT::mod.data, FieldT::num_limbs) >= 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Every bit pattern is a binary field element */
+template<typename FieldT>
+bool field_elems_are_reduced(
+    const typename libff::enable_if<!libff::is_multiplicative<FieldT>::value, FieldT>::type *v,
+    const std::size_t n)
+{
+    return true;
+}
+
+template<typename FieldT>
+void write_binary_field_elems(std::ostream &out, const std::vector<FieldT> &v)
+{
+    write_binary_transcript_uint(out, v.size(), sizeof(std::uint64_t));
+    out.write(reinterpret_cast<const char*>(v.data()), v.size() * sizeof(FieldT));
+}
+
+template<typename FieldT>
+void read_binary_field_elems(binary_transcript_reader &in, std::vector<FieldT> &v)
+{
+    const std::size_t length = in.read_length(sizeof(FieldT));
+    const unsigned char *bytes = in.take(length * sizeof(FieldT));
+    v.resize(length);
+    if (length > 0)
+    {
+        std::memcpy(v.data(), bytes, length * sizeof(FieldT));
+    }
+    if (!field_elems_are_reduced<FieldT>(v.data(), length))
+    {
+        throw std::invalid_argument("Binary transcript has an invalid field element.");
+    }
+}
+
+template<typename FieldT>
+void write_binary_field_elem_vecs(std::ostream &out, const std::vector<std::vector<FieldT>> &v)
+{
+    write_binary_transcript_uint(out, v.size(), sizeof(std::uint64_t));
+    for (const std::vector<FieldT> &entry : v)
+    {
+        write_binary_field_elems<FieldT>(out, entry);
+    }
+}
+
+template<typename FieldT>
+void read_binary_field_elem_vecs(binary_transcript_reader &in, std::vector<std::vector<FieldT>> &v)
+{
+    v.resize(in.read_length(sizeof(std::uint64_t)));
+    for (std::vector<FieldT> &entry : v)
+    {
+        read_binary_field_elems<FieldT>(in, entry);
+    }
+}
+
+inline void write_binary_positions(std::ostream &out, const std::vector<std::vector<std::size_t>> &v)
+{
+    write_binary_transcript_uint(out, v.size(), sizeof(std::uint64_t));
+    for (const std::vector<std::size_t> &entry : v)
+    {
+        write_binary_transcript_uint(out, entry.size(), sizeof(std::uint64_t));
+        for (const std::size_t position : entry)
+        {
+            write_binary_transcript_uint(out, position, sizeof(std::uint64_t));
+        }
+    }
+}
+
+inline void read_binary_positions(binary_transcript_reader &in, std::vector<std::vector<std::size_t>> &v)
+{
+    v.resize(in.read_length(sizeof(std::uint64_t)));
+    for (std::vector<std::size_t> &entry : v)
+    {
+        entry.resize(in.read_length(sizeof(std::uint64_t)));
+        for (std::size_t &position : entry)
+        {
+            position = (std::size_t) in.read_uint(sizeof(std::uint64_t));
+        }
+    }
+}
+
+/* Algebraic digests are field elements */
+template<typename FieldT>
+void write_binary_digests(std::ostream &out, const std::vector<FieldT> &v)
+{
+    write_binary_field_elems<FieldT>(out, v);
+}
+
+template<typename FieldT>
+void read_binary_digests(binary_transcript_reader &in, std::vector<FieldT> &v)
+{
+    read_binary_field_elems<FieldT>(in, v);
+}
+
+inline void write_binary_digests(std::ostream &out, const std::vector<binary_hash_digest> &v)
+{
+    write_binary_transcript_uint(out, v.size(), sizeof(std::uint64_t));
+    for (const binary_hash_digest &digest : v)
+    {
+        write_binary_transcript_uint(out, digest.size(), 1);
+        out.write(reinterpret_cast<const char*>(digest.data()), digest.size());
+    }
+}
+
+inline void read_binary_digests(binary_transcript_reader &in, std::vector<binary_hash_digest> &v)
+{
+    v.resize(in.read_length(1));
+    for (binary_hash_digest &digest : v)
+    {
+        const std::size_t size = (std::size_t) in.read_uint(1);
+        const unsigned char *bytes = in.take(size);
+        digest = binary_hash_digest(bytes, bytes + size);
+    }
+}
+
 template<typename FieldT, typename MT_hash_type>
 std::istream& bcs_transformation_transcript<FieldT, MT_hash_type>::deserialize(std::istream &in)
 {
+    if (in.peek() == bcs_binary_transcript_magic[0])
+    {
+        return this->deserialize_binary(in);
+    }
     return deserialize_transcript_internal<FieldT, MT_hash_type>(FieldT::zero(), FieldT::zero(), in, *this);
 }
 
+template<typename FieldT, typename MT_hash_type>
+std::ostream& bcs_transformation_transcript<FieldT, MT_hash_type>::serialize_binary(std::ostream &out) const
+{
+    static_assert(std::is_trivially_copyable<FieldT>::value,
+                  "Binary transcripts store field elements as their in-memory bytes.");
+    out.write(bcs_binary_transcript_magic, sizeof(bcs_binary_transcript_magic));
+    write_binary_transcript_uint(out, bcs_binary_transcript_version, sizeof(std::uint32_t));
+    write_binary_transcript_uint(out, sizeof(FieldT), sizeof(std::uint32_t));
+    const FieldT one = FieldT::one();
+    out.write(reinterpret_cast<const char*>(&one), sizeof(FieldT));
+
+    write_binary_field_elem_vecs<FieldT>(out, this->prover_messages_);
+    write_binary_digests(out, this->MT_roots_);
+    write_binary_positions(out, this->query_positions_);
+    write_binary_transcript_uint(out, this->query_responses_.size(), sizeof(std::uint64_t));
+    for (const std::vector<std::vector<FieldT>> &responses : this->query_responses_)
+    {
+        write_binary_field_elem_vecs<FieldT>(out, responses);
+    }
+    write_binary_positions(out, this->MT_leaf_positions_);
+    write_binary_transcript_uint(out, this->MT_set_membership_proofs_.size(), sizeof(std::uint64_t));
+    for (const merkle_tree_set_membership_proof<MT_hash_type> &proof : this->MT_set_membership_proofs_)
+    {
+        write_binary_digests(out, proof.auxiliary_hashes);
+        write_binary_digests(out, proof.randomness_hashes);
+    }
+    write_binary_digests(out, std::vector<MT_hash_type>({this->proof_of_work_}));
+    write_binary_transcript_uint(out, this->total_depth_without_pruning, sizeof(std::uint64_t));
+    return out;
+}
+
+/* Reads to the end of the stream */
+template<typename FieldT, typename MT_hash_type>
+std::istream& bcs_transformation_transcript<FieldT, MT_hash_type>::deserialize_binary(std::istream &in)
+{
+    const std::vector<char> buffer((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    this->deserialize_binary(reinterpret_cast<const unsigned char*>(buffer.data()), buffer.size());
+    return in;
+}
+
+template<typename FieldT, typename MT_hash_type>
+void bcs_transformation_transcript<FieldT, MT_hash_type>::deserialize_binary(
+    const unsigned char *data, const std::size_t size)
+{
+    binary_transcript_reader in(data, size);
+    if (std::memcmp(in.take(sizeof(bcs_binary_transcript_magic)), bcs_binary_transcript_magic,
+                    sizeof(bcs_binary_transcript_magic)) != 0)
+    {
+        throw std::invalid_argument("Not a binary transcript.");
+    }
+    if (in.read_uint(sizeof(std::uint32_t)) != bcs_binary_transcript_version)
+    {
+        throw std::invalid_argument("Unsupported binary transcript version.");
+    }
+    const FieldT one = FieldT::one();
+    if (in.read_uint(sizeof(std::uint32_t)) != sizeof(FieldT) ||
+        std::memcmp(in.take(sizeof(FieldT)), &one, sizeof(FieldT)) != 0)
+    {
+        throw std::invalid_argument("Binary transcript is over a different field.");
+    }
+
+    /* Only overwrites this transcript once all of it has been read */
+    bcs_transformation_transcript<FieldT, MT_hash_type> result;
+    read_binary_field_elem_vecs<FieldT>(in, result.prover_messages_);
+    read_binary_digests(in, result.MT_roots_);
+    read_binary_positions(in, result.query_positions_);
+    result.query_responses_.resize(in.read_length(sizeof(std::uint64_t)));
+    for (std::vector<std::vector<FieldT>> &responses : result.query_responses_)
+    {
+        read_binary_field_elem_vecs<FieldT>(in, responses);
+    }
+    read_binary_positions(in, result.MT_leaf_positions_);
+    result.MT_set_membership_proofs_.resize(in.read_length(2 * sizeof(std::uint64_t)));
+    for (merkle_tree_set_membership_proof<MT_hash_type> &proof : result.MT_set_membership_proofs_)
+    {
+        read_binary_digests(in, proof.auxiliary_hashes);
+        read_binary_digests(in, proof.randomness_hashes);
+    }
+    std::vector<MT_hash_type> proof_of_work;
+    read_binary_digests(in, proof_of_work);
+    if (proof_of_work.size() != 1)
+    {
+        throw std::invalid_argument("Binary transcript has an invalid proof of work.");
+    }
+    result.proof_of_work_ = proof_of_work[0];
+    result.total_depth_without_pruning = (std::size_t) in.read_uint(sizeof(std::uint64_t));
+    if (in.remaining() != 0)
+    {
+        throw std::invalid_argument("Binary transcript has trailing bytes.");
+    }
+
+    *this = std::move(result);
+}
+
 template<typename FieldT, typename MT_root_hash>
 std::size_t bcs_transformation_transcript<FieldT, MT_root_hash>::size_in_bytes_without_pruning() const
 {
@@ -609,7 +910,7 @@ void bcs_protocol<FieldT, MT_root_hash>::squeeze_verifier_random_messages(
     {
         const std::size_t message_length = this->verifier_random_message_registrations_[i].size();
         const std::vector<FieldT> result = this->hashchain_->squeeze(message_length);
-        this->verifier_random_messages_.insert(std::pair<size_t, std::vector<FieldT>>(i, result));
+        this->verifier_random_messages_.insert(i, result);
     }
 }
 
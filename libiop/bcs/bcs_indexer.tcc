@@ -32,10 +32,10 @@ void bcs_indexer<FieldT, MT_hash_type>::signal_index_submissions_done()
     std::vector<MT_hash_type> roots;
     for (auto &kv : mapping)
     {
-        std::vector<std::shared_ptr<std::vector<FieldT>>> all_evaluated_contents;
+        std::vector<std::shared_ptr<const std::vector<FieldT>>> all_evaluated_contents;
         for (auto &v : kv.second)
         {
-            std::shared_ptr<std::vector<FieldT>> oracle_contents = this->oracles_[v.id()].evaluated_contents();
+            std::shared_ptr<const std::vector<FieldT>> oracle_contents = this->oracles_[v.id()].evaluated_contents();
             all_evaluated_contents.emplace_back(oracle_contents);
         }
         libff::enter_block("Construct Merkle tree");
@@ -47,7 +47,7 @@ void bcs_indexer<FieldT, MT_hash_type>::signal_index_submissions_done()
         /* Now make the oracles in a form suitable for creating an index */
         for (auto &v : kv.second)
         {
-            std::shared_ptr<std::vector<FieldT>> oracle_contents = this->oracles_[v.id()].evaluated_contents();
+            std::shared_ptr<const std::vector<FieldT>> oracle_contents = this->oracles_[v.id()].evaluated_contents();
             this->indexed_oracles_.emplace_back(*oracle_contents.get());
             this->oracles_[v.id()].erase_contents();
         }
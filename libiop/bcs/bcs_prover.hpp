@@ -12,6 +12,7 @@
 
 #include <libff/common/profiling.hpp>
 #include "libiop/bcs/bcs_common.hpp"
+#include "libiop/iop/oracle_spill.hpp"
 
 namespace libiop {
 
@@ -22,7 +23,14 @@ protected:
     bool is_preprocessing_ = false;
     size_t num_indexed_MTs_ = 0;
     std::vector<std::vector<FieldT>> indexed_prover_messages_;
+    /* Only set when parameters.spill_oracles_ is */
+    std::shared_ptr<oracle_spill_file> oracle_spill_file_;
     void remove_index_info_from_transcript(bcs_transformation_transcript<FieldT, MT_hash_type> &transcript);
+    /** Oracles from the given round are only read again to answer queries, or by virtual
+     *  oracles, so they can be reloaded from the spill file on demand. This bounds
+     *  resident oracle data to roughly one round's worth of codewords, plus whatever
+     *  the protocol itself still holds on to. */
+    void spill_oracles_of_round(const std::size_t round);
 public:
     bcs_prover(const bcs_transformation_parameters<FieldT, MT_hash_type> &parameters);
     /* Mutates index */
@@ -49,6 +57,8 @@ public:
 
     std::size_t MT_size() const;
     std::size_t state_size() const;
+    /** The file committed oracles are spilled to, or null when they stay in memory */
+    std::shared_ptr<const oracle_spill_file> spill_file() const;
 
     void describe_sizes() const;
 };
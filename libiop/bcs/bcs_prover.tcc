@@ -6,6 +6,10 @@ bcs_prover<FieldT, MT_hash_type>::bcs_prover(
     bcs_protocol<FieldT, MT_hash_type>(parameters),
     is_preprocessing_(false)
 {
+    if (parameters.spill_oracles_)
+    {
+        this->oracle_spill_file_ = std::make_shared<oracle_spill_file>(parameters.oracle_spill_directory_);
+    }
 }
 
 template<typename FieldT, typename MT_hash_type>
@@ -15,6 +19,10 @@ bcs_prover<FieldT, MT_hash_type>::bcs_prover(
     bcs_protocol<FieldT, MT_hash_type>(parameters),
     is_preprocessing_(true)
 {
+    if (parameters.spill_oracles_)
+    {
+        this->oracle_spill_file_ = std::make_shared<oracle_spill_file>(parameters.oracle_spill_directory_);
+    }
     this->num_indexed_MTs_ = index.index_MTs_.size();
     std::swap(this->Merkle_trees_, index.index_MTs_);
     this->indexed_prover_messages_ = index.indexed_messages_;
@@ -35,7 +43,7 @@ void bcs_prover<FieldT, MT_hash_type>::signal_prover_round_done()
      */
     for (auto &kv : mapping)
     {
-        std::vector<std::shared_ptr<std::vector<FieldT>>> all_oracle_evaluated_contents;
+        std::vector<std::shared_ptr<const std::vector<FieldT>>> all_oracle_evaluated_contents;
         for (auto &v : kv.second) // kv.second is a vector of all oracle handles over this domain from this round.
         {
             all_oracle_evaluated_contents.emplace_back(this->oracles_[v.id()].evaluated_contents());
@@ -47,6 +55,7 @@ void bcs_prover<FieldT, MT_hash_type>::signal_prover_round_done()
     }
 
     this->run_hashchain_for_round();
+    this->spill_oracles_of_round(ended_round);
 
     libff::leave_block("Finish prover round");
     libff::enter_block("pow");
@@ -76,6 +85,26 @@ void bcs_prover<FieldT, MT_hash_type>::signal_index_submissions_done()
 
     /* The Merkle trees are already filled in by the preprocessor. */
     this->run_hashchain_for_round();
+    this->spill_oracles_of_round(this->num_prover_rounds_done_ - 1);
+}
+
+template<typename FieldT, typename MT_hash_type>
+void bcs_prover<FieldT, MT_hash_type>::spill_oracles_of_round(const std::size_t round)
+{
+    if (!this->oracle_spill_file_)
+    {
+        return;
+    }
+
+    libff::enter_block("Spill oracles");
+    for (auto &kv : this->oracles_in_round_by_domain(round))
+    {
+        for (auto &v : kv.second)
+        {
+            this->oracles_[v.id()].spill_contents(this->oracle_spill_file_);
+        }
+    }
+    libff::leave_block("Spill oracles");
 }
 
 template<typename FieldT, typename MT_hash_type>
@@ -105,7 +134,9 @@ std::vector<FieldT> bcs_prover<FieldT, MT_hash_type>::obtain_verifier_random_mes
 {
     /* TODO: Refactor out checks in the IOP layer */
     // iop_protocol<FieldT>::obtain_verifier_random_message(random_message);
-    return this->verifier_random_messages_[random_message.id()];
+    /* Messages of rounds that have not been squeezed yet are empty */
+    const std::vector<FieldT> *message = this->verifier_random_messages_.find(random_message.id());
+    return (message == nullptr) ? std::vector<FieldT>() : *message;
 }
 
 template<typename FieldT, typename MT_hash_type>
@@ -250,6 +281,12 @@ std::size_t bcs_prover<FieldT, MT_hash_type>::state_size() const
     return (this->num_bytes_across_all_oracles() + this->MT_size());
 }
 
+template<typename FieldT, typename MT_hash_type>
+std::shared_ptr<const oracle_spill_file> bcs_prover<FieldT, MT_hash_type>::spill_file() const
+{
+    return this->oracle_spill_file_;
+}
+
 template<typename FieldT, typename MT_hash_type>
 void bcs_prover<FieldT, MT_hash_type>::describe_sizes() const
 {
@@ -9,9 +9,11 @@
 #define LIBIOP_SNARK_COMMON_BCS16_VERIFIER_HPP_
 
 #include <set>
+#include <utility>
 
 #include <libff/common/profiling.hpp>
 #include "libiop/bcs/bcs_common.hpp"
+#include "libiop/common/flat_map.hpp"
 
 namespace libiop {
 
@@ -19,7 +21,11 @@ template<typename FieldT, typename MT_hash_type>
 class bcs_verifier : public bcs_protocol<FieldT, MT_hash_type> {
 protected:
     bcs_transformation_transcript<FieldT, MT_hash_type> transcript_;
-    std::map<std::pair<std::size_t, std::size_t>, FieldT> oracle_id_and_pos_idx_to_value_;
+    /* Query responses are read from the transcript: each oracle id maps to its Merkle tree
+       and its column in that tree's query responses, and each query position of a Merkle tree
+       maps to its row */
+    dense_id_map<std::pair<std::size_t, std::size_t> > oracle_id_to_MT_and_column_;
+    std::vector<flat_hash_map<std::size_t> > MT_query_position_to_row_;
     bool transcript_is_valid_;
 
     bool is_preprocessing_ = false;
@@ -108,26 +108,31 @@ void bcs_verifier<FieldT, hash_digest_type>::seal_interaction_registrations()
 template<typename FieldT, typename MT_hash_type>
 void bcs_verifier<FieldT, MT_hash_type>::parse_query_responses_from_transcript()
 {
+    this->oracle_id_to_MT_and_column_.reserve(this->oracle_registrations_.size());
+    this->MT_query_position_to_row_.resize(this->transcript_.query_positions_.size());
+
     std::size_t processed_MTs = 0;
     for (std::size_t round = 0; round < this->num_interaction_rounds_; ++round)
     {
         const domain_to_oracles_map mapping = this->oracles_in_round_by_domain(round);
-        const round_parameters<FieldT> round_params = this->get_round_parameters(round);
 
-        /* For each oracle, pick out positions and values from the transcript
-            and store them. */
+        /* For each Merkle tree, index the rows of its query positions,
+            and record where each of its oracles' values are. */
         for (auto &kv : mapping)
         {
+            const std::vector<std::size_t> &query_positions = this->transcript_.query_positions_[processed_MTs];
+            flat_hash_map<std::size_t> &position_to_row = this->MT_query_position_to_row_[processed_MTs];
+            position_to_row.reserve(query_positions.size());
+            for (std::size_t i = 0; i < query_positions.size(); ++i)
+            {
+                position_to_row.insert(query_positions[i], i);
+            }
+
             std::size_t oracles_processed_for_MT = 0;
             for (auto &oh : kv.second)
             {
-                for (std::size_t i = 0; i < this->transcript_.query_positions_[processed_MTs].size(); ++i)
-                {
-                    const std::size_t pos_idx = transcript_.query_positions_[processed_MTs][i];
-                    const FieldT value = transcript_.query_responses_[processed_MTs][i][oracles_processed_for_MT];
-
-                    this->oracle_id_and_pos_idx_to_value_[std::make_pair(oh.id(), pos_idx)] = value;
-                }
+                this->oracle_id_to_MT_and_column_.insert(
+                    oh.id(), std::make_pair(processed_MTs, oracles_processed_for_MT));
                 ++oracles_processed_for_MT;
             }
 
@@ -170,7 +175,9 @@ template<typename FieldT, typename MT_hash_type>
 std::vector<FieldT> bcs_verifier<FieldT, MT_hash_type>::obtain_verifier_random_message(
     const verifier_random_message_handle &random_message)
 {
-    return this->verifier_random_messages_[random_message.id()];
+    /* Messages of rounds that have not been squeezed yet are empty */
+    const std::vector<FieldT> *message = this->verifier_random_messages_.find(random_message.id());
+    return (message == nullptr) ? std::vector<FieldT>() : *message;
 }
 
 template<typename FieldT, typename MT_hash_type>
@@ -193,17 +200,20 @@ FieldT bcs_verifier<FieldT, MT_hash_type>::get_oracle_evaluation_at_point(
     {
         /* If real oracle, use our saved values that we saved from
            the transcript. */
-        auto it = this->oracle_id_and_pos_idx_to_value_.find(std::make_pair(handle->id(), evaluation_position));
+        const std::pair<std::size_t, std::size_t> *MT_and_column =
+            this->oracle_id_to_MT_and_column_.find(handle->id());
+        const std::size_t *row = (MT_and_column == nullptr) ? nullptr :
+            this->MT_query_position_to_row_[MT_and_column->first].find(evaluation_position);
 
 #ifdef DEBUG
         printf("query: oracle %zu at position %zu\n", handle->id(), evaluation_position);
 #endif // DEBUG
 
-        if (it == this->oracle_id_and_pos_idx_to_value_.end())
+        if (row == nullptr)
         {
             throw std::logic_error("Got a request for a query position that's unavailable in the proof.");
         }
-        return it->second;
+        return this->transcript_.query_responses_[MT_and_column->first][*row][MT_and_column->second];
     }
     else
     {
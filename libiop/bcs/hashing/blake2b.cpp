@@ -1,11 +1,15 @@
 #include "sodium/crypto_generichash_blake2b.h"
+#include <cstring>
 #include <stdexcept>
 
 #include <libff/common/utils.hpp>
-#include "libiop/bcs/hashing/hashing.hpp"
+#include "libiop/bcs/hashing/blake2b.hpp"
 
 namespace libiop {
 
+/* Out-of-class definition, needed whenever max_size is bound to a reference */
+const std::size_t binary_hash_digest::max_size;
+
 binary_hash_digest blake2b_zk_element_hash(const std::vector<uint8_t> &bytes,
                                            const std::size_t digest_len_bytes)
 {
@@ -29,15 +33,17 @@ binary_hash_digest blake2b_two_to_one_hash(const binary_hash_digest &first,
                                            const binary_hash_digest &second,
                                            const std::size_t digest_len_bytes)
 {
-    const binary_hash_digest first_plus_second = first + second;
+    unsigned char first_plus_second[2 * binary_hash_digest::max_size];
+    std::memcpy(first_plus_second, first.data(), first.size());
+    std::memcpy(first_plus_second + first.size(), second.data(), second.size());
 
     binary_hash_digest result(digest_len_bytes, 'X');
 
     /* see https://download.libsodium.org/doc/hashing/generic_hashing.html */
-    const int status = crypto_generichash_blake2b((unsigned char*)&result[0],
+    const int status = crypto_generichash_blake2b(result.data(),
                                                   digest_len_bytes,
-                                                  (unsigned char*)&first_plus_second[0],
-                                                  first_plus_second.size(),
+                                                  first_plus_second,
+                                                  first.size() + second.size(),
                                                   NULL, 0);
     if (status != 0)
     {
@@ -47,6 +53,104 @@ binary_hash_digest blake2b_two_to_one_hash(const binary_hash_digest &first,
     return result;
 }
 
+#ifdef LIBIOP_HAVE_AVX2_BLAKE2B
+/* defined in blake2b_avx2.cpp, which is compiled with AVX2 enabled */
+void blake2b_two_to_one_hash_avx2(const binary_hash_digest *children,
+                                  binary_hash_digest *parents,
+                                  const std::size_t num_parents,
+                                  const std::size_t digest_len_bytes);
+#endif
+
+#ifdef LIBIOP_HAVE_AVX512_BLAKE2B
+/* defined in blake2b_avx512.cpp, which is compiled with AVX-512 enabled */
+void blake2b_two_to_one_hash_avx512(const binary_hash_digest *children,
+                                    binary_hash_digest *parents,
+                                    const std::size_t num_parents,
+                                    const std::size_t digest_len_bytes);
+#endif
+
+static bool cpu_supports(const blake2b_batch_isa isa)
+{
+    switch (isa)
+    {
+#ifdef LIBIOP_HAVE_AVX2_BLAKE2B
+        case avx2_blake2b_batch:
+            return __builtin_cpu_supports("avx2");
+#endif
+#ifdef LIBIOP_HAVE_AVX512_BLAKE2B
+        case avx512_blake2b_batch:
+            return __builtin_cpu_supports("avx512f");
+#endif
+        default:
+            return false;
+    }
+}
+
+blake2b_batch_isa best_blake2b_batch_isa()
+{
+    static const blake2b_batch_isa best = []() {
+        for (int isa = avx512_blake2b_batch; isa > scalar_blake2b_batch; --isa)
+        {
+            if (cpu_supports((blake2b_batch_isa) isa))
+            {
+                return (blake2b_batch_isa) isa;
+            }
+        }
+        return scalar_blake2b_batch;
+    }();
+    return best;
+}
+
+void blake2b_two_to_one_hash_batch(const binary_hash_digest *children,
+                                   binary_hash_digest *parents,
+                                   const std::size_t num_parents,
+                                   const std::size_t digest_len_bytes,
+                                   const blake2b_batch_isa isa)
+{
+    /* Two digests always fit in one 128 byte block. Invalid digest lengths go through libsodium,
+       which reports them. */
+    const bool valid_digest_len = (digest_len_bytes > 0 && digest_len_bytes <= crypto_generichash_blake2b_BYTES_MAX);
+
+    int best = isa;
+    while (best > scalar_blake2b_batch && !cpu_supports((blake2b_batch_isa) best))
+    {
+        --best;
+    }
+
+    if (valid_digest_len)
+    {
+        switch (best)
+        {
+#ifdef LIBIOP_HAVE_AVX512_BLAKE2B
+            case avx512_blake2b_batch:
+                blake2b_two_to_one_hash_avx512(children, parents, num_parents, digest_len_bytes);
+                return;
+#endif
+#ifdef LIBIOP_HAVE_AVX2_BLAKE2B
+            case avx2_blake2b_batch:
+                blake2b_two_to_one_hash_avx2(children, parents, num_parents, digest_len_bytes);
+                return;
+#endif
+            default:
+                break;
+        }
+    }
+
+    for (std::size_t i = 0; i < num_parents; ++i)
+    {
+        parents[i] = blake2b_two_to_one_hash(children[2*i], children[2*i+1], digest_len_bytes);
+    }
+}
+
+bool is_blake2b_two_to_one_hash(const two_to_one_hash_function<binary_hash_digest> &node_hasher)
+{
+    typedef binary_hash_digest (*hash_function_pointer)(const binary_hash_digest&,
+                                                         const binary_hash_digest&,
+                                                         const std::size_t);
+    const hash_function_pointer *target = node_hasher.target<hash_function_pointer>();
+    return (target != nullptr && *target == &blake2b_two_to_one_hash);
+}
+
 std::size_t blake2b_integer_randomness_extractor(const binary_hash_digest &root,
                                                  const std::size_t index,
                                                  const std::size_t upper_bound)
@@ -61,7 +165,7 @@ std::size_t blake2b_integer_randomness_extractor(const binary_hash_digest &root,
     std::size_t result;
     const int status = crypto_generichash_blake2b((unsigned char*)&result,
                                                   sizeof(result),
-                                                  (unsigned char*)&root[0],
+                                                  root.data(),
                                                   root.size(),
                                                   (unsigned char*)&index, sizeof(index));
 
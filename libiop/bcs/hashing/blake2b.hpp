@@ -46,13 +46,23 @@ class blake2b_hashchain : public hashchain<FieldT, MT_root_type>
         void absorb_internal(const typename libff::enable_if<std::is_same<MT_root_type, FieldT>::value, MT_root_type>::type new_input);
 };
 
+/** Versions of the salted leaf hash. A proof only verifies with the version it was made with. */
+enum blake2b_zk_leaf_hash_version {
+    /* blake2b_two_to_one_hash(H(leaf), salt), two hash calls per leaf */
+    blake2b_zk_leaf_hash_v1 = 1,
+    /* H(leaf || salt), absorbed by a single hash call */
+    blake2b_zk_leaf_hash_v2 = 2
+};
+
 template<typename FieldT>
 class blake2b_leafhash : public leafhash<FieldT, binary_hash_digest>
 {
     protected:
     size_t digest_len_bytes_;
+    blake2b_zk_leaf_hash_version zk_version_;
     public:
-    blake2b_leafhash(size_t security_parameter);
+    blake2b_leafhash(size_t security_parameter,
+                     const blake2b_zk_leaf_hash_version zk_version = blake2b_zk_leaf_hash_v1);
     binary_hash_digest hash(const std::vector<FieldT> &leaf);
     binary_hash_digest zk_hash(const std::vector<FieldT> &leaf,
         const zk_salt_type &zk_salt);
@@ -79,6 +89,28 @@ binary_hash_digest blake2b_two_to_one_hash(const binary_hash_digest &first,
                                     const binary_hash_digest &second,
                                     const std::size_t digest_len_bytes);
 
+enum blake2b_batch_isa {
+    scalar_blake2b_batch = 0,
+    avx2_blake2b_batch = 1,   /* 4 messages per pass */
+    avx512_blake2b_batch = 2  /* 8 messages per pass */
+};
+
+/** The widest multi-lane BLAKE2b this build and CPU support. */
+blake2b_batch_isa best_blake2b_batch_isa();
+
+/** Sets parents[i] = blake2b_two_to_one_hash(children[2i], children[2i+1], digest_len_bytes), for i < num_parents.
+ *  Each pair fits in a single 128 byte BLAKE2b block, so pairs are compressed several at a time,
+ *  one per SIMD lane, using the given instruction set or the next best one the CPU supports. */
+void blake2b_two_to_one_hash_batch(const binary_hash_digest *children,
+                                   binary_hash_digest *parents,
+                                   const std::size_t num_parents,
+                                   const std::size_t digest_len_bytes,
+                                   const blake2b_batch_isa isa = best_blake2b_batch_isa());
+
+/** Whether node_hasher is blake2b_two_to_one_hash itself, so that callers can hash through
+ *  blake2b_two_to_one_hash_batch instead. */
+bool is_blake2b_two_to_one_hash(const two_to_one_hash_function<binary_hash_digest> &node_hasher);
+
 } // namespace libiop
 
 #include "libiop/bcs/hashing/blake2b.tcc"
@@ -51,12 +51,14 @@ template<typename FieldT, typename hash_data_type>
 void blake2b_hashchain<FieldT, hash_data_type>::absorb_hash_digest(
     const binary_hash_digest new_input)
 {
-    binary_hash_digest hash_input = this->internal_state_ + new_input;
+    unsigned char hash_input[2 * binary_hash_digest::max_size];
+    std::memcpy(hash_input, this->internal_state_.data(), this->internal_state_.size());
+    std::memcpy(hash_input + this->internal_state_.size(), new_input.data(), new_input.size());
 
     /* see https://download.libsodium.org/doc/hashing/generic_hashing.html */
-    const int status = crypto_generichash_blake2b((unsigned char*)&this->internal_state_[0],
+    const int status = crypto_generichash_blake2b(this->internal_state_.data(),
                                                   this->digest_len_bytes_,
-                                                  (unsigned char*)&hash_input[0],
+                                                  hash_input,
                                                   this->digest_len_bytes_,
                                                   NULL, 0);
     if (status != 0)
@@ -111,7 +113,9 @@ hash_data_type blake2b_hashchain<FieldT, hash_data_type>::squeeze_root_type()
 
 
 template<typename FieldT>
-blake2b_leafhash<FieldT>::blake2b_leafhash(size_t security_parameter)
+blake2b_leafhash<FieldT>::blake2b_leafhash(size_t security_parameter,
+                                           const blake2b_zk_leaf_hash_version zk_version) :
+    zk_version_(zk_version)
 {
     /* 2*security_parameter bits, rounded up to next byte */
     this->digest_len_bytes_ = ((2*security_parameter) + 7) / 8;
@@ -128,11 +132,41 @@ binary_hash_digest blake2b_leafhash<FieldT>::zk_hash(
     const std::vector<FieldT> &leaf,
     const zk_salt_type &zk_salt)
 {
-    /* TODO: This is inefficient (requires 2 hash calls),
-             this should be done with 1. */
-    binary_hash_digest leaf_hash = blake2b_field_element_hash<FieldT>(
-        leaf, this->digest_len_bytes_);
-    return blake2b_two_to_one_hash(leaf_hash, zk_salt, this->digest_len_bytes_);
+    if (this->zk_version_ == blake2b_zk_leaf_hash_v1)
+    {
+        /* Kept so that proofs made before v2 still verify */
+        binary_hash_digest leaf_hash = blake2b_field_element_hash<FieldT>(
+            leaf, this->digest_len_bytes_);
+        return blake2b_two_to_one_hash(leaf_hash, zk_salt, this->digest_len_bytes_);
+    }
+
+    /* The leaf and salt are streamed into one hash, without concatenating them first */
+    binary_hash_digest result(this->digest_len_bytes_, 'X');
+    crypto_generichash_blake2b_state state;
+    int status = crypto_generichash_blake2b_init(&state, NULL, 0, this->digest_len_bytes_);
+    if (status == 0 && !leaf.empty())
+    {
+        status = crypto_generichash_blake2b_update(&state,
+                                                   (const unsigned char*)&leaf[0],
+                                                   sizeof(FieldT) * leaf.size());
+    }
+    if (status == 0)
+    {
+        status = crypto_generichash_blake2b_update(&state,
+                                                   (const unsigned char*)zk_salt.data(),
+                                                   zk_salt.size());
+    }
+    if (status == 0)
+    {
+        status = crypto_generichash_blake2b_final(&state,
+                                                  (unsigned char*)result.data(),
+                                                  this->digest_len_bytes_);
+    }
+    if (status != 0)
+    {
+        throw std::runtime_error("Got non-zero status from crypto_generichash_blake2b. (Is digest_len_bytes correct?)");
+    }
+    return result;
 }
 
 // TODO: Consider how this interacts with field elems being in montgomery form
@@ -145,7 +179,7 @@ binary_hash_digest blake2b_field_element_hash(const std::vector<FieldT> &data,
     binary_hash_digest result(digest_len_bytes, 'X');
 
     /* see https://download.libsodium.org/doc/hashing/generic_hashing.html */
-    const int status = crypto_generichash_blake2b((unsigned char*)&result[0],
+    const int status = crypto_generichash_blake2b(result.data(),
                                                   digest_len_bytes,
                                                   (result.empty() ? NULL : (unsigned char*)&data[0]),
                                                   sizeof(FieldT) * data.size(),
@@ -235,7 +269,7 @@ std::vector<FieldT> blake2b_FieldT_randomness_extractor(const binary_hash_digest
 {
     const std::size_t root_plus_index_size = root.size() + sizeof(index);
     unsigned char* root_plus_index = (unsigned char*)(malloc(root_plus_index_size));
-    memcpy(root_plus_index, &root[0], root.size());
+    memcpy(root_plus_index, root.data(), root.size());
     memcpy(root_plus_index + root.size(), &index, sizeof(index));
 
     std::vector<FieldT> result;
@@ -0,0 +1,15 @@
+/* Compiled with AVX2 enabled (see libiop/CMakeLists.txt). Only called after
+   blake2b.cpp has checked that the CPU supports it. */
+#include "libiop/bcs/hashing/blake2b_lanes.tcc"
+
+namespace libiop {
+
+void blake2b_two_to_one_hash_avx2(const binary_hash_digest *children,
+                                  binary_hash_digest *parents,
+                                  const std::size_t num_parents,
+                                  const std::size_t digest_len_bytes)
+{
+    blake2b_two_to_one_hash_lanes<avx2_u64x4>(children, parents, num_parents, digest_len_bytes);
+}
+
+} // namespace libiop
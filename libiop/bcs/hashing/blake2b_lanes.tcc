@@ -0,0 +1,245 @@
+/**@file
+ *****************************************************************************
+ Multi-lane BLAKE2b for blake2b_two_to_one_hash_batch, shared by the
+ translation units that compile it for each instruction set. Each SIMD lane
+ holds the state of a different message, so one pass of the compression
+ function hashes as many messages as there are 64-bit lanes.
+
+ Only single block messages (at most 128 bytes, unkeyed) are supported, which
+ covers every two-to-one hash of two digests. The result is byte for byte the
+ one crypto_generichash_blake2b gives. Everything here has internal linkage,
+ so that code built with wider ISA flags never leaks into the others.
+ *****************************************************************************
+ * @author     This file is part of libiop (see AUTHORS)
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <immintrin.h>
+
+#include "libiop/bcs/hashing/blake2b.hpp"
+
+namespace libiop {
+namespace {
+
+const std::uint64_t blake2b_IV[8] = {
+    0x6a09e667f3bcc908ull, 0xbb67ae8584caa73bull, 0x3c6ef372fe94f82bull, 0xa54ff53a5f1d36f1ull,
+    0x510e527fade682d1ull, 0x9b05688c2b3e6c1full, 0x1f83d9abfb41bd6bull, 0x5be0cd19137e2179ull
+};
+
+const std::uint8_t blake2b_sigma[12][16] = {
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+    { 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 },
+    { 11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4 },
+    {  7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8 },
+    {  9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13 },
+    {  2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9 },
+    { 12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11 },
+    { 13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10 },
+    {  6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5 },
+    { 10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13,  0 },
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+    { 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 },
+};
+
+const std::size_t blake2b_block_bytes = 128;
+
+#ifdef __AVX2__
+/** 4 lanes of 64 bits */
+struct avx2_u64x4 {
+    typedef __m256i vec;
+    static const std::size_t num_lanes = 4;
+
+    static inline vec load(const std::uint64_t *p) { return _mm256_load_si256((const __m256i*) p); }
+    static inline void store(std::uint64_t *p, const vec x) { _mm256_store_si256((__m256i*) p, x); }
+    static inline vec set1(const std::uint64_t x) { return _mm256_set1_epi64x((long long) x); }
+    static inline vec add(const vec x, const vec y) { return _mm256_add_epi64(x, y); }
+    static inline vec bxor(const vec x, const vec y) { return _mm256_xor_si256(x, y); }
+
+    template<int n>
+    static inline vec rotr(const vec x)
+    {
+        return _mm256_or_si256(_mm256_srli_epi64(x, n), _mm256_slli_epi64(x, 64 - n));
+    }
+};
+
+/* Rotations by whole bytes are a single shuffle */
+template<> inline __m256i avx2_u64x4::rotr<32>(const __m256i x)
+{
+    return _mm256_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1));
+}
+
+template<> inline __m256i avx2_u64x4::rotr<24>(const __m256i x)
+{
+    const __m256i r24 = _mm256_setr_epi8(3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10,
+                                         3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10);
+    return _mm256_shuffle_epi8(x, r24);
+}
+
+template<> inline __m256i avx2_u64x4::rotr<16>(const __m256i x)
+{
+    const __m256i r16 = _mm256_setr_epi8(2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9,
+                                         2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9);
+    return _mm256_shuffle_epi8(x, r16);
+}
+
+template<> inline __m256i avx2_u64x4::rotr<63>(const __m256i x)
+{
+    return _mm256_or_si256(_mm256_srli_epi64(x, 63), _mm256_add_epi64(x, x));
+}
+#endif
+
+#ifdef __AVX512F__
+/** 8 lanes of 64 bits */
+struct avx512_u64x8 {
+    typedef __m512i vec;
+    static const std::size_t num_lanes = 8;
+
+    static inline vec load(const std::uint64_t *p) { return _mm512_load_si512((const void*) p); }
+    static inline void store(std::uint64_t *p, const vec x) { _mm512_store_si512((void*) p, x); }
+    static inline vec set1(const std::uint64_t x) { return _mm512_set1_epi64((long long) x); }
+    static inline vec add(const vec x, const vec y) { return _mm512_add_epi64(x, y); }
+    static inline vec bxor(const vec x, const vec y) { return _mm512_xor_si512(x, y); }
+
+    /* The maskz form with a full mask, since GCC 12 warns about the undefined source the plain one uses */
+    template<int n>
+    static inline vec rotr(const vec x) { return _mm512_maskz_ror_epi64(0xFF, x, n); }
+};
+#endif
+
+template<typename V>
+inline void blake2b_G(typename V::vec &a, typename V::vec &b, typename V::vec &c, typename V::vec &d,
+                      const typename V::vec x, const typename V::vec y)
+{
+    a = V::add(V::add(a, b), x);
+    d = V::template rotr<32>(V::bxor(d, a));
+    c = V::add(c, d);
+    b = V::template rotr<24>(V::bxor(b, c));
+    a = V::add(V::add(a, b), y);
+    d = V::template rotr<16>(V::bxor(d, a));
+    c = V::add(c, d);
+    b = V::template rotr<63>(V::bxor(b, c));
+}
+
+/** Hashes messages[l] (of lengths[l] <= 128 bytes) into outs[l] (digest_len_bytes long), for l < num_active.
+ *  Unused lanes hash an empty message, and are discarded. */
+template<typename V>
+void blake2b_single_block_lanes(const unsigned char *const *messages,
+                                const std::size_t *lengths,
+                                unsigned char *const *outs,
+                                const std::size_t num_active,
+                                const std::size_t digest_len_bytes)
+{
+    const std::size_t L = V::num_lanes;
+
+    /* Transposed so that word w of every message is one vector */
+    alignas(64) std::uint64_t words[16][L];
+    alignas(64) std::uint64_t counters[L];
+    std::memset(words, 0, sizeof(words));
+    std::memset(counters, 0, sizeof(counters));
+    for (std::size_t l = 0; l < num_active; ++l)
+    {
+        unsigned char block[blake2b_block_bytes] = {0};
+        std::memcpy(block, messages[l], lengths[l]);
+        for (std::size_t w = 0; w < 16; ++w)
+        {
+            std::memcpy(&words[w][l], block + 8*w, 8);
+        }
+        counters[l] = lengths[l];
+    }
+
+    typename V::vec m[16];
+    for (std::size_t w = 0; w < 16; ++w)
+    {
+        m[w] = V::load(words[w]);
+    }
+
+    /* Parameter block: digest length, no key, fanout 1, depth 1 */
+    typename V::vec h[8];
+    h[0] = V::set1(blake2b_IV[0] ^ 0x01010000ull ^ digest_len_bytes);
+    for (std::size_t k = 1; k < 8; ++k)
+    {
+        h[k] = V::set1(blake2b_IV[k]);
+    }
+
+    typename V::vec v[16];
+    for (std::size_t k = 0; k < 8; ++k)
+    {
+        v[k] = h[k];
+    }
+    v[8] = V::set1(blake2b_IV[0]);
+    v[9] = V::set1(blake2b_IV[1]);
+    v[10] = V::set1(blake2b_IV[2]);
+    v[11] = V::set1(blake2b_IV[3]);
+    v[12] = V::bxor(V::set1(blake2b_IV[4]), V::load(counters));
+    v[13] = V::set1(blake2b_IV[5]);
+    v[14] = V::set1(~blake2b_IV[6]); /* this is the last block */
+    v[15] = V::set1(blake2b_IV[7]);
+
+    for (std::size_t r = 0; r < 12; ++r)
+    {
+        const std::uint8_t *s = blake2b_sigma[r];
+        blake2b_G<V>(v[0], v[4], v[8],  v[12], m[s[0]],  m[s[1]]);
+        blake2b_G<V>(v[1], v[5], v[9],  v[13], m[s[2]],  m[s[3]]);
+        blake2b_G<V>(v[2], v[6], v[10], v[14], m[s[4]],  m[s[5]]);
+        blake2b_G<V>(v[3], v[7], v[11], v[15], m[s[6]],  m[s[7]]);
+        blake2b_G<V>(v[0], v[5], v[10], v[15], m[s[8]],  m[s[9]]);
+        blake2b_G<V>(v[1], v[6], v[11], v[12], m[s[10]], m[s[11]]);
+        blake2b_G<V>(v[2], v[7], v[8],  v[13], m[s[12]], m[s[13]]);
+        blake2b_G<V>(v[3], v[4], v[9],  v[14], m[s[14]], m[s[15]]);
+    }
+
+    alignas(64) std::uint64_t state[8][L];
+    for (std::size_t k = 0; k < 8; ++k)
+    {
+        V::store(state[k], V::bxor(h[k], V::bxor(v[k], v[k+8])));
+    }
+    for (std::size_t l = 0; l < num_active; ++l)
+    {
+        unsigned char digest[64];
+        for (std::size_t k = 0; k < 8; ++k)
+        {
+            std::memcpy(digest + 8*k, &state[k][l], 8);
+        }
+        std::memcpy(outs[l], digest, digest_len_bytes);
+    }
+}
+
+/** parents[i] = BLAKE2b(children[2i] || children[2i+1]), V::num_lanes parents per pass.
+ *  Two digests always fit in one block. The caller checks that 0 < digest_len_bytes <= 64. */
+template<typename V>
+void blake2b_two_to_one_hash_lanes(const binary_hash_digest *children,
+                                   binary_hash_digest *parents,
+                                   const std::size_t num_parents,
+                                   const std::size_t digest_len_bytes)
+{
+    const std::size_t L = V::num_lanes;
+    unsigned char messages[L][blake2b_block_bytes];
+    const unsigned char *message_ptrs[L];
+    std::size_t lengths[L];
+    unsigned char *out_ptrs[L];
+
+    for (std::size_t begin = 0; begin < num_parents; begin += L)
+    {
+        const std::size_t num_active = std::min(L, num_parents - begin);
+        for (std::size_t l = 0; l < num_active; ++l)
+        {
+            const binary_hash_digest &left = children[2*(begin + l)];
+            const binary_hash_digest &right = children[2*(begin + l) + 1];
+            std::memcpy(messages[l], left.data(), left.size());
+            std::memcpy(messages[l] + left.size(), right.data(), right.size());
+            message_ptrs[l] = messages[l];
+            lengths[l] = left.size() + right.size();
+
+            parents[begin + l].resize(digest_len_bytes);
+            out_ptrs[l] = parents[begin + l].data();
+        }
+        blake2b_single_block_lanes<V>(message_ptrs, lengths, out_ptrs, num_active, digest_len_bytes);
+    }
+}
+
+} // namespace
+} // namespace libiop
@@ -0,0 +1,395 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <libff/common/utils.hpp>
+#include "libiop/bcs/hashing/blake3.hpp"
+#include "libiop/bcs/hashing/blake3_lanes.tcc"
+
+namespace libiop {
+
+/* Domain separation flags, see section 2.1 of the BLAKE3 specification */
+const std::uint8_t blake3_chunk_start = 1 << 0;
+const std::uint8_t blake3_chunk_end = 1 << 1;
+const std::uint8_t blake3_parent = 1 << 2;
+const std::uint8_t blake3_root = 1 << 3;
+const std::uint8_t blake3_keyed_hash = 1 << 4;
+
+#ifdef LIBIOP_HAVE_AVX2_BLAKE3
+/* defined in blake3_avx2.cpp, which is compiled with AVX2 enabled */
+void blake3_hash_many_avx2(const unsigned char *const *inputs,
+                           const std::size_t num_inputs,
+                           const std::size_t num_blocks,
+                           const std::size_t last_block_len,
+                           const std::uint32_t key[8],
+                           const std::uint64_t counter,
+                           const bool increment_counter,
+                           const std::uint8_t flags,
+                           const std::uint8_t flags_start,
+                           const std::uint8_t flags_end,
+                           unsigned char *out);
+#endif
+
+#ifdef LIBIOP_HAVE_AVX512_BLAKE3
+/* defined in blake3_avx512.cpp, which is compiled with AVX-512 enabled */
+void blake3_hash_many_avx512(const unsigned char *const *inputs,
+                             const std::size_t num_inputs,
+                             const std::size_t num_blocks,
+                             const std::size_t last_block_len,
+                             const std::uint32_t key[8],
+                             const std::uint64_t counter,
+                             const bool increment_counter,
+                             const std::uint8_t flags,
+                             const std::uint8_t flags_start,
+                             const std::uint8_t flags_end,
+                             unsigned char *out);
+#endif
+
+static bool cpu_supports(const blake3_batch_isa isa)
+{
+    switch (isa)
+    {
+#ifdef LIBIOP_HAVE_AVX2_BLAKE3
+        case avx2_blake3_batch:
+            return __builtin_cpu_supports("avx2");
+#endif
+#ifdef LIBIOP_HAVE_AVX512_BLAKE3
+        case avx512_blake3_batch:
+            return __builtin_cpu_supports("avx512f");
+#endif
+        default:
+            return false;
+    }
+}
+
+blake3_batch_isa best_blake3_batch_isa()
+{
+    static const blake3_batch_isa best = []() {
+        for (int isa = avx512_blake3_batch; isa > scalar_blake3_batch; --isa)
+        {
+            if (cpu_supports((blake3_batch_isa) isa))
+            {
+                return (blake3_batch_isa) isa;
+            }
+        }
+        return scalar_blake3_batch;
+    }();
+    return best;
+}
+
+/* See blake3_hash_many_lanes. A single input is always hashed with the portable code. */
+static void blake3_hash_many(const unsigned char *const *inputs,
+                             const std::size_t num_inputs,
+                             const std::size_t num_blocks,
+                             const std::size_t last_block_len,
+                             const std::uint32_t key[8],
+                             const std::uint64_t counter,
+                             const bool increment_counter,
+                             const std::uint8_t flags,
+                             const std::uint8_t flags_start,
+                             const std::uint8_t flags_end,
+                             unsigned char *out,
+                             const blake3_batch_isa isa)
+{
+    int best = (num_inputs > 1) ? isa : scalar_blake3_batch;
+    while (best > scalar_blake3_batch && !cpu_supports((blake3_batch_isa) best))
+    {
+        --best;
+    }
+
+    switch (best)
+    {
+#ifdef LIBIOP_HAVE_AVX512_BLAKE3
+        case avx512_blake3_batch:
+            blake3_hash_many_avx512(inputs, num_inputs, num_blocks, last_block_len, key,
+                                    counter, increment_counter, flags, flags_start, flags_end, out);
+            return;
+#endif
+#ifdef LIBIOP_HAVE_AVX2_BLAKE3
+        case avx2_blake3_batch:
+            blake3_hash_many_avx2(inputs, num_inputs, num_blocks, last_block_len, key,
+                                  counter, increment_counter, flags, flags_start, flags_end, out);
+            return;
+#endif
+        default:
+            blake3_hash_many_lanes<scalar_u32x1>(inputs, num_inputs, num_blocks, last_block_len, key,
+                                                 counter, increment_counter, flags, flags_start, flags_end, out);
+    }
+}
+
+/** The last compression of the hash, whose output (with the root flag) is the extendable output */
+struct blake3_output_node {
+    std::uint32_t cv[8];
+    unsigned char block[blake3_block_bytes];
+    std::size_t block_len;
+    std::uint8_t flags;
+};
+
+/** The 64 byte output of compressing the root node with block counter output_block */
+static void blake3_root_output_block(const blake3_output_node &node,
+                                     const std::uint64_t output_block,
+                                     unsigned char out[blake3_block_bytes])
+{
+    std::uint32_t m[16];
+    std::memcpy(m, node.block, blake3_block_bytes);
+
+    std::uint32_t v[16];
+    std::memcpy(v, node.cv, sizeof(node.cv));
+    std::memcpy(v + 8, blake3_IV, 4 * sizeof(std::uint32_t));
+    v[12] = (std::uint32_t) output_block;
+    v[13] = (std::uint32_t) (output_block >> 32);
+    v[14] = (std::uint32_t) node.block_len;
+    v[15] = node.flags | blake3_root;
+
+    blake3_rounds<scalar_u32x1>(v, m);
+
+    std::uint32_t words[16];
+    for (std::size_t k = 0; k < 8; ++k)
+    {
+        words[k] = v[k] ^ v[k+8];
+        words[k+8] = v[k+8] ^ node.cv[k];
+    }
+    std::memcpy(out, words, blake3_block_bytes);
+}
+
+void blake3_hash(const unsigned char *input,
+                 const std::size_t input_len,
+                 unsigned char *out,
+                 const std::size_t out_len,
+                 const unsigned char *key,
+                 const std::uint64_t output_offset)
+{
+    std::uint32_t key_words[8];
+    std::uint8_t flags = 0;
+    if (key != nullptr)
+    {
+        std::memcpy(key_words, key, blake3_key_bytes);
+        flags = blake3_keyed_hash;
+    }
+    else
+    {
+        std::memcpy(key_words, blake3_IV, sizeof(key_words));
+    }
+
+    const std::size_t num_chunks = std::max<std::size_t>(1, (input_len + blake3_chunk_bytes - 1) / blake3_chunk_bytes);
+    blake3_output_node root;
+    if (num_chunks == 1)
+    {
+        /* The only chunk is the root: every block but the last is compressed here */
+        const std::size_t num_blocks = std::max<std::size_t>(1, (input_len + blake3_block_bytes - 1) / blake3_block_bytes);
+        const std::size_t last_block_len = input_len - (num_blocks - 1) * blake3_block_bytes;
+        if (num_blocks > 1)
+        {
+            unsigned char cv[32];
+            blake3_hash_many(&input, 1, num_blocks - 1, blake3_block_bytes, key_words, 0, false,
+                             flags, blake3_chunk_start, 0, cv, scalar_blake3_batch);
+            std::memcpy(root.cv, cv, sizeof(root.cv));
+        }
+        else
+        {
+            std::memcpy(root.cv, key_words, sizeof(root.cv));
+        }
+        std::memset(root.block, 0, sizeof(root.block));
+        if (last_block_len > 0)
+        {
+            std::memcpy(root.block, input + (num_blocks - 1) * blake3_block_bytes, last_block_len);
+        }
+        root.block_len = last_block_len;
+        root.flags = flags | blake3_chunk_end | (num_blocks == 1 ? blake3_chunk_start : 0);
+    }
+    else
+    {
+        /* Chaining values of every chunk, the full ones several at a time */
+        std::vector<unsigned char> cvs(32 * num_chunks);
+        const std::size_t last_chunk_len = input_len - (num_chunks - 1) * blake3_chunk_bytes;
+        const std::size_t num_full_chunks = (last_chunk_len == blake3_chunk_bytes) ? num_chunks : num_chunks - 1;
+        std::vector<const unsigned char*> inputs(num_full_chunks);
+        for (std::size_t i = 0; i < num_full_chunks; ++i)
+        {
+            inputs[i] = input + i * blake3_chunk_bytes;
+        }
+        blake3_hash_many(inputs.data(), num_full_chunks, blake3_chunk_bytes / blake3_block_bytes, blake3_block_bytes,
+                         key_words, 0, true, flags, blake3_chunk_start, blake3_chunk_end, cvs.data(),
+                         best_blake3_batch_isa());
+        if (num_full_chunks < num_chunks)
+        {
+            const unsigned char *last_chunk = input + num_full_chunks * blake3_chunk_bytes;
+            const std::size_t num_blocks = (last_chunk_len + blake3_block_bytes - 1) / blake3_block_bytes;
+            blake3_hash_many(&last_chunk, 1, num_blocks, last_chunk_len - (num_blocks - 1) * blake3_block_bytes,
+                             key_words, num_full_chunks, false, flags, blake3_chunk_start, blake3_chunk_end,
+                             cvs.data() + 32 * num_full_chunks, scalar_blake3_batch);
+        }
+
+        /* Each layer hashes adjacent pairs of chaining values, and carries an odd one out up unchanged.
+           This gives BLAKE3's tree, in which every left subtree is complete. */
+        std::vector<unsigned char> parent_cvs(32 * (num_chunks / 2 + 1));
+        std::size_t num_cvs = num_chunks;
+        while (num_cvs > 2)
+        {
+            const std::size_t num_parents = num_cvs / 2;
+            inputs.resize(num_parents);
+            for (std::size_t i = 0; i < num_parents; ++i)
+            {
+                inputs[i] = cvs.data() + 64 * i;
+            }
+            blake3_hash_many(inputs.data(), num_parents, 1, blake3_block_bytes, key_words, 0, false,
+                             flags | blake3_parent, 0, 0, parent_cvs.data(), best_blake3_batch_isa());
+            if (num_cvs % 2 == 1)
+            {
+                std::memcpy(parent_cvs.data() + 32 * num_parents, cvs.data() + 32 * (num_cvs - 1), 32);
+            }
+            num_cvs = num_parents + num_cvs % 2;
+            std::swap(cvs, parent_cvs);
+        }
+
+        std::memcpy(root.cv, key_words, sizeof(root.cv));
+        std::memcpy(root.block, cvs.data(), blake3_block_bytes);
+        root.block_len = blake3_block_bytes;
+        root.flags = flags | blake3_parent;
+    }
+
+    std::uint64_t output_block = output_offset / blake3_block_bytes;
+    std::size_t skip = output_offset % blake3_block_bytes;
+    std::size_t written = 0;
+    while (written < out_len)
+    {
+        unsigned char block_out[blake3_block_bytes];
+        blake3_root_output_block(root, output_block++, block_out);
+        const std::size_t num_bytes = std::min(blake3_block_bytes - skip, out_len - written);
+        std::memcpy(out + written, block_out + skip, num_bytes);
+        written += num_bytes;
+        skip = 0;
+    }
+}
+
+void blake3_hash_batch(const unsigned char *inputs,
+                       const std::size_t num_inputs,
+                       const std::size_t input_len,
+                       binary_hash_digest *digests,
+                       const std::size_t digest_len_bytes,
+                       const blake3_batch_isa isa)
+{
+    /* An input of at most one chunk is a tree of one chunk, whose chaining value (with the root flag)
+       is the first 32 bytes of its hash. Other inputs are hashed one at a time, through the tree mode. */
+    if (input_len == 0 || input_len > blake3_chunk_bytes || digest_len_bytes > 32)
+    {
+        for (std::size_t i = 0; i < num_inputs; ++i)
+        {
+            digests[i] = binary_hash_digest(digest_len_bytes);
+            blake3_hash(inputs + i * input_len, input_len, digests[i].data(), digest_len_bytes);
+        }
+        return;
+    }
+
+    const std::size_t batch_size = 64;
+    const unsigned char *input_ptrs[batch_size];
+    unsigned char outs[batch_size * 32];
+    const std::size_t num_blocks = (input_len + blake3_block_bytes - 1) / blake3_block_bytes;
+    for (std::size_t begin = 0; begin < num_inputs; begin += batch_size)
+    {
+        const std::size_t num_batched = std::min(batch_size, num_inputs - begin);
+        for (std::size_t j = 0; j < num_batched; ++j)
+        {
+            input_ptrs[j] = inputs + (begin + j) * input_len;
+        }
+        blake3_hash_many(input_ptrs, num_batched, num_blocks, input_len - (num_blocks - 1) * blake3_block_bytes,
+                         blake3_IV, 0, false, 0, blake3_chunk_start, blake3_chunk_end | blake3_root, outs, isa);
+        for (std::size_t j = 0; j < num_batched; ++j)
+        {
+            digests[begin + j] = binary_hash_digest(outs + 32*j, outs + 32*j + digest_len_bytes);
+        }
+    }
+}
+
+binary_hash_digest blake3_two_to_one_hash(const binary_hash_digest &first,
+                                          const binary_hash_digest &second,
+                                          const std::size_t digest_len_bytes)
+{
+    unsigned char first_plus_second[2 * binary_hash_digest::max_size];
+    std::memcpy(first_plus_second, first.data(), first.size());
+    std::memcpy(first_plus_second + first.size(), second.data(), second.size());
+
+    binary_hash_digest result(digest_len_bytes);
+    blake3_hash(first_plus_second, first.size() + second.size(), result.data(), digest_len_bytes);
+    return result;
+}
+
+void blake3_two_to_one_hash_batch(const binary_hash_digest *children,
+                                  binary_hash_digest *parents,
+                                  const std::size_t num_parents,
+                                  const std::size_t digest_len_bytes,
+                                  const blake3_batch_isa isa)
+{
+    /* A pair is at most two blocks, so it is a single chunk, whose chaining value
+       (with the root flag) is the first 32 bytes of the hash. Longer digests, and pairs whose
+       length differs from the first one of their batch, are hashed one at a time. */
+    const std::size_t batch_size = 64;
+    unsigned char messages[batch_size][2 * binary_hash_digest::max_size];
+    const unsigned char *message_ptrs[batch_size];
+    std::size_t batched_parents[batch_size];
+    unsigned char outs[batch_size * 32];
+
+    for (std::size_t begin = 0; begin < num_parents; begin += batch_size)
+    {
+        const std::size_t end = std::min(begin + batch_size, num_parents);
+        const std::size_t message_len = children[2*begin].size() + children[2*begin + 1].size();
+        std::size_t num_batched = 0;
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            const binary_hash_digest &left = children[2*i];
+            const binary_hash_digest &right = children[2*i + 1];
+            if (digest_len_bytes > 32 || message_len == 0 || left.size() + right.size() != message_len)
+            {
+                parents[i] = blake3_two_to_one_hash(left, right, digest_len_bytes);
+                continue;
+            }
+            std::memcpy(messages[num_batched], left.data(), left.size());
+            std::memcpy(messages[num_batched] + left.size(), right.data(), right.size());
+            message_ptrs[num_batched] = messages[num_batched];
+            batched_parents[num_batched] = i;
+            ++num_batched;
+        }
+
+        if (num_batched > 0)
+        {
+            const std::size_t num_blocks = (message_len + blake3_block_bytes - 1) / blake3_block_bytes;
+            blake3_hash_many(message_ptrs, num_batched, num_blocks, message_len - (num_blocks - 1) * blake3_block_bytes,
+                             blake3_IV, 0, false, 0, blake3_chunk_start, blake3_chunk_end | blake3_root, outs, isa);
+            for (std::size_t j = 0; j < num_batched; ++j)
+            {
+                parents[batched_parents[j]] = binary_hash_digest(outs + 32*j, outs + 32*j + digest_len_bytes);
+            }
+        }
+    }
+}
+
+bool is_blake3_two_to_one_hash(const two_to_one_hash_function<binary_hash_digest> &node_hasher)
+{
+    typedef binary_hash_digest (*hash_function_pointer)(const binary_hash_digest&,
+                                                         const binary_hash_digest&,
+                                                         const std::size_t);
+    const hash_function_pointer *target = node_hasher.target<hash_function_pointer>();
+    return (target != nullptr && *target == &blake3_two_to_one_hash);
+}
+
+std::size_t blake3_integer_randomness_extractor(const binary_hash_digest &root,
+                                                const std::size_t index,
+                                                const std::size_t upper_bound)
+{
+    /* Only required to make % below not biased, as for blake2b_integer_randomness_extractor */
+    if (!libff::is_power_of_2(upper_bound))
+    {
+        throw std::invalid_argument("upper_bound must be a power of two.");
+    }
+
+    unsigned char root_plus_index[binary_hash_digest::max_size + sizeof(index)];
+    std::memcpy(root_plus_index, root.data(), root.size());
+    std::memcpy(root_plus_index + root.size(), &index, sizeof(index));
+
+    std::size_t result;
+    blake3_hash(root_plus_index, root.size() + sizeof(index), (unsigned char*)&result, sizeof(result));
+    return result % upper_bound;
+}
+
+}
@@ -0,0 +1,141 @@
+/**@file
+ *****************************************************************************
+ BLAKE3 implementation of relevant hash functions.
+
+ BLAKE3 is implemented here rather than linked, so that it builds offline.
+ Long inputs are split into 1 KB chunks that are compressed several at a
+ time, one per SIMD lane. Merkle tree leaves and node pairs are short
+ inputs, and are compressed several at a time the same way.
+ *****************************************************************************
+ * @author     This file is part of libiop (see AUTHORS)
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+#ifndef LIBIOP_SNARK_COMMON_HASHING_BLAKE3_HPP_
+#define LIBIOP_SNARK_COMMON_HASHING_BLAKE3_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include <libff/algebra/field_utils/field_utils.hpp>
+#include "libiop/bcs/hashing/hashing.hpp"
+
+namespace libiop {
+
+const std::size_t blake3_block_bytes = 64;
+const std::size_t blake3_chunk_bytes = 1024;
+const std::size_t blake3_key_bytes = 32;
+
+/** Writes out_len bytes of BLAKE3(input) to out, starting output_offset bytes into the extendable output.
+ *  If key is not NULL, this is BLAKE3's keyed hash mode, with a blake3_key_bytes long key. */
+void blake3_hash(const unsigned char *input,
+                 const std::size_t input_len,
+                 unsigned char *out,
+                 const std::size_t out_len,
+                 const unsigned char *key = nullptr,
+                 const std::uint64_t output_offset = 0);
+
+/** blake3 hash-chain. */
+template<typename FieldT, typename MT_root_type>
+class blake3_hashchain : public hashchain<FieldT, MT_root_type>
+{
+    protected:
+        binary_hash_digest internal_state_;
+        const size_t security_parameter_;
+        size_t digest_len_bytes_;
+        size_t squeeze_index_ = 0;
+    public:
+        blake3_hashchain(size_t security_parameter);
+        void absorb(const MT_root_type new_input);
+        /* internally does absorb(hash(new_input)) */
+        void absorb(const std::vector<FieldT> &new_input);
+        std::vector<FieldT> squeeze(const size_t num_elements);
+        std::vector<size_t> squeeze_query_positions(
+            const size_t num_positions, const size_t range_of_positions);
+
+        MT_root_type squeeze_root_type();
+
+        /* Needed for C++ polymorphism */
+        std::shared_ptr<hashchain<FieldT, MT_root_type>> new_hashchain();
+    protected:
+        void absorb_hash_digest(const binary_hash_digest new_input);
+        void absorb_internal(const typename libff::enable_if<std::is_same<MT_root_type, binary_hash_digest>::value, MT_root_type>::type new_input);
+        void absorb_internal(const typename libff::enable_if<std::is_same<MT_root_type, FieldT>::value, MT_root_type>::type new_input);
+};
+
+template<typename FieldT>
+class blake3_leafhash : public leafhash<FieldT, binary_hash_digest>
+{
+    protected:
+    size_t digest_len_bytes_;
+    public:
+    blake3_leafhash(size_t security_parameter);
+    binary_hash_digest hash(const std::vector<FieldT> &leaf);
+    /* A single BLAKE3 call over the leaf followed by the salt */
+    binary_hash_digest zk_hash(const std::vector<FieldT> &leaf,
+        const zk_salt_type &zk_salt);
+    /* Through blake3_hash_batch, one leaf per SIMD lane */
+    void hash_batch(const FieldT *leaves,
+                    const std::size_t num_leaves,
+                    const std::size_t leaf_size,
+                    const zk_salt_type *zk_salts,
+                    binary_hash_digest *digests);
+};
+
+template<typename FieldT>
+binary_hash_digest blake3_field_element_hash(const std::vector<FieldT> &data,
+                                             const std::size_t digest_len_bytes);
+
+/** num_elements field elements, rejection sampled from the extendable output of BLAKE3(root || index) */
+template<typename FieldT>
+std::vector<FieldT> blake3_FieldT_randomness_extractor(const binary_hash_digest &root,
+                                                       const std::size_t index,
+                                                       const std::size_t num_elements);
+
+/* Returns a random integer of size less than upper_bound using input root, and key index */
+std::size_t blake3_integer_randomness_extractor(const binary_hash_digest &root,
+                                                const std::size_t index,
+                                                const std::size_t upper_bound);
+
+enum blake3_batch_isa {
+    scalar_blake3_batch = 0,
+    avx2_blake3_batch = 1,   /* 8 inputs per pass */
+    avx512_blake3_batch = 2  /* 16 inputs per pass */
+};
+
+/** The widest multi-lane BLAKE3 this build and CPU support. */
+blake3_batch_isa best_blake3_batch_isa();
+
+/** Sets digests[i] to the digest_len_bytes long BLAKE3 hash of the input_len bytes at inputs + i*input_len,
+ *  for i < num_inputs. Inputs of at most one chunk, with digests of at most 32 bytes, are compressed
+ *  several at a time, one per SIMD lane. */
+void blake3_hash_batch(const unsigned char *inputs,
+                       const std::size_t num_inputs,
+                       const std::size_t input_len,
+                       binary_hash_digest *digests,
+                       const std::size_t digest_len_bytes,
+                       const blake3_batch_isa isa = best_blake3_batch_isa());
+
+binary_hash_digest blake3_two_to_one_hash(const binary_hash_digest &first,
+                                          const binary_hash_digest &second,
+                                          const std::size_t digest_len_bytes);
+
+/** Sets parents[i] = blake3_two_to_one_hash(children[2i], children[2i+1], digest_len_bytes), for i < num_parents.
+ *  Pairs are compressed several at a time, one per SIMD lane, using the given instruction set
+ *  or the next best one the CPU supports. */
+void blake3_two_to_one_hash_batch(const binary_hash_digest *children,
+                                  binary_hash_digest *parents,
+                                  const std::size_t num_parents,
+                                  const std::size_t digest_len_bytes,
+                                  const blake3_batch_isa isa = best_blake3_batch_isa());
+
+/** Whether node_hasher is blake3_two_to_one_hash itself, so that callers can hash through
+ *  blake3_two_to_one_hash_batch instead. */
+bool is_blake3_two_to_one_hash(const two_to_one_hash_function<binary_hash_digest> &node_hasher);
+
+} // namespace libiop
+
+#include "libiop/bcs/hashing/blake3.tcc"
+
+#endif // LIBIOP_SNARK_COMMON_HASHING_BLAKE3_HPP_
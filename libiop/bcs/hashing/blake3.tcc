@@ -0,0 +1,251 @@
+#include <libff/algebra/field_utils/field_utils.hpp>
+#include "libiop/bcs/hashing/hashing.hpp"
+#include <cstring>
+#include <stdexcept>
+
+namespace libiop {
+
+template<typename FieldT, typename hash_data_type>
+blake3_hashchain<FieldT, hash_data_type>::blake3_hashchain(size_t security_parameter) :
+    security_parameter_(security_parameter)
+{
+    /* 2*security_parameter bits, rounded up to next byte */
+    this->digest_len_bytes_ = ((2*security_parameter) + 7) / 8;
+    this->internal_state_ = binary_hash_digest(this->digest_len_bytes_, ' ');
+}
+
+template<typename FieldT, typename hash_data_type>
+std::shared_ptr<hashchain<FieldT, hash_data_type>>
+    blake3_hashchain<FieldT, hash_data_type>::new_hashchain()
+{
+    return std::make_shared<blake3_hashchain<FieldT, hash_data_type>>
+        (this->security_parameter_);
+}
+
+template<typename FieldT, typename hash_data_type>
+void blake3_hashchain<FieldT, hash_data_type>::absorb(const hash_data_type new_input)
+{
+    this->absorb_internal(new_input);
+}
+
+template<typename FieldT, typename hash_data_type>
+void blake3_hashchain<FieldT, hash_data_type>::absorb_internal(
+    const typename libff::enable_if<std::is_same<hash_data_type, FieldT>::value, hash_data_type>::type new_input)
+{
+    std::vector<FieldT> vec_new_input;
+    vec_new_input.emplace_back(new_input);
+    this->absorb(vec_new_input);
+}
+
+template<typename FieldT, typename hash_data_type>
+void blake3_hashchain<FieldT, hash_data_type>::absorb_internal(
+    const typename libff::enable_if<std::is_same<hash_data_type, binary_hash_digest>::value, hash_data_type>::type new_input)
+{
+    this->absorb_hash_digest(new_input);
+}
+
+template<typename FieldT, typename hash_data_type>
+void blake3_hashchain<FieldT, hash_data_type>::absorb_hash_digest(
+    const binary_hash_digest new_input)
+{
+    unsigned char hash_input[2 * binary_hash_digest::max_size];
+    std::memcpy(hash_input, this->internal_state_.data(), this->internal_state_.size());
+    std::memcpy(hash_input + this->internal_state_.size(), new_input.data(), new_input.size());
+
+    blake3_hash(hash_input,
+                this->internal_state_.size() + new_input.size(),
+                this->internal_state_.data(),
+                this->digest_len_bytes_);
+}
+
+template<typename FieldT, typename hash_data_type>
+void blake3_hashchain<FieldT, hash_data_type>::absorb(const std::vector<FieldT> &new_input)
+{
+    const binary_hash_digest new_input_hash =
+        blake3_field_element_hash<FieldT>(new_input, this->digest_len_bytes_);
+    this->absorb_hash_digest(new_input_hash);
+}
+
+template<typename FieldT, typename hash_data_type>
+std::vector<FieldT> blake3_hashchain<FieldT, hash_data_type>::squeeze(
+    const size_t num_elements)
+{
+    this->squeeze_index_++;
+    return blake3_FieldT_randomness_extractor<FieldT>(
+        this->internal_state_,
+        this->squeeze_index_,
+        num_elements);
+}
+
+template<typename FieldT, typename hash_data_type>
+std::vector<size_t> blake3_hashchain<FieldT, hash_data_type>::squeeze_query_positions(
+        const size_t num_positions, const size_t range_of_positions)
+{
+    std::vector<size_t> query_pos;
+    for (size_t i = 0; i < num_positions; i++)
+    {
+        this->squeeze_index_++;
+        query_pos.emplace_back(
+            blake3_integer_randomness_extractor(
+                this->internal_state_,
+                this->squeeze_index_,
+                range_of_positions)
+        );
+    }
+    return query_pos;
+}
+
+template<typename FieldT, typename hash_data_type>
+hash_data_type blake3_hashchain<FieldT, hash_data_type>::squeeze_root_type()
+{
+    std::vector<FieldT> x = this->squeeze(1);
+    return blake3_field_element_hash<FieldT>(x, this->digest_len_bytes_);
+}
+
+
+template<typename FieldT>
+blake3_leafhash<FieldT>::blake3_leafhash(size_t security_parameter)
+{
+    /* 2*security_parameter bits, rounded up to next byte */
+    this->digest_len_bytes_ = ((2*security_parameter) + 7) / 8;
+}
+
+template<typename FieldT>
+binary_hash_digest blake3_leafhash<FieldT>::hash(const std::vector<FieldT> &leaf)
+{
+    return blake3_field_element_hash<FieldT>(leaf, this->digest_len_bytes_);
+}
+
+template<typename FieldT>
+binary_hash_digest blake3_leafhash<FieldT>::zk_hash(
+    const std::vector<FieldT> &leaf,
+    const zk_salt_type &zk_salt)
+{
+    const std::size_t leaf_bytes = sizeof(FieldT) * leaf.size();
+    std::vector<unsigned char> leaf_plus_salt(leaf_bytes + zk_salt.size());
+    if (leaf_bytes > 0)
+    {
+        std::memcpy(leaf_plus_salt.data(), &leaf[0], leaf_bytes);
+    }
+    std::memcpy(leaf_plus_salt.data() + leaf_bytes, zk_salt.data(), zk_salt.size());
+
+    binary_hash_digest result(this->digest_len_bytes_);
+    blake3_hash(leaf_plus_salt.data(), leaf_plus_salt.size(), result.data(), this->digest_len_bytes_);
+    return result;
+}
+
+template<typename FieldT>
+void blake3_leafhash<FieldT>::hash_batch(
+    const FieldT *leaves,
+    const std::size_t num_leaves,
+    const std::size_t leaf_size,
+    const zk_salt_type *zk_salts,
+    binary_hash_digest *digests)
+{
+    const std::size_t leaf_bytes = sizeof(FieldT) * leaf_size;
+    if (zk_salts == nullptr)
+    {
+        blake3_hash_batch((const unsigned char*) leaves, num_leaves, leaf_bytes, digests, this->digest_len_bytes_);
+        return;
+    }
+
+    /* Salts all have the same length, so each leaf and its salt are laid out as in zk_hash */
+    const std::size_t message_len = leaf_bytes + (num_leaves == 0 ? 0 : zk_salts[0].size());
+    std::vector<unsigned char> messages(num_leaves * message_len);
+    for (std::size_t i = 0; i < num_leaves; ++i)
+    {
+        if (leaf_bytes + zk_salts[i].size() != message_len)
+        {
+            throw std::invalid_argument("All zk salts of a batch must have the same length.");
+        }
+        std::memcpy(&messages[i * message_len], leaves + i * leaf_size, leaf_bytes);
+        std::memcpy(&messages[i * message_len + leaf_bytes], zk_salts[i].data(), zk_salts[i].size());
+    }
+    blake3_hash_batch(messages.data(), num_leaves, message_len, digests, this->digest_len_bytes_);
+}
+
+template<typename FieldT>
+binary_hash_digest blake3_field_element_hash(const std::vector<FieldT> &data,
+                                             const std::size_t digest_len_bytes)
+{
+    binary_hash_digest result(digest_len_bytes);
+    blake3_hash((data.empty() ? nullptr : (const unsigned char*)&data[0]),
+                sizeof(FieldT) * data.size(),
+                result.data(),
+                digest_len_bytes);
+    return result;
+}
+
+/* Sets el from sizeof(FieldT) bytes of extendable output, and returns whether they are accepted */
+template<typename FieldT>
+bool blake3_FieldT_rejection_sample(
+    typename libff::enable_if<libff::is_additive<FieldT>::value, FieldT>::type _,
+    const unsigned char *sample,
+    FieldT &el)
+{
+    /* No need for rejection sampling, since our binary fields are word-aligned */
+    std::memcpy(&el, sample, sizeof(el));
+    return true;
+}
+
+template<typename FieldT>
+bool blake3_FieldT_rejection_sample(
+    typename libff::enable_if<libff::is_multiplicative<FieldT>::value, FieldT>::type _,
+    const unsigned char *sample,
+    FieldT &el)
+{
+    const size_t bits_per_limb = 8 * sizeof(mp_limb_t);
+    const size_t num_limbs = sizeof(el.mont_repr) / sizeof(mp_limb_t);
+    std::memcpy(&el.mont_repr, sample, sizeof(el.mont_repr));
+
+    /* clear all bits higher than MSB of modulus */
+    size_t bitno = sizeof(el.mont_repr) * 8 - 1;
+    while (FieldT::mod.test_bit(bitno) == false)
+    {
+        const std::size_t part = bitno / bits_per_limb;
+        const std::size_t bit = bitno - (bits_per_limb*part);
+
+        el.mont_repr.data[part] &= ~(1ul<<bit);
+        bitno--;
+    }
+    /* el is valid if it is < modulus, otherwise the next sample is tried (rejection sampling) */
+    return (mpn_cmp(el.mont_repr.data, FieldT::mod.data, num_limbs) < 0);
+}
+
+template<typename FieldT>
+std::vector<FieldT> blake3_FieldT_randomness_extractor(const binary_hash_digest &root,
+                                                       const std::size_t index,
+                                                       const std::size_t num_elements)
+{
+    unsigned char root_plus_index[binary_hash_digest::max_size + sizeof(index)];
+    std::memcpy(root_plus_index, root.data(), root.size());
+    std::memcpy(root_plus_index + root.size(), &index, sizeof(index));
+
+    std::vector<FieldT> result;
+    result.reserve(num_elements);
+
+    /* Samples are read from the output stream in order, one batch per round of rejections */
+    std::vector<unsigned char> samples;
+    std::uint64_t output_offset = 0;
+    while (result.size() < num_elements)
+    {
+        const std::size_t num_samples = num_elements - result.size();
+        samples.resize(num_samples * sizeof(FieldT));
+        blake3_hash(root_plus_index, root.size() + sizeof(index),
+                    samples.data(), samples.size(), nullptr, output_offset);
+        output_offset += samples.size();
+
+        for (std::size_t i = 0; i < num_samples; ++i)
+        {
+            FieldT el;
+            if (blake3_FieldT_rejection_sample<FieldT>(FieldT::zero(), &samples[i * sizeof(FieldT)], el))
+            {
+                result.emplace_back(el);
+            }
+        }
+    }
+
+    return result;
+}
+
+}
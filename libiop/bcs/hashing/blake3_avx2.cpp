@@ -0,0 +1,23 @@
+/* Compiled with AVX2 enabled (see libiop/CMakeLists.txt). Only called after
+   blake3.cpp has checked that the CPU supports it. */
+#include "libiop/bcs/hashing/blake3_lanes.tcc"
+
+namespace libiop {
+
+void blake3_hash_many_avx2(const unsigned char *const *inputs,
+                           const std::size_t num_inputs,
+                           const std::size_t num_blocks,
+                           const std::size_t last_block_len,
+                           const std::uint32_t key[8],
+                           const std::uint64_t counter,
+                           const bool increment_counter,
+                           const std::uint8_t flags,
+                           const std::uint8_t flags_start,
+                           const std::uint8_t flags_end,
+                           unsigned char *out)
+{
+    blake3_hash_many_lanes<avx2_u32x8>(inputs, num_inputs, num_blocks, last_block_len, key,
+                                       counter, increment_counter, flags, flags_start, flags_end, out);
+}
+
+} // namespace libiop
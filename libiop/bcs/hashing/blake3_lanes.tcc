@@ -0,0 +1,247 @@
+/**@file
+ *****************************************************************************
+ Multi-lane BLAKE3 compression, shared by the translation units that compile
+ it for each instruction set. Each SIMD lane holds the state of a different
+ input, so one pass of the compression function advances as many inputs as
+ there are 32-bit lanes. The inputs are either the chunks of one long message
+ (BLAKE3's tree mode), or many short messages, such as Merkle tree node pairs.
+
+ Everything here has internal linkage, so that code built with wider ISA
+ flags never leaks into the others.
+ *****************************************************************************
+ * @author     This file is part of libiop (see AUTHORS)
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+#include "libiop/bcs/hashing/blake3.hpp"
+
+namespace libiop {
+namespace {
+
+const std::uint32_t blake3_IV[8] = {
+    0x6A09E667u, 0xBB67AE85u, 0x3C6EF372u, 0xA54FF53Au,
+    0x510E527Fu, 0x9B05688Cu, 0x1F83D9ABu, 0x5BE0CD19u
+};
+
+/* Message word order of each of the 7 rounds: the message permutation, applied r times */
+const std::uint8_t blake3_schedule[7][16] = {
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+    {  2,  6,  3, 10,  7,  0,  4, 13,  1, 11, 12,  5,  9, 14, 15,  8 },
+    {  3,  4, 10, 12, 13,  2,  7, 14,  6,  5,  9,  0, 11, 15,  8,  1 },
+    { 10,  7, 12,  9, 14,  3, 13, 15,  4,  0, 11,  2,  5,  8,  1,  6 },
+    { 12, 13,  9, 11, 15, 10, 14,  8,  7,  2,  5,  3,  0,  1,  6,  4 },
+    {  9, 14, 11,  5,  8, 12, 15,  1, 13,  3,  0, 10,  2,  6,  4,  7 },
+    { 11, 15,  5,  0,  1,  9,  8,  6, 14, 10,  2, 12,  3,  4,  7, 13 },
+};
+
+/** One lane, for the portable code */
+struct scalar_u32x1 {
+    typedef std::uint32_t vec;
+    static const std::size_t num_lanes = 1;
+
+    static inline vec load(const std::uint32_t *p) { return *p; }
+    static inline void store(std::uint32_t *p, const vec x) { *p = x; }
+    static inline vec set1(const std::uint32_t x) { return x; }
+    static inline vec add(const vec x, const vec y) { return x + y; }
+    static inline vec bxor(const vec x, const vec y) { return x ^ y; }
+
+    template<int n>
+    static inline vec rotr(const vec x) { return (x >> n) | (x << (32 - n)); }
+};
+
+#ifdef __AVX2__
+/** 8 lanes of 32 bits */
+struct avx2_u32x8 {
+    typedef __m256i vec;
+    static const std::size_t num_lanes = 8;
+
+    static inline vec load(const std::uint32_t *p) { return _mm256_load_si256((const __m256i*) p); }
+    static inline void store(std::uint32_t *p, const vec x) { _mm256_store_si256((__m256i*) p, x); }
+    static inline vec set1(const std::uint32_t x) { return _mm256_set1_epi32((int) x); }
+    static inline vec add(const vec x, const vec y) { return _mm256_add_epi32(x, y); }
+    static inline vec bxor(const vec x, const vec y) { return _mm256_xor_si256(x, y); }
+
+    template<int n>
+    static inline vec rotr(const vec x)
+    {
+        return _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n));
+    }
+};
+
+/* Rotations by whole bytes are a single shuffle */
+template<> inline __m256i avx2_u32x8::rotr<16>(const __m256i x)
+{
+    const __m256i r16 = _mm256_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13,
+                                         2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13);
+    return _mm256_shuffle_epi8(x, r16);
+}
+
+template<> inline __m256i avx2_u32x8::rotr<8>(const __m256i x)
+{
+    const __m256i r8 = _mm256_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12,
+                                        1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    return _mm256_shuffle_epi8(x, r8);
+}
+#endif
+
+#ifdef __AVX512F__
+/** 16 lanes of 32 bits */
+struct avx512_u32x16 {
+    typedef __m512i vec;
+    static const std::size_t num_lanes = 16;
+
+    static inline vec load(const std::uint32_t *p) { return _mm512_load_si512((const void*) p); }
+    static inline void store(std::uint32_t *p, const vec x) { _mm512_store_si512((void*) p, x); }
+    static inline vec set1(const std::uint32_t x) { return _mm512_set1_epi32((int) x); }
+    static inline vec add(const vec x, const vec y) { return _mm512_add_epi32(x, y); }
+    static inline vec bxor(const vec x, const vec y) { return _mm512_xor_si512(x, y); }
+
+    /* The maskz form with a full mask, since GCC 12 warns about the undefined source the plain one uses */
+    template<int n>
+    static inline vec rotr(const vec x) { return _mm512_maskz_ror_epi32(0xFFFF, x, n); }
+};
+#endif
+
+template<typename V>
+inline void blake3_G(typename V::vec &a, typename V::vec &b, typename V::vec &c, typename V::vec &d,
+                     const typename V::vec x, const typename V::vec y)
+{
+    a = V::add(V::add(a, b), x);
+    d = V::template rotr<16>(V::bxor(d, a));
+    c = V::add(c, d);
+    b = V::template rotr<12>(V::bxor(b, c));
+    a = V::add(V::add(a, b), y);
+    d = V::template rotr<8>(V::bxor(d, a));
+    c = V::add(c, d);
+    b = V::template rotr<7>(V::bxor(b, c));
+}
+
+/** The 7 rounds of the compression function, on a state v set up by the caller */
+template<typename V>
+inline void blake3_rounds(typename V::vec v[16], const typename V::vec m[16])
+{
+    for (std::size_t r = 0; r < 7; ++r)
+    {
+        const std::uint8_t *s = blake3_schedule[r];
+        blake3_G<V>(v[0], v[4], v[8],  v[12], m[s[0]],  m[s[1]]);
+        blake3_G<V>(v[1], v[5], v[9],  v[13], m[s[2]],  m[s[3]]);
+        blake3_G<V>(v[2], v[6], v[10], v[14], m[s[4]],  m[s[5]]);
+        blake3_G<V>(v[3], v[7], v[11], v[15], m[s[6]],  m[s[7]]);
+        blake3_G<V>(v[0], v[5], v[10], v[15], m[s[8]],  m[s[9]]);
+        blake3_G<V>(v[1], v[6], v[11], v[12], m[s[10]], m[s[11]]);
+        blake3_G<V>(v[2], v[7], v[8],  v[13], m[s[12]], m[s[13]]);
+        blake3_G<V>(v[3], v[4], v[9],  v[14], m[s[14]], m[s[15]]);
+    }
+}
+
+/** Hashes inputs[i] (num_blocks blocks, all full but the last, which is last_block_len bytes long)
+ *  into the 32 byte chaining value out + 32*i, for i < num_inputs, V::num_lanes inputs per pass.
+ *  Input i uses block counter counter + i if increment_counter is set, and counter otherwise.
+ *  Every block gets flags, the first one also flags_start, and the last one also flags_end. */
+template<typename V>
+void blake3_hash_many_lanes(const unsigned char *const *inputs,
+                            const std::size_t num_inputs,
+                            const std::size_t num_blocks,
+                            const std::size_t last_block_len,
+                            const std::uint32_t key[8],
+                            const std::uint64_t counter,
+                            const bool increment_counter,
+                            const std::uint8_t flags,
+                            const std::uint8_t flags_start,
+                            const std::uint8_t flags_end,
+                            unsigned char *out)
+{
+    const std::size_t L = V::num_lanes;
+
+    /* Transposed so that word w of every input is one vector */
+    alignas(64) std::uint32_t words[16][L];
+    alignas(64) std::uint32_t counters_low[L];
+    alignas(64) std::uint32_t counters_high[L];
+    alignas(64) std::uint32_t cv_words[8][L];
+
+    for (std::size_t begin = 0; begin < num_inputs; begin += L)
+    {
+        const std::size_t num_active = std::min(L, num_inputs - begin);
+        for (std::size_t l = 0; l < L; ++l)
+        {
+            const std::uint64_t t = counter + (increment_counter ? begin + l : 0);
+            counters_low[l] = (std::uint32_t) t;
+            counters_high[l] = (std::uint32_t) (t >> 32);
+        }
+
+        typename V::vec cv[8];
+        for (std::size_t k = 0; k < 8; ++k)
+        {
+            cv[k] = V::set1(key[k]);
+        }
+
+        for (std::size_t b = 0; b < num_blocks; ++b)
+        {
+            const bool last = (b + 1 == num_blocks);
+            const std::size_t block_len = last ? last_block_len : blake3_block_bytes;
+
+            /* Unused lanes hash zeros, and are discarded */
+            std::memset(words, 0, sizeof(words));
+            for (std::size_t l = 0; l < num_active; ++l)
+            {
+                unsigned char block[blake3_block_bytes] = {0};
+                std::memcpy(block, inputs[begin + l] + b * blake3_block_bytes, block_len);
+                for (std::size_t w = 0; w < 16; ++w)
+                {
+                    std::memcpy(&words[w][l], block + 4*w, 4);
+                }
+            }
+
+            typename V::vec m[16];
+            for (std::size_t w = 0; w < 16; ++w)
+            {
+                m[w] = V::load(words[w]);
+            }
+
+            const std::uint8_t block_flags = flags | (b == 0 ? flags_start : 0) | (last ? flags_end : 0);
+            typename V::vec v[16];
+            for (std::size_t k = 0; k < 8; ++k)
+            {
+                v[k] = cv[k];
+            }
+            v[8] = V::set1(blake3_IV[0]);
+            v[9] = V::set1(blake3_IV[1]);
+            v[10] = V::set1(blake3_IV[2]);
+            v[11] = V::set1(blake3_IV[3]);
+            v[12] = V::load(counters_low);
+            v[13] = V::load(counters_high);
+            v[14] = V::set1((std::uint32_t) block_len);
+            v[15] = V::set1(block_flags);
+
+            blake3_rounds<V>(v, m);
+
+            for (std::size_t k = 0; k < 8; ++k)
+            {
+                cv[k] = V::bxor(v[k], v[k+8]);
+            }
+        }
+
+        for (std::size_t k = 0; k < 8; ++k)
+        {
+            V::store(cv_words[k], cv[k]);
+        }
+        for (std::size_t l = 0; l < num_active; ++l)
+        {
+            for (std::size_t k = 0; k < 8; ++k)
+            {
+                std::memcpy(out + 32*(begin + l) + 4*k, &cv_words[k][l], 4);
+            }
+        }
+    }
+}
+
+} // namespace
+} // namespace libiop
@@ -39,7 +39,7 @@ template<typename FieldT, typename hash_data_type>
 void dummy_algebraic_hashchain<FieldT, hash_data_type>::absorb_internal(
     const typename libff::enable_if<std::is_same<hash_data_type, binary_hash_digest>::value, hash_data_type>::type new_input)
 {
-    std::stringstream ss(new_input);
+    std::stringstream ss(std::string(new_input.begin(), new_input.end()));
     int64_t x = 0;
     while(ss >> x)           // get an int64 value from string stream iss
     {
@@ -107,7 +107,7 @@ hash_data_type dummy_algebraic_hashchain<FieldT, hash_data_type>::squeeze_root_t
     std::stringstream ss;
     // TODO: Fix libff import issue here
     // ss << h;
-    binary_hash_digest s = ss.str();
+    binary_hash_digest s(ss.str());
     return s;
 }
 
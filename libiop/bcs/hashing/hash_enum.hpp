@@ -12,6 +12,7 @@
 #include "libiop/bcs/hashing/algebraic_sponge.hpp"
 #include "libiop/bcs/hashing/poseidon.hpp"
 #include "libiop/bcs/hashing/blake2b.hpp"
+#include "libiop/bcs/hashing/blake3.hpp"
 
 #include <memory>
 
@@ -22,10 +23,19 @@ enum bcs_hash_type {
     blake2b_type = 1,
     /* Poseidon with MDS matrices and round selection identical to Starkware's choices */
     starkware_poseidon_type = 2,
-    high_alpha_poseidon_type = 3
+    high_alpha_poseidon_type = 3,
+    blake3_type = 4,
+    /* blake2b, with leaves hashed together with their zk salt in a single call (blake2b_zk_leaf_hash_v2) */
+    blake2b_v2_type = 5
 };
 
-static const char* bcs_hash_type_names[] = {"", "blake2b", "poseidon with Starkware's parameterization", "poseidon with high alpha"};
+static const char* bcs_hash_type_names[] = {"", "blake2b", "poseidon with Starkware's parameterization", "poseidon with high alpha", "blake3", "blake2b v2"};
+
+/** Whether the hash works over field elements, rather than producing binary_hash_digests. */
+inline bool is_algebraic_hash_type(const bcs_hash_type hash_enum)
+{
+    return hash_enum == starkware_poseidon_type || hash_enum == high_alpha_poseidon_type;
+}
 
 template<typename FieldT, typename MT_root_type>
 std::shared_ptr<hashchain<FieldT, MT_root_type>> get_hashchain(bcs_hash_type hash_type, size_t security_parameter);
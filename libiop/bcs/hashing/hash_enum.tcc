@@ -2,6 +2,7 @@
 #include "libiop/bcs/hashing/algebraic_sponge.hpp"
 #include "libiop/bcs/hashing/poseidon.hpp"
 #include "libiop/bcs/hashing/blake2b.hpp"
+#include "libiop/bcs/hashing/blake3.hpp"
 
 #include <cstring>
 #include <sstream>
@@ -54,10 +55,14 @@ std::shared_ptr<hashchain<FieldT, MT_root_type>> get_hashchain_internal(
     const bcs_hash_type hash_enum,
     const size_t security_parameter)
 {
-    if (hash_enum == blake2b_type)
+    if (hash_enum == blake2b_type || hash_enum == blake2b_v2_type)
     {
         return std::make_shared<blake2b_hashchain<FieldT, MT_root_type>>(security_parameter);
     }
+    else if (hash_enum == blake3_type)
+    {
+        return std::make_shared<blake3_hashchain<FieldT, MT_root_type>>(security_parameter);
+    }
     throw std::invalid_argument("bcs_hash_type unknown");
 }
 
@@ -105,6 +110,14 @@ std::shared_ptr<leafhash<FieldT, leaf_hash_type>> get_leafhash_internal(
     {
         return std::make_shared<blake2b_leafhash<FieldT>>(security_parameter);
     }
+    else if (hash_enum == blake2b_v2_type)
+    {
+        return std::make_shared<blake2b_leafhash<FieldT>>(security_parameter, blake2b_zk_leaf_hash_v2);
+    }
+    else if (hash_enum == blake3_type)
+    {
+        return std::make_shared<blake3_leafhash<FieldT>>(security_parameter);
+    }
     throw std::invalid_argument("bcs_hash_type unknown");
 }
 
@@ -122,10 +135,14 @@ two_to_one_hash_function<hash_type> get_two_to_one_hash_internal(
     const bcs_hash_type hash_enum, 
     const size_t security_parameter)
 {
-    if (hash_enum == blake2b_type)
+    if (hash_enum == blake2b_type || hash_enum == blake2b_v2_type)
     {
         return blake2b_two_to_one_hash;
     }
+    else if (hash_enum == blake3_type)
+    {
+        return blake3_two_to_one_hash;
+    }
     throw std::invalid_argument("bcs_hash_type unknown");
 }
 
@@ -143,6 +160,11 @@ two_to_one_hash_function<FieldT> get_two_to_one_hash_internal(
             throw std::invalid_argument("Poseidon only supported for 128 bit soundness.");
         }
         poseidon_params<FieldT> params = get_poseidon_parameters<FieldT>(hash_enum);
+        /* Stateless, so Merkle trees can hash their layers with it in parallel batches */
+        if (make_poseidon_batch_permutation<FieldT>(params))
+        {
+            return poseidon_two_to_one_hash<FieldT>(params);
+        }
         /* security parameter is -1 b/c */
         std::shared_ptr<algebraic_sponge<FieldT>> permutation = std::make_shared<poseidon<FieldT>>(params);
         /* We explicitly place this on heap with no destructor,
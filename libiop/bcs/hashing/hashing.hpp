@@ -8,8 +8,12 @@
 #ifndef LIBIOP_SNARK_COMMON_HASHING_HASHING_HPP_
 #define LIBIOP_SNARK_COMMON_HASHING_HASHING_HPP_
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <functional>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -17,9 +21,81 @@
 
 namespace libiop {
 
-// TODO: Document that this is marginally memory inefficient
-typedef std::string binary_hash_digest;
-typedef std::string zk_salt_type;
+/** A binary hash digest of up to 64 bytes (the largest BLAKE2b output), stored inline.
+ *  Digests are trivially copyable, so a vector of them (e.g. the nodes of a Merkle tree)
+ *  is one flat buffer with no allocation per digest.
+ *  The length is set at runtime, as it depends on the security parameter. */
+class binary_hash_digest
+{
+public:
+    static const std::size_t max_size = 64;
+
+    binary_hash_digest() = default;
+    /* size bytes, all equal to fill */
+    explicit binary_hash_digest(const std::size_t size, const char fill = 0) :
+        size_((std::uint8_t) checked_size(size))
+    {
+        std::memset(this->bytes_, fill, size);
+    }
+    template<typename InputIt>
+    binary_hash_digest(InputIt first, InputIt last) :
+        size_((std::uint8_t) checked_size(std::distance(first, last)))
+    {
+        std::copy(first, last, this->bytes_);
+    }
+    /* Not explicit, so that raw byte strings can still be passed as digests */
+    binary_hash_digest(const std::string &bytes) :
+        binary_hash_digest(bytes.begin(), bytes.end()) {}
+
+    std::size_t size() const { return this->size_; }
+    std::size_t length() const { return this->size_; }
+    bool empty() const { return this->size_ == 0; }
+    /* Bytes exposed by growing are zero, as with std::vector */
+    void resize(const std::size_t size)
+    {
+        const std::size_t new_size = checked_size(size);
+        if (new_size > this->size_)
+        {
+            std::memset(this->bytes_ + this->size_, 0, new_size - this->size_);
+        }
+        this->size_ = (std::uint8_t) new_size;
+    }
+
+    unsigned char *data() { return this->bytes_; }
+    const unsigned char *data() const { return this->bytes_; }
+    unsigned char &operator[](const std::size_t i) { return this->bytes_[i]; }
+    const unsigned char &operator[](const std::size_t i) const { return this->bytes_[i]; }
+    const unsigned char *begin() const { return this->bytes_; }
+    const unsigned char *end() const { return this->bytes_ + this->size_; }
+
+    bool operator==(const binary_hash_digest &other) const
+    {
+        return this->size_ == other.size_ && std::memcmp(this->bytes_, other.bytes_, this->size_) == 0;
+    }
+    bool operator!=(const binary_hash_digest &other) const { return !(*this == other); }
+    bool operator<(const binary_hash_digest &other) const
+    {
+        return std::lexicographical_compare(this->begin(), this->end(), other.begin(), other.end());
+    }
+
+protected:
+    alignas(8) unsigned char bytes_[max_size] = {0};
+    std::uint8_t size_ = 0;
+
+    static std::size_t checked_size(const std::size_t size)
+    {
+        if (size > max_size)
+        {
+            throw std::invalid_argument("Binary hash digests are at most 64 bytes.");
+        }
+        return size;
+    }
+};
+
+static_assert(std::is_trivially_copyable<binary_hash_digest>::value,
+              "binary_hash_digest must be trivially copyable");
+
+typedef binary_hash_digest zk_salt_type;
 
 
 
@@ -39,16 +115,39 @@ class hashchain
     virtual std::shared_ptr<hashchain<FieldT, MT_root_type>> new_hashchain() = 0;
 };
 
-/* An abstract class for leaf hashes */
+/* An abstract class for leaf hashes.
+   Leaf hashes into binary_hash_digest must be safe to call from several threads at once,
+   as Merkle trees hash their leaves in parallel. */
 template<typename FieldT, typename leaf_hash_type>
 class leafhash
 {
     public:
     virtual leaf_hash_type hash(const std::vector<FieldT> &leaf) = 0;
+    /* Hashes the leaf together with its salt. Every leaf of a tree has the same length,
+       and so does every salt, so implementations may hash leaf || salt with no separator. */
     virtual leaf_hash_type zk_hash(const std::vector<FieldT> &leaf,
         const zk_salt_type &zk_salt) = 0;
+
+    /* Hashes num_leaves leaves of leaf_size elements each, stored one after another in leaves,
+       into digests. Leaf i is salted with zk_salts[i], unless zk_salts is NULL.
+       Hashes that can compress several leaves at once override this. */
+    virtual void hash_batch(const FieldT *leaves,
+                            const std::size_t num_leaves,
+                            const std::size_t leaf_size,
+                            const zk_salt_type *zk_salts,
+                            leaf_hash_type *digests)
+    {
+        std::vector<FieldT> leaf(leaf_size);
+        for (std::size_t i = 0; i < num_leaves; ++i)
+        {
+            std::copy(leaves + i * leaf_size, leaves + (i + 1) * leaf_size, leaf.begin());
+            digests[i] = (zk_salts == nullptr) ? this->hash(leaf) : this->zk_hash(leaf, zk_salts[i]);
+        }
+    }
 };
 
+/* Two-to-one hashes into binary_hash_digest must be thread safe too: Merkle tree layers and
+   the proof of work search call them from several threads at once. */
 template<typename hash_type>
 using two_to_one_hash_function = std::function<hash_type(const hash_type&, const hash_type&, const std::size_t)>;
 
@@ -8,6 +8,8 @@
 #ifndef LIBIOP_SNARK_COMMON_HASHING_POSEIDON_HPP_
 #define LIBIOP_SNARK_COMMON_HASHING_POSEIDON_HPP_
 
+#include <array>
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <string>
@@ -55,6 +57,55 @@ poseidon_params<FieldT> default_128_bit_altbn_poseidon_params();
 template<typename FieldT>
 poseidon_params<FieldT> high_alpha_128_bit_altbn_poseidon_params(const size_t state_size = 3);
 
+/** Number of states poseidon_permutation::permute_batch takes through each round together */
+const std::size_t poseidon_batch_lanes = 8;
+
+/** Largest state size make_poseidon_batch_permutation has an instantiation for */
+const std::size_t poseidon_max_state_size = 4;
+
+/** The Poseidon permutation, with the state size and S-box exponent fixed at compile time.
+ *  The state lives on the stack, and every loop over it has a constant trip count,
+ *  so that each round is unrolled.
+ *  It holds no state between calls, so one instance can be shared between threads. */
+template<typename FieldT, std::size_t StateSize, std::size_t Alpha>
+class poseidon_permutation
+{
+    static_assert(StateSize >= 2, "Poseidon needs a state of at least two elements");
+    static_assert(Alpha >= 3, "Poseidon needs an S-box exponent of at least 3");
+
+    protected:
+    typedef std::array<FieldT, StateSize> state_type;
+
+    std::size_t full_rounds_;
+    std::size_t partial_rounds_;
+    bool near_mds_;
+    std::vector<state_type> ark_;
+    std::array<state_type, StateSize> mds_;
+
+    static FieldT raise_to_alpha(const FieldT &x);
+    static void apply_near_mds_mix(state_type &state, std::integral_constant<std::size_t, 3>);
+    static void apply_near_mds_mix(state_type &state, std::integral_constant<std::size_t, 4>);
+    template<std::size_t N>
+    static void apply_near_mds_mix(state_type &state, std::integral_constant<std::size_t, N>);
+    template<bool NearMDS>
+    void apply_mix_layer(state_type &state) const;
+    template<bool NearMDS>
+    void permute_lanes(state_type *lanes, const std::size_t num_lanes) const;
+    public:
+    explicit poseidon_permutation(const poseidon_params<FieldT> &params);
+
+    /** Permutes the StateSize elements at state in place */
+    void permute(FieldT *state) const;
+    /** Permutes num_states independent states, stored one after the other,
+     *  poseidon_batch_lanes states at a time. */
+    void permute_batch(FieldT *states, const std::size_t num_states) const;
+};
+
+/** permute_batch of the poseidon_permutation instantiation matching params,
+ *  or an empty function when no instantiation matches its state size and alpha. */
+template<typename FieldT>
+std::function<void(FieldT*, std::size_t)> make_poseidon_batch_permutation(const poseidon_params<FieldT> &params);
+
 template<typename FieldT>
 class poseidon : public algebraic_sponge<FieldT>
 {
@@ -63,6 +114,8 @@ class poseidon : public algebraic_sponge<FieldT>
     const FieldT zero_singleton_;
     const FieldT a_;
     std::vector<FieldT> scratch_state_;
+    /* The specialized permutation for params_, if there is one */
+    std::function<void(FieldT*, std::size_t)> fixed_permutation_;
 
     /* Really should be generated at compile time */
     FieldT raise_to_alpha(const FieldT x) const;
@@ -86,6 +139,25 @@ class poseidon : public algebraic_sponge<FieldT>
     ~poseidon() = default;
 };
 
+/** The Poseidon two-to-one hash: the first element of the permutation of (left, right, 0, ..., 0).
+ *  This is the hash algebraic_two_to_one_hash computes with a poseidon sponge, but it needs
+ *  no sponge, so it can be called from several threads at once, and hash a whole Merkle tree
+ *  layer as one batch. Only parameters with a specialized permutation are supported. */
+template<typename FieldT>
+class poseidon_two_to_one_hash
+{
+    protected:
+    std::size_t state_size_;
+    std::function<void(FieldT*, std::size_t)> permute_batch_;
+
+    public:
+    explicit poseidon_two_to_one_hash(const poseidon_params<FieldT> &params);
+
+    FieldT operator()(const FieldT &left, const FieldT &right, const std::size_t digest_len_bytes) const;
+    /** Sets parents[i] to the hash of children[2i] and children[2i+1], for i < num_parents */
+    void hash_batch(const FieldT *children, FieldT *parents, const std::size_t num_parents) const;
+};
+
 } // namespace libiop
 
 #include "libiop/bcs/hashing/poseidon.tcc"
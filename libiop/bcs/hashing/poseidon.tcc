@@ -1,6 +1,7 @@
 #include <libff/algebra/field_utils/field_utils.hpp>
 #include "libiop/bcs/hashing/algebraic_sponge.hpp"
 #include <libff/common/profiling.hpp>
+#include <algorithm>
 #include <cstring>
 #include <sstream>
 #include <stdexcept>
@@ -133,13 +134,238 @@ void poseidon_params<FieldT>::print() const
     libff::print_indent(); printf("* Achieved security = %f\n", this->achieved_soundness());
 }
 
+/** x^Exponent by square and multiply, unrolled at compile time */
+template<typename FieldT, std::size_t Exponent>
+struct poseidon_sbox_power
+{
+    static FieldT apply(const FieldT &x)
+    {
+        const FieldT half = poseidon_sbox_power<FieldT, Exponent / 2>::apply(x);
+        return (Exponent % 2 == 1) ? half * half * x : half * half;
+    }
+};
+
+template<typename FieldT>
+struct poseidon_sbox_power<FieldT, 1>
+{
+    static FieldT apply(const FieldT &x)
+    {
+        return x;
+    }
+};
+
+template<typename FieldT, std::size_t StateSize, std::size_t Alpha>
+poseidon_permutation<FieldT, StateSize, Alpha>::poseidon_permutation(
+    const poseidon_params<FieldT> &params) :
+    full_rounds_(params.full_rounds_),
+    partial_rounds_(params.partial_rounds_),
+    /* As in poseidon::apply_mix_layer, the near-MDS matrices exist for state sizes 3 and 4 only */
+    near_mds_(params.supported_near_mds_ && (StateSize == 3 || StateSize == 4))
+{
+    if (params.state_size_ != StateSize || params.alpha_ != Alpha)
+    {
+        throw std::invalid_argument("Poseidon parameters do not match the permutation's state size and alpha");
+    }
+    if (params.ark_matrix_.size() != this->full_rounds_ + this->partial_rounds_)
+    {
+        throw std::invalid_argument("ark_matrix is of wrong dimension");
+    }
+
+    this->ark_.resize(params.ark_matrix_.size());
+    for (std::size_t round = 0; round < params.ark_matrix_.size(); ++round)
+    {
+        if (params.ark_matrix_[round].size() < StateSize)
+        {
+            throw std::invalid_argument("ark_matrix is of wrong dimension");
+        }
+        std::copy(params.ark_matrix_[round].begin(), params.ark_matrix_[round].begin() + StateSize,
+                  this->ark_[round].begin());
+    }
+
+    if (!this->near_mds_)
+    {
+        for (std::size_t row = 0; row < StateSize; ++row)
+        {
+            if (params.mds_matrix_[row].size() != StateSize)
+            {
+                throw std::invalid_argument("mds_matrix is of wrong dimension");
+            }
+            std::copy(params.mds_matrix_[row].begin(), params.mds_matrix_[row].end(), this->mds_[row].begin());
+        }
+    }
+}
+
+template<typename FieldT, std::size_t StateSize, std::size_t Alpha>
+FieldT poseidon_permutation<FieldT, StateSize, Alpha>::raise_to_alpha(const FieldT &x)
+{
+    return poseidon_sbox_power<FieldT, Alpha>::apply(x);
+}
+
+/* [[1, 0, 1],
+    [1, 1, 0],
+    [0, 1, 1]] */
+template<typename FieldT, std::size_t StateSize, std::size_t Alpha>
+void poseidon_permutation<FieldT, StateSize, Alpha>::apply_near_mds_mix(
+    state_type &state, std::integral_constant<std::size_t, 3>)
+{
+    const FieldT x_copy = state[0];
+    state[0] += state[2];
+    state[2] += state[1];
+    state[1] += x_copy;
+}
+
+/* [[0, 1, 1, 1],
+    [1, 0, 1, 1],
+    [1, 1, 0, 1],
+    [1, 1, 1, 0]] */
+template<typename FieldT, std::size_t StateSize, std::size_t Alpha>
+void poseidon_permutation<FieldT, StateSize, Alpha>::apply_near_mds_mix(
+    state_type &state, std::integral_constant<std::size_t, 4>)
+{
+    const FieldT complete_sum = (state[0] + state[1]) + (state[2] + state[3]);
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        state[i] = complete_sum - state[i];
+    }
+}
+
+/* Never called: the constructor only selects the near-MDS mix for state sizes 3 and 4 */
+template<typename FieldT, std::size_t StateSize, std::size_t Alpha>
+template<std::size_t N>
+void poseidon_permutation<FieldT, StateSize, Alpha>::apply_near_mds_mix(
+    state_type &state, std::integral_constant<std::size_t, N>)
+{
+}
+
+template<typename FieldT, std::size_t StateSize, std::size_t Alpha>
+template<bool NearMDS>
+void poseidon_permutation<FieldT, StateSize, Alpha>::apply_mix_layer(state_type &state) const
+{
+    if (NearMDS)
+    {
+        apply_near_mds_mix(state, std::integral_constant<std::size_t, StateSize>());
+        return;
+    }
+    state_type mixed;
+    for (std::size_t row = 0; row < StateSize; ++row)
+    {
+        mixed[row] = this->mds_[row][0] * state[0];
+        for (std::size_t col = 1; col < StateSize; ++col)
+        {
+            mixed[row] += this->mds_[row][col] * state[col];
+        }
+    }
+    state = mixed;
+}
+
+/** Each round goes over all lanes before the next one starts, so that the S-boxes of
+ *  independent states follow each other and can overlap. */
+template<typename FieldT, std::size_t StateSize, std::size_t Alpha>
+template<bool NearMDS>
+void poseidon_permutation<FieldT, StateSize, Alpha>::permute_lanes(
+    state_type *lanes, const std::size_t num_lanes) const
+{
+    const std::size_t half_full_rounds = this->full_rounds_ / 2;
+    const std::size_t num_rounds = this->full_rounds_ + this->partial_rounds_;
+    for (std::size_t round = 0; round < num_rounds; ++round)
+    {
+        const state_type &ark = this->ark_[round];
+        const bool full_round = (round < half_full_rounds || round >= half_full_rounds + this->partial_rounds_);
+        for (std::size_t l = 0; l < num_lanes; ++l)
+        {
+            state_type &state = lanes[l];
+            for (std::size_t i = 0; i < StateSize; ++i)
+            {
+                state[i] += ark[i];
+            }
+            if (full_round)
+            {
+                for (std::size_t i = 0; i < StateSize; ++i)
+                {
+                    state[i] = raise_to_alpha(state[i]);
+                }
+            }
+            else
+            {
+                state[StateSize - 1] = raise_to_alpha(state[StateSize - 1]);
+            }
+            this->template apply_mix_layer<NearMDS>(state);
+        }
+    }
+}
+
+template<typename FieldT, std::size_t StateSize, std::size_t Alpha>
+void poseidon_permutation<FieldT, StateSize, Alpha>::permute(FieldT *state) const
+{
+    this->permute_batch(state, 1);
+}
+
+template<typename FieldT, std::size_t StateSize, std::size_t Alpha>
+void poseidon_permutation<FieldT, StateSize, Alpha>::permute_batch(
+    FieldT *states, const std::size_t num_states) const
+{
+    state_type lanes[poseidon_batch_lanes];
+    for (std::size_t begin = 0; begin < num_states; begin += poseidon_batch_lanes)
+    {
+        const std::size_t num_lanes = std::min(poseidon_batch_lanes, num_states - begin);
+        for (std::size_t l = 0; l < num_lanes; ++l)
+        {
+            std::copy(states + (begin + l) * StateSize, states + (begin + l + 1) * StateSize, lanes[l].begin());
+        }
+        if (this->near_mds_)
+        {
+            this->template permute_lanes<true>(lanes, num_lanes);
+        }
+        else
+        {
+            this->template permute_lanes<false>(lanes, num_lanes);
+        }
+        for (std::size_t l = 0; l < num_lanes; ++l)
+        {
+            std::copy(lanes[l].begin(), lanes[l].end(), states + (begin + l) * StateSize);
+        }
+    }
+}
+
+template<typename FieldT, std::size_t StateSize, std::size_t Alpha>
+std::function<void(FieldT*, std::size_t)> make_poseidon_batch_permutation_for(
+    const poseidon_params<FieldT> &params)
+{
+    const std::shared_ptr<const poseidon_permutation<FieldT, StateSize, Alpha>> permutation =
+        std::make_shared<const poseidon_permutation<FieldT, StateSize, Alpha>>(params);
+    return [permutation](FieldT *states, const std::size_t num_states) {
+        permutation->permute_batch(states, num_states);
+    };
+}
+
+/* The state sizes and alphas of the parameterizations in this file */
+template<typename FieldT>
+std::function<void(FieldT*, std::size_t)> make_poseidon_batch_permutation(
+    const poseidon_params<FieldT> &params)
+{
+    if (params.state_size_ == 3 && params.alpha_ == 5)
+    {
+        return make_poseidon_batch_permutation_for<FieldT, 3, 5>(params);
+    }
+    else if (params.state_size_ == 3 && params.alpha_ == 17)
+    {
+        return make_poseidon_batch_permutation_for<FieldT, 3, 17>(params);
+    }
+    else if (params.state_size_ == 4 && params.alpha_ == 17)
+    {
+        return make_poseidon_batch_permutation_for<FieldT, 4, 17>(params);
+    }
+    return std::function<void(FieldT*, std::size_t)>();
+}
+
 template<typename FieldT>
 poseidon<FieldT>::poseidon(
     const poseidon_params<FieldT> params):
     algebraic_sponge<FieldT>(params.rate_, params.capacity_),
     params_(params),
     zero_singleton_(FieldT::zero()),
-    a_(params.mds_matrix_[1][1])
+    a_(params.mds_matrix_[1][1]),
+    fixed_permutation_(make_poseidon_batch_permutation<FieldT>(params))
 {   
     this->scratch_state_ = std::vector<FieldT>(params.state_size_, this->zero_singleton_);
 }
@@ -273,6 +499,12 @@ void poseidon<FieldT>::apply_partial_round(size_t round_id)
 template<typename FieldT>
 void poseidon<FieldT>::apply_permutation()
 {
+    if (this->fixed_permutation_)
+    {
+        this->fixed_permutation_(this->state_.data(), 1);
+        return;
+    }
+
     size_t round = 0;
     bool full_round = true;
     for (size_t i = 0; i < this->params_.full_rounds_ / 2; i++)
@@ -308,6 +540,53 @@ void poseidon<FieldT>::reset()
     this->currently_absorbing = false;
 }
 
+template<typename FieldT>
+poseidon_two_to_one_hash<FieldT>::poseidon_two_to_one_hash(const poseidon_params<FieldT> &params) :
+    state_size_(params.state_size_),
+    permute_batch_(make_poseidon_batch_permutation<FieldT>(params))
+{
+    if (!this->permute_batch_)
+    {
+        throw std::invalid_argument("No specialized Poseidon permutation for these parameters");
+    }
+    assert(this->state_size_ <= poseidon_max_state_size);
+}
+
+template<typename FieldT>
+FieldT poseidon_two_to_one_hash<FieldT>::operator()(
+    const FieldT &left, const FieldT &right, const std::size_t digest_len_bytes) const
+{
+    /* On the stack, so that hashing a single node does not allocate */
+    std::array<FieldT, poseidon_max_state_size> state;
+    state.fill(FieldT::zero());
+    state[0] = left;
+    state[1] = right;
+    this->permute_batch_(state.data(), 1);
+    return state[0];
+}
+
+template<typename FieldT>
+void poseidon_two_to_one_hash<FieldT>::hash_batch(
+    const FieldT *children, FieldT *parents, const std::size_t num_parents) const
+{
+    std::vector<FieldT> states(std::min(num_parents, poseidon_batch_lanes) * this->state_size_);
+    for (std::size_t begin = 0; begin < num_parents; begin += poseidon_batch_lanes)
+    {
+        const std::size_t num_states = std::min(poseidon_batch_lanes, num_parents - begin);
+        std::fill(states.begin(), states.end(), FieldT::zero());
+        for (std::size_t l = 0; l < num_states; ++l)
+        {
+            states[l * this->state_size_] = children[2 * (begin + l)];
+            states[l * this->state_size_ + 1] = children[2 * (begin + l) + 1];
+        }
+        this->permute_batch_(states.data(), num_states);
+        for (std::size_t l = 0; l < num_states; ++l)
+        {
+            parents[begin + l] = states[l * this->state_size_];
+        }
+    }
+}
+
 template<typename FieldT>
 poseidon_params<FieldT> default_128_bit_altbn_poseidon_params()
 {
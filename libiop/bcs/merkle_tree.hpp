@@ -55,9 +55,11 @@ protected:
     bool make_zk_;
     std::size_t num_zk_bytes_;
 
-    /* Each element will be hashed (individually) to produce a random hash digest. */
-    std::vector<zk_salt_type> zk_leaf_randomness_elements_;
+    /* Secret key of the stream cipher the zk salts are drawn from. Salts are not stored:
+       the salt of leaf i is regenerated from the keystream with nonce i when it is needed. */
+    std::vector<unsigned char> zk_salt_seed_;
     void sample_leaf_randomness();
+    void leaf_zk_salts(const std::size_t begin, const std::size_t num_salts, zk_salt_type *salts) const;
     void compute_inner_nodes();
 public:
     /* Create a merkle tree with the given configuration.
@@ -73,7 +75,7 @@ public:
 
     /** This treats each leaf as a column.
      * e.g. The ith leaf is the vector formed by leaf_contents[j][i] for all j */
-    void construct(const std::vector<std::shared_ptr<std::vector<FieldT>>> &leaf_contents);
+    void construct(const std::vector<std::shared_ptr<const std::vector<FieldT>>> &leaf_contents);
     // TODO: Remove this overload in favor of only using the former
     void construct(const std::vector<std::vector<FieldT> > &leaf_contents);
     /** Leaf contents is a table with `r` rows
@@ -86,7 +88,7 @@ public:
      *  as this will take a significant amount of memory.
      */
     void construct_with_leaves_serialized_by_cosets(
-        const std::vector<std::shared_ptr<std::vector<FieldT>>> &leaf_contents,
+        const std::vector<std::shared_ptr<const std::vector<FieldT>>> &leaf_contents,
         size_t coset_serialization_size);
 
     /** Takes in a set of query positions to input oracles to a domain of size:
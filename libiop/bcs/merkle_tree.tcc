@@ -3,12 +3,107 @@
 
 #include <libff/common/profiling.hpp>
 #include "libiop/common/cpp17_bits.hpp"
+#include "libiop/common/parallel.hpp"
+#include "libiop/bcs/hashing/blake2b.hpp"
+#include "libiop/bcs/hashing/blake3.hpp"
+#include "libiop/bcs/hashing/poseidon.hpp"
 #include <libff/common/utils.hpp>
 
+#include <sodium/crypto_stream_chacha20.h>
 #include <sodium/randombytes.h>
 
 namespace libiop {
 
+/** A hash costs far more than the per-element work parallel_min_size is tuned for,
+ *  so leaves and layers are split across threads from this many hashes on. */
+const std::size_t merkle_tree_parallel_min_hashes = 1ull << 6;
+
+/** Leaves are handed to the leaf hash this many at a time, which fills the widest SIMD
+ *  leaf hashes (16 lanes of BLAKE3 under AVX-512). */
+const std::size_t merkle_tree_leaf_batch_size = 16;
+
+/** Binary digests are hashed by stateless functions (blake2b, blake3), so leaves and layers can be
+ *  hashed concurrently. Algebraic hashes carry a sponge state, and are always hashed serially. */
+template<typename hash_digest_type>
+constexpr bool merkle_tree_hashes_in_parallel()
+{
+    return std::is_same<hash_digest_type, binary_hash_digest>::value;
+}
+
+/* Algebraic layer: poseidon_two_to_one_hash is stateless, so it hashes the layer in batches,
+   one chunk per thread. Other algebraic hashes go through a sponge, one hash at a time. */
+template<typename hash_digest_type>
+void hash_merkle_tree_layer(
+    const typename libff::enable_if<!std::is_same<hash_digest_type, binary_hash_digest>::value, hash_digest_type>::type *children,
+    hash_digest_type *parents,
+    const std::size_t num_parents,
+    const two_to_one_hash_function<hash_digest_type> &node_hasher,
+    const std::size_t digest_len_bytes)
+{
+    const poseidon_two_to_one_hash<hash_digest_type> *poseidon_hasher =
+        node_hasher.template target<poseidon_two_to_one_hash<hash_digest_type>>();
+    if (poseidon_hasher == nullptr)
+    {
+        for (std::size_t i = 0; i < num_parents; ++i)
+        {
+            parents[i] = node_hasher(children[2*i], children[2*i + 1], digest_len_bytes);
+        }
+        return;
+    }
+
+    const std::size_t num_chunks = (num_parents >= merkle_tree_parallel_min_hashes) ?
+        num_parallel_chunks(num_parents) : 1;
+#ifdef MULTICORE
+    #pragma omp parallel for if (num_chunks > 1)
+#endif
+    for (std::size_t c = 0; c < num_chunks; ++c)
+    {
+        const std::size_t begin = chunk_begin(c, num_chunks, num_parents);
+        const std::size_t end = chunk_begin(c + 1, num_chunks, num_parents);
+        poseidon_hasher->hash_batch(children + 2*begin, parents + begin, end - begin);
+    }
+}
+
+/* Binary layer: split into one chunk per thread. blake2b_two_to_one_hash and blake3_two_to_one_hash
+   are recognized, so that each chunk can go through the multi-lane BLAKE2b or BLAKE3. */
+template<typename hash_digest_type>
+void hash_merkle_tree_layer(
+    const typename libff::enable_if<std::is_same<hash_digest_type, binary_hash_digest>::value, hash_digest_type>::type *children,
+    hash_digest_type *parents,
+    const std::size_t num_parents,
+    const two_to_one_hash_function<hash_digest_type> &node_hasher,
+    const std::size_t digest_len_bytes)
+{
+    const bool is_blake2b = is_blake2b_two_to_one_hash(node_hasher);
+    const bool is_blake3 = is_blake3_two_to_one_hash(node_hasher);
+
+    const std::size_t num_chunks = (num_parents >= merkle_tree_parallel_min_hashes) ?
+        num_parallel_chunks(num_parents) : 1;
+#ifdef MULTICORE
+    #pragma omp parallel for if (num_chunks > 1)
+#endif
+    for (std::size_t c = 0; c < num_chunks; ++c)
+    {
+        const std::size_t begin = chunk_begin(c, num_chunks, num_parents);
+        const std::size_t end = chunk_begin(c + 1, num_chunks, num_parents);
+        if (is_blake2b)
+        {
+            blake2b_two_to_one_hash_batch(children + 2*begin, parents + begin, end - begin, digest_len_bytes);
+        }
+        else if (is_blake3)
+        {
+            blake3_two_to_one_hash_batch(children + 2*begin, parents + begin, end - begin, digest_len_bytes);
+        }
+        else
+        {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                parents[i] = node_hasher(children[2*i], children[2*i + 1], digest_len_bytes);
+            }
+        }
+    }
+}
+
 template<typename FieldT, typename hash_digest_type>
 merkle_tree<FieldT, hash_digest_type>::merkle_tree(
     const std::size_t num_leaves,
@@ -37,44 +132,38 @@ template<typename FieldT, typename hash_digest_type>
 void merkle_tree<FieldT, hash_digest_type>::sample_leaf_randomness()
 {
     libff::enter_block("BCS: Sample randomness");
-    assert(this->zk_leaf_randomness_elements_.size() == 0);
-    this->zk_leaf_randomness_elements_.reserve(this->num_leaves_);
-
-    /* This uses a batch size since the libsodium API makes no guarantee for the maximum supported
-    * vector size. */
-    const size_t num_rand_bytes = this->num_leaves_ * this->num_zk_bytes_;
-    const size_t rand_batch_size = 1ull << 20; /* 1 MB */
-    const size_t num_batches = num_rand_bytes / rand_batch_size;
-    const size_t leafs_per_batch = (num_batches == 0) ? 0 : this->num_leaves_ / num_batches;
-    for (size_t i = 0; i < num_batches; i++) {
-        std::vector<uint8_t> batch_randomness;
-        batch_randomness.resize(rand_batch_size);
-        randombytes_buf(&batch_randomness[0], rand_batch_size);
-        std::vector<uint8_t>::const_iterator first = batch_randomness.begin();
-        std::vector<uint8_t>::const_iterator last = batch_randomness.begin() + this->num_zk_bytes_;
-        for (size_t i = 0; i < leafs_per_batch; ++i) {
-            std::string rand_str(first, last);
-            this->zk_leaf_randomness_elements_.emplace_back(rand_str);
-            first += this->num_zk_bytes_;
-            last += this->num_zk_bytes_;
-        }
-    }
-    const size_t remaining_leaves = this->num_leaves_ - leafs_per_batch * num_batches;
-    for (size_t i = 0; i < remaining_leaves; ++i)
+    assert(this->zk_salt_seed_.size() == 0);
+    /* Only the seed comes from the OS RNG, the salts are expanded from it by leaf_zk_salts */
+    this->zk_salt_seed_.resize(crypto_stream_chacha20_ietf_KEYBYTES);
+    randombytes_buf(this->zk_salt_seed_.data(), this->zk_salt_seed_.size());
+    libff::leave_block("BCS: Sample randomness");
+}
+
+template<typename FieldT, typename hash_digest_type>
+void merkle_tree<FieldT, hash_digest_type>::leaf_zk_salts(
+    const std::size_t begin,
+    const std::size_t num_salts,
+    zk_salt_type *salts) const
+{
+    /* The salt of leaf i is the first num_zk_bytes_ bytes of the ChaCha20 keystream with nonce i.
+     * Salts are at most 64 bytes, so each one is a single ChaCha20 block. */
+    unsigned char nonce[crypto_stream_chacha20_ietf_NONCEBYTES] = {0};
+    for (std::size_t i = 0; i < num_salts; ++i)
     {
-        std::vector<uint8_t> rand_leaf;
-        rand_leaf.resize(this->num_zk_bytes_);
-        randombytes_buf(&rand_leaf[0], this->num_zk_bytes_);
-        std::string rand_str(rand_leaf.begin(), rand_leaf.end());
-        this->zk_leaf_randomness_elements_.push_back(rand_str);
+        const std::uint64_t leaf = begin + i;
+        for (std::size_t b = 0; b < sizeof(leaf); ++b)
+        {
+            nonce[b] = (unsigned char) (leaf >> (8 * b));
+        }
+        salts[i] = zk_salt_type(this->num_zk_bytes_);
+        crypto_stream_chacha20_ietf(salts[i].data(), this->num_zk_bytes_, nonce, this->zk_salt_seed_.data());
     }
-    libff::leave_block("BCS: Sample randomness");
 }
 
 template<typename FieldT, typename hash_digest_type>
 void merkle_tree<FieldT, hash_digest_type>::construct(const std::vector<std::vector<FieldT> > &leaf_contents)
 {
-    std::vector<std::shared_ptr<std::vector<FieldT>>> shared_leaves;
+    std::vector<std::shared_ptr<const std::vector<FieldT>>> shared_leaves;
     for (size_t i = 0; i < leaf_contents.size(); i++)
     {
         shared_leaves.emplace_back(
@@ -84,14 +173,14 @@ void merkle_tree<FieldT, hash_digest_type>::construct(const std::vector<std::vec
 }
 
 template<typename FieldT, typename hash_digest_type>
-void merkle_tree<FieldT, hash_digest_type>::construct(const std::vector<std::shared_ptr<std::vector<FieldT>>> &leaf_contents)
+void merkle_tree<FieldT, hash_digest_type>::construct(const std::vector<std::shared_ptr<const std::vector<FieldT>>> &leaf_contents)
 {
     this->construct_with_leaves_serialized_by_cosets(leaf_contents, 1);
 }
 
 template<typename FieldT, typename hash_digest_type>
 void merkle_tree<FieldT, hash_digest_type>::construct_with_leaves_serialized_by_cosets(
-    const std::vector<std::shared_ptr<std::vector<FieldT>> > &leaf_contents,
+    const std::vector<std::shared_ptr<const std::vector<FieldT>>> &leaf_contents,
     const size_t coset_serialization_size)
 {
     /* Check that the input is as expected */
@@ -117,32 +206,52 @@ void merkle_tree<FieldT, hash_digest_type>::construct_with_leaves_serialized_by_
     /* Domain with the same size as inputs, used for getting coset positions */
     field_subset<FieldT> leaf_domain(leaf_contents[0]->size());
     /* First hash the leaves. Since we are putting an entire coset into a leaf,
-     * our slice is of size num_input_oracles * coset_size */
-    std::vector<FieldT> slice(leaf_contents.size() * coset_serialization_size,
-        FieldT::zero());
-    for (std::size_t i = 0; i < this->num_leaves_; ++i)
+     * our slice is of size num_input_oracles * coset_size.
+     * Leaves are gathered merkle_tree_leaf_batch_size at a time into consecutive slices, so that the
+     * leaf hash can compress them together. Each thread gets its own slices and salts, and batches
+     * are hashed independently. */
+    const bool parallel_leaves = merkle_tree_hashes_in_parallel<hash_digest_type>() &&
+        this->num_leaves_ >= merkle_tree_parallel_min_hashes;
+    const std::size_t slice_size = leaf_contents.size() * coset_serialization_size;
+    const std::size_t num_leaf_batches =
+        (this->num_leaves_ + merkle_tree_leaf_batch_size - 1) / merkle_tree_leaf_batch_size;
+#ifdef MULTICORE
+    #pragma omp parallel if (parallel_leaves)
+#endif
     {
-        std::vector<size_t> positions_in_this_slice =
-            leaf_domain.all_positions_in_coset_i(i, coset_serialization_size);
-        for (size_t j = 0; j < coset_serialization_size; j++)
+        std::vector<FieldT> slices(merkle_tree_leaf_batch_size * slice_size, FieldT::zero());
+        std::vector<zk_salt_type> salts(this->make_zk_ ? merkle_tree_leaf_batch_size : 0);
+#ifdef MULTICORE
+        #pragma omp for
+#endif
+        for (std::size_t b = 0; b < num_leaf_batches; ++b)
         {
-            for (size_t k = 0; k < leaf_contents.size(); k++)
+            const std::size_t begin = b * merkle_tree_leaf_batch_size;
+            const std::size_t end = std::min(begin + merkle_tree_leaf_batch_size, this->num_leaves_);
+            for (std::size_t i = begin; i < end; ++i)
             {
-                slice[j + k*coset_serialization_size] =
-                    leaf_contents[k]->operator[](positions_in_this_slice[j]);
+                FieldT *slice = &slices[(i - begin) * slice_size];
+                const std::vector<size_t> positions_in_this_slice =
+                    leaf_domain.all_positions_in_coset_i(i, coset_serialization_size);
+                for (size_t j = 0; j < coset_serialization_size; j++)
+                {
+                    for (size_t k = 0; k < leaf_contents.size(); k++)
+                    {
+                        slice[j + k*coset_serialization_size] =
+                            leaf_contents[k]->operator[](positions_in_this_slice[j]);
+                    }
+                }
             }
-        }
 
-        hash_digest_type digest;
-        if (this->make_zk_)
-        {
-            digest = this->leaf_hasher_->zk_hash(slice, this->zk_leaf_randomness_elements_[i]);
-        }
-        else
-        {
-            digest = this->leaf_hasher_->hash(slice);
+            if (this->make_zk_)
+            {
+                this->leaf_zk_salts(begin, end - begin, salts.data());
+            }
+            this->leaf_hasher_->hash_batch(
+                slices.data(), end - begin, slice_size,
+                this->make_zk_ ? salts.data() : nullptr,
+                &this->inner_nodes_[(this->num_leaves_ - 1) + begin]);
         }
-        this->inner_nodes_[(this->num_leaves_ - 1) + i] = digest;
     }
 
     /* Then hash all the layers */
@@ -200,23 +309,20 @@ std::vector<std::vector<FieldT>> merkle_tree<FieldT, hash_digest_type>::serializ
 template<typename FieldT, typename hash_digest_type>
 void merkle_tree<FieldT, hash_digest_type>::compute_inner_nodes()
 {
-    // TODO: Better document this function, its hashing layer by layer.
+    /* Hashes layer by layer, from the leaves up. Layer [n, 2n] has its children at [2n+1, 4n+2],
+     * with the children of node j at 2j+1 and 2j+2, so a whole layer is one contiguous batch. */
     std::size_t n = (this->num_leaves_ - 1) / 2;
     while (true)
     {
         // TODO: Evaluate how much time is spent in hashing vs memory access.
         // For better memory efficiency, we could hash sub-tree by sub-tree
         // in an unrolled recursive fashion.
-        for (std::size_t j = n; j <= 2*n; ++j)
-        {
-            // TODO: Can we rely on left and right to be placed sequentially in memory,
-            // for better performance in node hasher?
-            const hash_digest_type& left = this->inner_nodes_[2*j + 1];
-            const hash_digest_type& right = this->inner_nodes_[2*j + 2];
-            const hash_digest_type digest = this->node_hasher_(left, right, this->digest_len_bytes_);
-
-            this->inner_nodes_[j] = digest;
-        }
+        hash_merkle_tree_layer<hash_digest_type>(
+            &this->inner_nodes_[2*n + 1],
+            &this->inner_nodes_[n],
+            n + 1,
+            this->node_hasher_,
+            this->digest_len_bytes_);
         if (n > 0)
         {
             n /= 2;
@@ -268,10 +374,10 @@ merkle_tree_set_membership_proof<hash_digest_type>
     if (this->make_zk_)
     {
         /* add random hashes, in order, to the beginning (one for each query) */
-        for (auto &pos : S)
+        result.randomness_hashes.resize(S.size());
+        for (std::size_t i = 0; i < S.size(); ++i)
         {
-            const zk_salt_type random_digest = this->zk_leaf_randomness_elements_[pos];
-            result.randomness_hashes.emplace_back(random_digest);
+            this->leaf_zk_salts(S[i], 1, &result.randomness_hashes[i]);
         }
     }
 
@@ -23,7 +23,7 @@ protected:
     std::size_t work_parameter_; /* The prover will do an expected 2^work_parameter units of work */
     std::size_t cost_per_hash_; /* How many units of work is one hash */
 public:
-    pow_parameters() {};
+    pow_parameters() : work_parameter_(0), cost_per_hash_(1) {};
     pow_parameters(
         const size_t work_parameter,
         const size_t cost_per_hash);
@@ -49,6 +49,9 @@ public:
     // The proof of work is satisfied if H(x) & pow_bitlen < pow_upperbound
     // For binary hashes, this is done by interpreting H(x) as 4 words, each word being written little-endian.
     // This property is satisfied on the final little-endian word.
+    // For binary hashes the nonce space is searched by all threads, in batches that go through the
+    // multi-lane BLAKE2b when node_hasher is blake2b_two_to_one_hash. The answer is still the smallest
+    // valid nonce. Algebraic hashers keep sponge state, so that search stays serial.
     hash_digest_type solve_pow(
         const two_to_one_hash_function<hash_digest_type> &node_hasher, 
         const hash_digest_type &challenge) const;
@@ -1,8 +1,13 @@
 #include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
 #include <stdexcept>
 
 #include <libff/common/profiling.hpp>
 #include "libiop/common/cpp17_bits.hpp"
+#include "libiop/bcs/hashing/blake2b.hpp"
+#include "libiop/bcs/hashing/blake3.hpp"
 #include <libff/common/utils.hpp>
 
 #include <sodium/randombytes.h>
@@ -10,6 +15,9 @@
 
 namespace libiop {
 
+/* Nonces a thread tries between checks of whether another thread has already succeeded */
+const size_t pow_nonces_per_batch = 1ull<<8;
+
 pow_parameters::pow_parameters(
     const size_t work_parameter,
     const size_t cost_per_hash) :
@@ -88,16 +96,82 @@ hash_digest_type pow<FieldT, hash_digest_type>::solve_pow_internal(
     const two_to_one_hash_function<hash_digest_type> &node_hasher, 
     const typename libff::enable_if<std::is_same<hash_digest_type, binary_hash_digest>::value, hash_digest_type>::type challenge) const
 {
-    binary_hash_digest pow;
-    pow.assign(challenge);
+    /* The nonce goes in the last whole word, so a challenge shorter than a word is not a valid start */
+    const binary_hash_digest start = (challenge.size() >= sizeof(size_t)) ?
+        challenge : binary_hash_digest(std::max(this->digest_len_bytes_, sizeof(size_t)));
+    /* The start itself is tried before any nonce is written */
+    if (this->verify_pow(node_hasher, challenge, start))
+    {
+        return start;
+    }
 
-    size_t num_words = pow.length() / sizeof(size_t);
-    size_t pow_int = 0;
-    while (this->verify_pow(node_hasher, challenge, pow) == false)
+    const size_t nonce_offset = (start.length() / sizeof(size_t) - 1) * sizeof(size_t);
+    const bool is_blake2b = is_blake2b_two_to_one_hash(node_hasher);
+    const bool is_blake3 = is_blake3_two_to_one_hash(node_hasher);
+
+    /* Threads claim batches of nonces in increasing order, and stop once their next batch starts past
+       the smallest nonce found so far. Every batch below it is still searched to the end, so the answer
+       is the smallest valid nonce, the same one a serial search finds. */
+    std::atomic<size_t> next_batch(0);
+    std::atomic<size_t> found(std::numeric_limits<size_t>::max());
+#ifdef MULTICORE
+    #pragma omp parallel
+#endif
     {
-        std::memcpy(&pow[(num_words - 1)*sizeof(size_t)], &pow_int, sizeof(size_t));
-        pow_int += 1;
+        /* (challenge, candidate) pairs, as the two to one hash batches read them */
+        std::vector<binary_hash_digest> pairs(2 * pow_nonces_per_batch, start);
+        std::vector<binary_hash_digest> hashes(pow_nonces_per_batch);
+        for (size_t i = 0; i < pow_nonces_per_batch; ++i)
+        {
+            pairs[2*i] = challenge;
+        }
+
+        while (true)
+        {
+            const size_t begin = next_batch.fetch_add(pow_nonces_per_batch);
+            if (begin >= found.load())
+            {
+                break;
+            }
+
+            for (size_t i = 0; i < pow_nonces_per_batch; ++i)
+            {
+                const size_t nonce = begin + i;
+                std::memcpy(&pairs[2*i + 1][nonce_offset], &nonce, sizeof(size_t));
+            }
+            if (is_blake2b)
+            {
+                blake2b_two_to_one_hash_batch(pairs.data(), hashes.data(), pow_nonces_per_batch, this->digest_len_bytes_);
+            }
+            else if (is_blake3)
+            {
+                blake3_two_to_one_hash_batch(pairs.data(), hashes.data(), pow_nonces_per_batch, this->digest_len_bytes_);
+            }
+            else
+            {
+                for (size_t i = 0; i < pow_nonces_per_batch; ++i)
+                {
+                    hashes[i] = node_hasher(pairs[2*i], pairs[2*i + 1], this->digest_len_bytes_);
+                }
+            }
+
+            for (size_t i = 0; i < pow_nonces_per_batch; ++i)
+            {
+                if (this->verify_pow_internal(hashes[i]))
+                {
+                    size_t current = found.load();
+                    while (begin + i < current && !found.compare_exchange_weak(current, begin + i))
+                    {
+                    }
+                    break;
+                }
+            }
+        }
     }
+
+    binary_hash_digest pow = start;
+    const size_t nonce = found.load();
+    std::memcpy(&pow[nonce_offset], &nonce, sizeof(size_t));
     return pow;
 }
 
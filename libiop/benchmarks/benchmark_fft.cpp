@@ -2,10 +2,12 @@
 #include <benchmark/benchmark.h>
 
 #include <libff/algebra/fields/binary/gf64.hpp>
+#include <libff/algebra/fields/binary/gf256.hpp>
 #include <libff/algebra/curves/edwards/edwards_pp.hpp>
 #include "libiop/algebra/fft.hpp"
 #include "libiop/algebra/field_subset/subspace.hpp"
 #include "libiop/algebra/utils.hpp"
+#include "libiop/common/parallel.hpp"
 #include <libff/common/utils.hpp>
 
 
@@ -81,6 +83,124 @@ static void BM_additive_IFFT(benchmark::State &state)
 
 BENCHMARK(BM_additive_IFFT)->Range(1ull<<4, 1ull<<20)->Unit(benchmark::kMicrosecond);
 
+/* The thread scaling benchmarks take (log_2 of the domain size, number of threads) as arguments.
+   The number of threads only has an effect in MULTICORE builds. */
+static void thread_scaling_args(benchmark::internal::Benchmark *b)
+{
+    for (long log_sz = 16; log_sz <= 24; log_sz += 4)
+    {
+        for (long num_threads = 1; num_threads <= 32; num_threads *= 2)
+        {
+            b->Args({log_sz, num_threads});
+        }
+    }
+}
+
+static void set_benchmark_num_threads(const size_t num_threads)
+{
+#ifdef MULTICORE
+    omp_set_num_threads(num_threads);
+#else
+    libff::UNUSED(num_threads);
+#endif
+}
+
+static void BM_additive_FFT_thread_scaling(benchmark::State &state)
+{
+    typedef libff::gf256 FieldT;
+
+    const size_t log_sz = state.range(0);
+    const size_t sz = 1ull << log_sz;
+    set_benchmark_num_threads(state.range(1));
+
+    const std::vector<FieldT> poly_coeffs = random_vector<FieldT>(sz);
+
+    const affine_subspace<FieldT> domain =
+        affine_subspace<FieldT>::random_affine_subspace(log_sz);
+
+    for (auto _ : state)
+    {
+        const std::vector<FieldT> result = additive_FFT<FieldT>(poly_coeffs, domain);
+    }
+
+    state.SetItemsProcessed(state.iterations() * sz);
+    set_benchmark_num_threads(max_num_threads());
+}
+
+BENCHMARK(BM_additive_FFT_thread_scaling)->Apply(thread_scaling_args)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_additive_IFFT_thread_scaling(benchmark::State &state)
+{
+    typedef libff::gf256 FieldT;
+
+    const size_t log_sz = state.range(0);
+    const size_t sz = 1ull << log_sz;
+    set_benchmark_num_threads(state.range(1));
+
+    const std::vector<FieldT> evals = random_vector<FieldT>(sz);
+
+    const affine_subspace<FieldT> domain =
+        affine_subspace<FieldT>::random_affine_subspace(log_sz);
+
+    for (auto _ : state)
+    {
+        const std::vector<FieldT> result = additive_IFFT<FieldT>(evals, domain);
+    }
+
+    state.SetItemsProcessed(state.iterations() * sz);
+    set_benchmark_num_threads(max_num_threads());
+}
+
+BENCHMARK(BM_additive_IFFT_thread_scaling)->Apply(thread_scaling_args)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_cantor_FFT_thread_scaling(benchmark::State &state)
+{
+    typedef libff::gf256 FieldT;
+
+    const size_t log_sz = state.range(0);
+    const size_t sz = 1ull << log_sz;
+    set_benchmark_num_threads(state.range(1));
+
+    const std::vector<FieldT> poly_coeffs = random_vector<FieldT>(sz);
+
+    const affine_subspace<FieldT> domain =
+        affine_subspace<FieldT>::shifted_cantor_basis(log_sz, FieldT::random_element());
+
+    for (auto _ : state)
+    {
+        const std::vector<FieldT> result = cantor_additive_FFT<FieldT>(poly_coeffs, domain);
+    }
+
+    state.SetItemsProcessed(state.iterations() * sz);
+    set_benchmark_num_threads(max_num_threads());
+}
+
+BENCHMARK(BM_cantor_FFT_thread_scaling)->Apply(thread_scaling_args)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_cantor_IFFT_thread_scaling(benchmark::State &state)
+{
+    typedef libff::gf256 FieldT;
+
+    const size_t log_sz = state.range(0);
+    const size_t sz = 1ull << log_sz;
+    set_benchmark_num_threads(state.range(1));
+
+    const std::vector<FieldT> evals = random_vector<FieldT>(sz);
+
+    const affine_subspace<FieldT> domain =
+        affine_subspace<FieldT>::shifted_cantor_basis(log_sz, FieldT::random_element());
+
+    for (auto _ : state)
+    {
+        const std::vector<FieldT> result = cantor_additive_IFFT<FieldT>(evals, domain);
+    }
+
+    state.SetItemsProcessed(state.iterations() * sz);
+    set_benchmark_num_threads(max_num_threads());
+}
+
+BENCHMARK(BM_cantor_IFFT_thread_scaling)->Apply(thread_scaling_args)->UseRealTime()->Unit(benchmark::kMillisecond);
+
 static void BM_multiplicative_subgroup_FFT(benchmark::State &state)
 {
     libff::edwards_pp::init_public_params();
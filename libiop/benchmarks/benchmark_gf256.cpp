@@ -4,6 +4,7 @@
 #include <benchmark/benchmark.h>
 
 #include <libff/algebra/fields/binary/gf256.hpp>
+#include "libiop/algebra/field_kernels.hpp"
 #include "libiop/algebra/utils.hpp"
 
 using namespace libff;
@@ -81,6 +82,57 @@ static void BM_gf256_mul(benchmark::State &state)
 
 BENCHMARK(BM_gf256_mul)->Range(1<<20, 1<<28)->Unit(benchmark::kMicrosecond);
 
+static void kernel_isa_args(benchmark::internal::Benchmark *b)
+{
+    for (long sz = 1<<10; sz <= 1<<18; sz <<= 4)
+    {
+        for (long isa = portable_binary_field_kernels; isa <= avx512_vpclmul_binary_field_kernels; ++isa)
+        {
+            b->Args({sz, isa});
+        }
+    }
+}
+
+/* Multiply-add against one constant, through the kernel set given by the second argument
+   (0 = the field's own arithmetic, see binary_field_kernel_isa) */
+static void BM_gf256_fma_by_constant(benchmark::State &state)
+{
+    const size_t sz = state.range(0);
+    const binary_field_kernel_isa isa = (binary_field_kernel_isa) state.range(1);
+    const binary_field_kernels *kernels = binary_field_kernels_for(sizeof(libff::gf256) / sizeof(uint64_t), isa);
+    if (isa != portable_binary_field_kernels && (kernels == nullptr || kernels->isa != isa))
+    {
+        state.SkipWithError("instruction set not supported");
+        return;
+    }
+
+    const std::vector<libff::gf256> avec = random_vector<libff::gf256>(sz);
+    std::vector<libff::gf256> bvec = random_vector<libff::gf256>(sz);
+    const libff::gf256 c = libff::gf256::random_element();
+
+    for (auto _ : state)
+    {
+        if (kernels == nullptr)
+        {
+            for (size_t i = 0; i < sz; ++i)
+            {
+                bvec[i] += avec[i] * c;
+            }
+        }
+        else
+        {
+            kernels->fma_by_constant(reinterpret_cast<uint64_t*>(bvec.data()),
+                                     reinterpret_cast<const uint64_t*>(avec.data()), sz,
+                                     reinterpret_cast<const uint64_t*>(&c));
+        }
+        benchmark::DoNotOptimize(bvec.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * sz);
+}
+
+BENCHMARK(BM_gf256_fma_by_constant)->Apply(kernel_isa_args)->Unit(benchmark::kMicrosecond);
+
 static void BM_gf256_inverse_vec(benchmark::State& state)
 {
     const size_t sz = state.range(0);
@@ -5,6 +5,7 @@
 
 #include "libiop/algebra/utils.hpp"
 #include "libiop/bcs/hashing/blake2b.hpp"
+#include "libiop/bcs/hashing/blake3.hpp"
 #include "libiop/bcs/hashing/algebraic_sponge.hpp"
 #include "libiop/bcs/hashing/poseidon.hpp"
 
@@ -32,6 +33,75 @@ static void BM_blake2b(benchmark::State &state)
 
 BENCHMARK(BM_blake2b)->RangeMultiplier(2)->Range(1, 16)->Unit(benchmark::kNanosecond);
 
+static void BM_blake2b_two_to_one_batch(benchmark::State &state)
+{
+    const size_t num_parents = 1ull << 10;
+    const size_t digest_len_bytes = 32;
+    const blake2b_batch_isa isa = (blake2b_batch_isa) state.range(0);
+
+    std::vector<binary_hash_digest> children;
+    for (size_t i = 0; i < 2 * num_parents; ++i)
+    {
+        const std::vector<uint8_t> bytes = random_vector<uint8_t>(digest_len_bytes);
+        children.emplace_back(bytes.begin(), bytes.end());
+    }
+    std::vector<binary_hash_digest> parents(num_parents);
+
+    for (auto _ : state)
+    {
+        blake2b_two_to_one_hash_batch(children.data(), parents.data(), num_parents, digest_len_bytes, isa);
+    }
+
+    state.SetItemsProcessed(state.iterations() * num_parents);
+}
+
+BENCHMARK(BM_blake2b_two_to_one_batch)->DenseRange(scalar_blake2b_batch, avx512_blake2b_batch)->Unit(benchmark::kMicrosecond);
+
+static void BM_blake3(benchmark::State &state)
+{
+    libff::alt_bn128_pp::init_public_params();
+    typedef libff::alt_bn128_Fr FieldT;
+
+    const size_t sz = state.range(0);
+
+    blake3_leafhash<FieldT> leafhasher(128);
+    const std::vector<FieldT> avec = random_vector<FieldT>(sz);
+
+    for (auto _ : state)
+    {
+        leafhasher.hash(avec);
+    }
+
+    state.SetItemsProcessed(state.iterations() * sz);
+}
+
+/* Up to 2^10 field elements, so that long leaves are split into many chunks */
+BENCHMARK(BM_blake3)->RangeMultiplier(4)->Range(1, 1 << 10)->Unit(benchmark::kNanosecond);
+
+static void BM_blake3_two_to_one_batch(benchmark::State &state)
+{
+    const size_t num_parents = 1ull << 10;
+    const size_t digest_len_bytes = 32;
+    const blake3_batch_isa isa = (blake3_batch_isa) state.range(0);
+
+    std::vector<binary_hash_digest> children;
+    for (size_t i = 0; i < 2 * num_parents; ++i)
+    {
+        const std::vector<uint8_t> bytes = random_vector<uint8_t>(digest_len_bytes);
+        children.emplace_back(bytes.begin(), bytes.end());
+    }
+    std::vector<binary_hash_digest> parents(num_parents);
+
+    for (auto _ : state)
+    {
+        blake3_two_to_one_hash_batch(children.data(), parents.data(), num_parents, digest_len_bytes, isa);
+    }
+
+    state.SetItemsProcessed(state.iterations() * num_parents);
+}
+
+BENCHMARK(BM_blake3_two_to_one_batch)->DenseRange(scalar_blake3_batch, avx512_blake3_batch)->Unit(benchmark::kMicrosecond);
+
 static void BM_Starkware_poseidon(benchmark::State &state)
 {
     libff::alt_bn128_pp::init_public_params();
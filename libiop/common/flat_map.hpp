@@ -0,0 +1,177 @@
+/**@file
+ *****************************************************************************
+ Flat lookup tables for the IOP's per-query state.
+
+ The verifier makes a lookup for every query response, query position and
+ verifier message it uses, so these replace std::map (one heap node per entry)
+ with contiguous storage: a dense table for registration ids, and an open
+ addressing hash table for sparse keys such as positions in a domain.
+ *****************************************************************************
+ * @author     This file is part of libiop (see AUTHORS)
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+#ifndef LIBIOP_COMMON_FLAT_MAP_HPP_
+#define LIBIOP_COMMON_FLAT_MAP_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace libiop {
+
+/** Table keyed by ids that are consecutive from 0, such as registration ids.
+ *  Storage is reserved for every id up front when the number of ids is known,
+ *  and grows to fit larger ids otherwise. */
+template<typename ValueT>
+class dense_id_map {
+protected:
+    std::vector<ValueT> values_;
+    std::vector<bool> present_;
+    std::size_t size_ = 0;
+
+public:
+    dense_id_map() = default;
+
+    void reserve(const std::size_t num_ids)
+    {
+        if (num_ids > this->values_.size())
+        {
+            this->values_.resize(num_ids);
+            this->present_.resize(num_ids, false);
+        }
+    }
+
+    /** Returns nullptr if id has no value */
+    const ValueT *find(const std::size_t id) const
+    {
+        if (id >= this->values_.size() || !this->present_[id])
+        {
+            return nullptr;
+        }
+        return &this->values_[id];
+    }
+
+    /** Sets the value of id, overwriting any previous one */
+    const ValueT &insert(const std::size_t id, ValueT value)
+    {
+        this->reserve(id + 1);
+        if (!this->present_[id])
+        {
+            this->present_[id] = true;
+            ++this->size_;
+        }
+        this->values_[id] = std::move(value);
+        return this->values_[id];
+    }
+
+    /** Number of ids with a value */
+    std::size_t size() const
+    {
+        return this->size_;
+    }
+};
+
+/** Open addressing hash table with linear probing, for sparse std::size_t keys.
+ *  The capacity is a power of two, and is kept at least twice the number of entries. */
+template<typename ValueT>
+class flat_hash_map {
+protected:
+    std::vector<std::size_t> keys_;
+    std::vector<ValueT> values_;
+    std::vector<bool> occupied_;
+    std::size_t size_ = 0;
+
+    std::size_t slot(const std::size_t key) const
+    {
+        /* Fibonacci hashing, so that consecutive keys do not fill consecutive slots */
+        const std::uint64_t h = static_cast<std::uint64_t>(key) * 0x9E3779B97F4A7C15ull;
+        return static_cast<std::size_t>(h ^ (h >> 32)) & (this->keys_.size() - 1);
+    }
+
+    void rehash(const std::size_t capacity)
+    {
+        std::vector<std::size_t> old_keys(capacity);
+        std::vector<ValueT> old_values(capacity);
+        std::vector<bool> old_occupied(capacity, false);
+        old_keys.swap(this->keys_);
+        old_values.swap(this->values_);
+        old_occupied.swap(this->occupied_);
+
+        this->size_ = 0;
+        for (std::size_t i = 0; i < old_keys.size(); ++i)
+        {
+            if (old_occupied[i])
+            {
+                this->insert(old_keys[i], std::move(old_values[i]));
+            }
+        }
+    }
+
+public:
+    flat_hash_map() = default;
+
+    /** Makes room for num_entries entries without rehashing */
+    void reserve(const std::size_t num_entries)
+    {
+        std::size_t capacity = 8;
+        while (capacity < 2 * num_entries)
+        {
+            capacity <<= 1;
+        }
+        if (capacity > this->keys_.size())
+        {
+            this->rehash(capacity);
+        }
+    }
+
+    /** Returns nullptr if key has no value */
+    const ValueT *find(const std::size_t key) const
+    {
+        if (this->size_ == 0)
+        {
+            return nullptr;
+        }
+        const std::size_t mask = this->keys_.size() - 1;
+        for (std::size_t i = this->slot(key); this->occupied_[i]; i = (i + 1) & mask)
+        {
+            if (this->keys_[i] == key)
+            {
+                return &this->values_[i];
+            }
+        }
+        return nullptr;
+    }
+
+    /** Sets the value of key, overwriting any previous one */
+    const ValueT &insert(const std::size_t key, ValueT value)
+    {
+        if (2 * (this->size_ + 1) > this->keys_.size())
+        {
+            this->reserve(this->size_ + 1);
+        }
+        const std::size_t mask = this->keys_.size() - 1;
+        std::size_t i = this->slot(key);
+        while (this->occupied_[i] && this->keys_[i] != key)
+        {
+            i = (i + 1) & mask;
+        }
+        if (!this->occupied_[i])
+        {
+            this->occupied_[i] = true;
+            this->keys_[i] = key;
+            ++this->size_;
+        }
+        this->values_[i] = std::move(value);
+        return this->values_[i];
+    }
+
+    std::size_t size() const
+    {
+        return this->size_;
+    }
+};
+
+} // namespace libiop
+
+#endif // LIBIOP_COMMON_FLAT_MAP_HPP_
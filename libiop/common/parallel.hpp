@@ -0,0 +1,73 @@
+/**@file
+ *****************************************************************************
+ Helpers for the MULTICORE (OpenMP) code paths.
+
+ When libiop is built without MULTICORE, every helper here degenerates to the
+ single threaded case, so callers can be written once for both builds.
+ *****************************************************************************
+ * @author     This file is part of libiop (see AUTHORS)
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+#ifndef LIBIOP_COMMON_PARALLEL_HPP_
+#define LIBIOP_COMMON_PARALLEL_HPP_
+
+#include <algorithm>
+#include <cstddef>
+
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+namespace libiop {
+
+/** Loops over fewer elements than this are not worth the cost of waking up the thread pool. */
+const std::size_t parallel_min_size = 1ull << 10;
+
+/** Number of threads the MULTICORE code paths run on, or 1 in a single threaded build. */
+inline std::size_t max_num_threads()
+{
+#ifdef MULTICORE
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+/** Number of contiguous chunks to split num_items into, so that each thread gets one chunk.
+ *  This is used for loops that carry state from one item to the next (e.g. running powers),
+ *  where each chunk recomputes its starting state once. */
+inline std::size_t num_parallel_chunks(const std::size_t num_items)
+{
+    return std::max<std::size_t>(1, std::min(max_num_threads(), num_items));
+}
+
+/** First item of the given chunk, when splitting num_items into num_chunks contiguous chunks.
+ *  Chunk c covers [chunk_begin(c), chunk_begin(c+1)). */
+inline std::size_t chunk_begin(const std::size_t chunk,
+                               const std::size_t num_chunks,
+                               const std::size_t num_items)
+{
+    return (chunk * num_items) / num_chunks;
+}
+
+/** Calls f(begin, end) on contiguous ranges that together cover [0, num_items), one range per
+ *  thread once there are at least parallel_min_size items. This is meant for element-wise loops
+ *  over a codeword domain (e.g. in virtual oracles) that carry state from one element to the
+ *  next, such as running powers of the domain generator: f recomputes that state at begin. */
+template<typename RangeFunction>
+void parallel_for_ranges(const std::size_t num_items, const RangeFunction &f)
+{
+    const std::size_t num_chunks =
+        (num_items >= parallel_min_size) ? num_parallel_chunks(num_items) : 1;
+#ifdef MULTICORE
+    #pragma omp parallel for if (num_chunks > 1)
+#endif
+    for (std::size_t c = 0; c < num_chunks; ++c)
+    {
+        f(chunk_begin(c, num_chunks, num_items), chunk_begin(c + 1, num_chunks, num_items));
+    }
+}
+
+} // namespace libiop
+
+#endif // LIBIOP_COMMON_PARALLEL_HPP_
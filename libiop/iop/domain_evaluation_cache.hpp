@@ -0,0 +1,69 @@
+/**@file
+*****************************************************************************
+Cache of evaluation tables that depend only on domains, such as the
+evaluations of a vanishing polynomial over a codeword domain.
+*****************************************************************************
+* @author     This file is part of libiop (see AUTHORS)
+* @copyright  MIT license (see LICENSE file)
+*****************************************************************************/
+#ifndef LIBIOP_IOP_DOMAIN_EVALUATION_CACHE_HPP_
+#define LIBIOP_IOP_DOMAIN_EVALUATION_CACHE_HPP_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "libiop/algebra/field_subset/field_subset.hpp"
+
+namespace libiop {
+
+/** Every sumcheck instance over the same pair of domains needs the same |L| sized tables,
+ *  e.g. Z_H over L. An IOP owns one cache, which shares each table between all protocol
+ *  components that ask for it, for the lifetime of the IOP (and so of a proof).
+ *
+ *  A table is identified by a name, the domain of the polynomial it comes from,
+ *  and the domain it is evaluated over. Lookups may run concurrently. */
+template<typename FieldT>
+class domain_evaluation_cache {
+public:
+    typedef std::function<std::vector<FieldT>()> table_calculator;
+
+    /** Returns the named table, computing it with calculate the first time it is asked for. */
+    std::shared_ptr<const std::vector<FieldT>> get_table(
+        const std::string &name,
+        const field_subset<FieldT> &polynomial_domain,
+        const field_subset<FieldT> &evaluation_domain,
+        const table_calculator &calculate);
+
+    /** Z_H over L */
+    std::shared_ptr<const std::vector<FieldT>> vanishing_polynomial_evaluations(
+        const field_subset<FieldT> &vanishing_domain,
+        const field_subset<FieldT> &evaluation_domain);
+    /** Z_H^{-1} over L, which must not intersect H */
+    std::shared_ptr<const std::vector<FieldT>> inverse_vanishing_polynomial_evaluations(
+        const field_subset<FieldT> &vanishing_domain,
+        const field_subset<FieldT> &evaluation_domain);
+
+    std::size_t num_tables() const;
+protected:
+    struct table_entry {
+        std::string name;
+        field_subset<FieldT> polynomial_domain;
+        field_subset<FieldT> evaluation_domain;
+        std::shared_ptr<const std::vector<FieldT>> table;
+    };
+    /* Only a handful of tables exist per proof, so they are searched linearly */
+    std::vector<table_entry> tables_;
+
+    std::shared_ptr<const std::vector<FieldT>> find_table(
+        const std::string &name,
+        const field_subset<FieldT> &polynomial_domain,
+        const field_subset<FieldT> &evaluation_domain) const;
+};
+
+} // namespace libiop
+
+#include "libiop/iop/domain_evaluation_cache.tcc"
+
+#endif // LIBIOP_IOP_DOMAIN_EVALUATION_CACHE_HPP_
@@ -0,0 +1,89 @@
+#include "libiop/algebra/utils.hpp"
+#include "libiop/algebra/polynomials/vanishing_polynomial.hpp"
+
+namespace libiop {
+
+template<typename FieldT>
+std::shared_ptr<const std::vector<FieldT>> domain_evaluation_cache<FieldT>::find_table(
+    const std::string &name,
+    const field_subset<FieldT> &polynomial_domain,
+    const field_subset<FieldT> &evaluation_domain) const
+{
+    for (const table_entry &entry : this->tables_)
+    {
+        if (entry.name == name &&
+            entry.polynomial_domain == polynomial_domain &&
+            entry.evaluation_domain == evaluation_domain)
+        {
+            return entry.table;
+        }
+    }
+    return nullptr;
+}
+
+template<typename FieldT>
+std::shared_ptr<const std::vector<FieldT>> domain_evaluation_cache<FieldT>::get_table(
+    const std::string &name,
+    const field_subset<FieldT> &polynomial_domain,
+    const field_subset<FieldT> &evaluation_domain,
+    const table_calculator &calculate)
+{
+    std::shared_ptr<const std::vector<FieldT>> table;
+#ifdef MULTICORE
+    #pragma omp critical(libiop_domain_evaluation_cache)
+#endif
+    {
+        table = this->find_table(name, polynomial_domain, evaluation_domain);
+    }
+    if (table)
+    {
+        return table;
+    }
+
+    /* Computed outside of the lock, so that calculate can parallelize itself.
+     * If two threads race to compute the same table, the first one stored is kept. */
+    std::shared_ptr<const std::vector<FieldT>> calculated =
+        std::make_shared<const std::vector<FieldT>>(calculate());
+#ifdef MULTICORE
+    #pragma omp critical(libiop_domain_evaluation_cache)
+#endif
+    {
+        table = this->find_table(name, polynomial_domain, evaluation_domain);
+        if (!table)
+        {
+            this->tables_.push_back({ name, polynomial_domain, evaluation_domain, calculated });
+            table = calculated;
+        }
+    }
+    return table;
+}
+
+template<typename FieldT>
+std::shared_ptr<const std::vector<FieldT>> domain_evaluation_cache<FieldT>::vanishing_polynomial_evaluations(
+    const field_subset<FieldT> &vanishing_domain,
+    const field_subset<FieldT> &evaluation_domain)
+{
+    return this->get_table("vanishing polynomial", vanishing_domain, evaluation_domain,
+        [&vanishing_domain, &evaluation_domain]() {
+            return vanishing_polynomial<FieldT>(vanishing_domain).evaluations_over_field_subset(evaluation_domain);
+        });
+}
+
+template<typename FieldT>
+std::shared_ptr<const std::vector<FieldT>> domain_evaluation_cache<FieldT>::inverse_vanishing_polynomial_evaluations(
+    const field_subset<FieldT> &vanishing_domain,
+    const field_subset<FieldT> &evaluation_domain)
+{
+    return this->get_table("inverse vanishing polynomial", vanishing_domain, evaluation_domain,
+        [this, &vanishing_domain, &evaluation_domain]() {
+            return batch_inverse(*this->vanishing_polynomial_evaluations(vanishing_domain, evaluation_domain));
+        });
+}
+
+template<typename FieldT>
+std::size_t domain_evaluation_cache<FieldT>::num_tables() const
+{
+    return this->tables_.size();
+}
+
+} // namespace libiop
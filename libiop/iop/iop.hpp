@@ -19,6 +19,8 @@ IOP interfaces.
 #include "libiop/algebra/field_subset/field_subset.hpp"
 #include "libiop/algebra/polynomials/polynomial.hpp"
 #include "libiop/algebra/field_subset/subspace.hpp"
+#include "libiop/common/flat_map.hpp"
+#include "libiop/iop/domain_evaluation_cache.hpp"
 #include "libiop/iop/oracles.hpp"
 
 namespace libiop {
@@ -330,17 +332,22 @@ protected:
     std::vector<deterministic_query_position_registration> deterministic_query_position_registrations_;
     std::vector<query_registration> query_registrations_;
 
-    std::vector<std::map<std::size_t, FieldT> > virtual_oracle_evaluation_cache_;
+    /* Indexed by virtual oracle id, and keyed by evaluation position */
+    std::vector<flat_hash_map<FieldT> > virtual_oracle_evaluation_cache_;
     std::vector<bool> virtual_oracle_should_cache_evaluated_contents_; // TODO: Is there a better name for this
 
-    std::map<std::size_t, std::size_t> random_query_positions_;
-    std::map<std::size_t, std::size_t> deterministic_query_positions_;
+    /* Indexed by registration id, and sized as the registrations are sealed */
+    dense_id_map<std::size_t> random_query_positions_;
+    dense_id_map<std::size_t> deterministic_query_positions_;
 
-    std::map<std::size_t, FieldT> query_responses_;
-    std::map<std::size_t, std::vector<FieldT> > verifier_random_messages_;
+    dense_id_map<FieldT> query_responses_;
+    dense_id_map<std::vector<FieldT> > verifier_random_messages_;
     /* This cache doesn't clear since it is used within the multi_ldt,
      * which is at the end of the protocols */
-    std::map<std::size_t, std::shared_ptr<std::vector<FieldT>> > virtual_oracle_evaluated_contents_cache_;
+    std::map<std::size_t, std::shared_ptr<const std::vector<FieldT>> > virtual_oracle_evaluated_contents_cache_;
+    /* Tables over whole domains, shared by the protocol components that need them */
+    std::shared_ptr<domain_evaluation_cache<FieldT>> domain_evaluation_cache_ =
+        std::make_shared<domain_evaluation_cache<FieldT>>();
 
     /* just like in the IOP paper the verifier goes first */
     iop_message_direction message_direction_ = direction_from_verifier;
@@ -400,6 +407,9 @@ public:
 
     const oracle<FieldT>& submit_oracle(const oracle_handle_ptr &handle, oracle<FieldT> &&contents);
     const oracle<FieldT>& submit_oracle(const oracle_handle &handle, oracle<FieldT> &&contents);
+    /** Shares the given buffer with the caller, who must not modify it afterwards. */
+    const oracle<FieldT>& submit_oracle(const oracle_handle_ptr &handle, std::shared_ptr<const std::vector<FieldT>> contents);
+    const oracle<FieldT>& submit_oracle(const oracle_handle &handle, std::shared_ptr<const std::vector<FieldT>> contents);
     void submit_prover_message(const prover_message_handle &handle, std::vector<FieldT> &&contents);
     void submit_prover_index(iop_prover_index<FieldT> &index);
     void signal_index_registrations_done();
@@ -417,10 +427,12 @@ public:
     iop_registration_state registration_state() const;
 
     field_subset<FieldT> get_domain(const domain_handle &handle) const;
+    /** Shared with the caller, so that virtual oracles can keep it. */
+    std::shared_ptr<domain_evaluation_cache<FieldT>> get_domain_evaluation_cache() const;
 
     std::size_t get_oracle_degree(const oracle_handle_ptr &handle) const;
     domain_handle get_oracle_domain(const oracle_handle_ptr &handle) const;
-    std::shared_ptr<std::vector<FieldT>> get_oracle_evaluations(const oracle_handle_ptr &handle);
+    std::shared_ptr<const std::vector<FieldT>> get_oracle_evaluations(const oracle_handle_ptr &handle);
     virtual FieldT get_oracle_evaluation_at_point(
         const oracle_handle_ptr &handle,
         const std::size_t evaluation_position,
@@ -440,6 +452,11 @@ protected:
      *  Merkle trees per round. */
     std::size_t num_domains_in_round(const std::size_t round) const;
 
+    /** Evaluates the given oracles, in order */
+    std::vector<std::shared_ptr<const std::vector<FieldT>>> get_all_oracle_evaluations(
+        const std::vector<oracle_handle_ptr> &handles);
+    std::shared_ptr<std::vector<FieldT>> fused_virtual_oracle_evaluations(const std::size_t virtual_oracle_id);
+
     std::map<std::size_t, std::set<std::size_t> > oracle_id_to_query_positions_; /* HACK */
 };
 
@@ -1,8 +1,14 @@
 #include <algorithm>
 #include <cstdlib>
+#include <exception>
+#include <functional>
+#include <map>
 #include <stdexcept>
 #include <iostream>
 
+#include <libff/common/profiling.hpp>
+#include "libiop/common/parallel.hpp"
+
 namespace libiop {
 
 template<typename FieldT>
@@ -139,7 +145,7 @@ virtual_oracle_handle iop_protocol<FieldT>::register_virtual_oracle(
                                              constituent_oracles);
     this->virtual_oracle_registrations_.emplace_back(std::move(registration));
     this->virtual_oracles_.emplace_back(contents);
-    this->virtual_oracle_evaluation_cache_.emplace_back(std::map<std::size_t, FieldT>());
+    this->virtual_oracle_evaluation_cache_.emplace_back(flat_hash_map<FieldT>());
     this->virtual_oracle_should_cache_evaluated_contents_.push_back(cache_evaluated_contents);
     this->next_oracle_uid_ += 1;
 
@@ -245,6 +251,7 @@ void iop_protocol<FieldT>::seal_interaction_registrations()
     this->num_oracles_at_end_of_round_.emplace_back(this->oracle_registrations_.size());
     this->num_prover_messages_at_end_of_round_.emplace_back(this->prover_message_registrations_.size());
     ++(this->num_interaction_rounds_);
+    this->verifier_random_messages_.reserve(this->verifier_random_message_registrations_.size());
 
     this->registration_state_ = registration_state_query;
     return;
@@ -258,6 +265,9 @@ void iop_protocol<FieldT>::seal_query_registrations()
         throw std::logic_error("attempted to seal query registrations "
                                "while not in query registration state");
     }
+    this->random_query_positions_.reserve(this->random_query_position_registrations_.size());
+    this->deterministic_query_positions_.reserve(this->deterministic_query_position_registrations_.size());
+    this->query_responses_.reserve(this->query_registrations_.size());
     this->registration_state_ = registration_state_done;
     return;
 }
@@ -300,12 +310,26 @@ const oracle<FieldT>& iop_protocol<FieldT>::submit_oracle(const oracle_handle &h
         throw std::invalid_argument("oracle evaluations don't match the domain size");
     }
 
-    this->oracles_[handle.id()] = contents;
+    this->oracles_[handle.id()] = std::move(contents);
     this->oracles_present_[handle.id()] = true;
 
     return (this->oracles_[handle.id()]);
 }
 
+template<typename FieldT>
+const oracle<FieldT>& iop_protocol<FieldT>::submit_oracle(const oracle_handle_ptr &handle,
+                                                          std::shared_ptr<const std::vector<FieldT>> contents)
+{
+    return this->submit_oracle(handle, oracle<FieldT>(std::move(contents)));
+}
+
+template<typename FieldT>
+const oracle<FieldT>& iop_protocol<FieldT>::submit_oracle(const oracle_handle &handle,
+                                                          std::shared_ptr<const std::vector<FieldT>> contents)
+{
+    return this->submit_oracle(handle, oracle<FieldT>(std::move(contents)));
+}
+
 template<typename FieldT>
 void iop_protocol<FieldT>::submit_prover_index(iop_prover_index<FieldT> &index)
 {
@@ -449,19 +473,19 @@ std::vector<FieldT> iop_protocol<FieldT>::obtain_verifier_random_message(const v
         throw std::invalid_argument("attempted to obtain a verifier random message for a further round (did you forget to call signal_prover_round_done?)");
     }
 
-    auto it = this->verifier_random_messages_.find(random_message.id());
-    if (it == this->verifier_random_messages_.end())
+    const std::vector<FieldT> *cached = this->verifier_random_messages_.find(random_message.id());
+    if (cached == nullptr)
     {
         const std::size_t message_length = this->verifier_random_message_registrations_[random_message.id()].size();
         const std::vector<FieldT> result = random_FieldT_vector<FieldT>(message_length);
 
-        this->verifier_random_messages_[random_message.id()] = result;
+        this->verifier_random_messages_.insert(random_message.id(), result);
 
         return result;
     }
     else
     {
-        return it->second;
+        return *cached;
     }
 }
 
@@ -489,23 +513,23 @@ std::size_t iop_protocol<FieldT>::obtain_query_position(const query_position_han
 #endif
     if (position.type() == random_query_type)
     {
-        auto it = this->random_query_positions_.find(position.id());
-        if (it == this->random_query_positions_.end())
+        const std::size_t *cached = this->random_query_positions_.find(position.id());
+        if (cached == nullptr)
         {
             const random_query_position_handle random_position(position.id());
             const std::size_t result = this->obtain_random_query_position(random_position);
-            this->random_query_positions_[position.id()] = result;
+            this->random_query_positions_.insert(position.id(), result);
             return result;
         }
         else
         {
-            return it->second;
+            return *cached;
         }
     }
     else if (position.type() == deterministic_query_type)
     {
-        auto it = this->deterministic_query_positions_.find(position.id());
-        if (it == this->deterministic_query_positions_.end())
+        const std::size_t *cached = this->deterministic_query_positions_.find(position.id());
+        if (cached == nullptr)
         {
             const deterministic_query_position_registration& reg =
                 this->deterministic_query_position_registrations_[position.id()];
@@ -518,12 +542,12 @@ std::size_t iop_protocol<FieldT>::obtain_query_position(const query_position_han
 
             const std::size_t result = reg.position_calculator()(seed_position_values);
 
-            this->deterministic_query_positions_[position.id()] = result;
+            this->deterministic_query_positions_.insert(position.id(), result);
             return result;
         }
         else
         {
-            return it->second;
+            return *cached;
         }
     }
     else
@@ -543,8 +567,8 @@ FieldT iop_protocol<FieldT>::obtain_query_response(const query_handle &query)
     }
 #endif
 
-    auto it = this->query_responses_.find(query.id());
-    if (it == this->query_responses_.end())
+    const FieldT *cached = this->query_responses_.find(query.id());
+    if (cached == nullptr)
     {
         const oracle_handle_ptr oracle_h =
             this->query_registrations_[query.id()].oracle();
@@ -555,12 +579,12 @@ FieldT iop_protocol<FieldT>::obtain_query_response(const query_handle &query)
 
         const FieldT result = this->get_oracle_evaluation_at_point(oracle_h, position_idx, true);
 
-        this->query_responses_[query.id()] = result;
+        this->query_responses_.insert(query.id(), result);
         return result;
     }
     else
     {
-        return it->second;
+        return *cached;
     }
 }
 
@@ -593,6 +617,12 @@ field_subset<FieldT> iop_protocol<FieldT>::get_domain(const domain_handle &handl
     return this->domains_[handle.id()];
 }
 
+template<typename FieldT>
+std::shared_ptr<domain_evaluation_cache<FieldT>> iop_protocol<FieldT>::get_domain_evaluation_cache() const
+{
+    return this->domain_evaluation_cache_;
+}
+
 template<typename FieldT>
 std::size_t iop_protocol<FieldT>::get_oracle_degree(const oracle_handle_ptr &handle) const
 {
@@ -628,7 +658,7 @@ domain_handle iop_protocol<FieldT>::get_oracle_domain(const oracle_handle_ptr &h
 }
 
 template<typename FieldT>
-std::shared_ptr<std::vector<FieldT>> iop_protocol<FieldT>::get_oracle_evaluations(const oracle_handle_ptr &handle)
+std::shared_ptr<const std::vector<FieldT>> iop_protocol<FieldT>::get_oracle_evaluations(const oracle_handle_ptr &handle)
 {
     if (std::dynamic_pointer_cast<oracle_handle>(handle))
     {
@@ -637,25 +667,31 @@ std::shared_ptr<std::vector<FieldT>> iop_protocol<FieldT>::get_oracle_evaluation
     else if (std::dynamic_pointer_cast<virtual_oracle_handle>(handle))
     {
         /** If virtual oracle has caching enabled, and is cached, use the cache. */
-        if (this->virtual_oracle_should_cache_evaluated_contents_[handle->id()] &&
-            this->virtual_oracle_evaluated_contents_cache_.count(handle->id()) == 1)
+        const bool should_cache = this->virtual_oracle_should_cache_evaluated_contents_[handle->id()];
+        if (should_cache)
         {
-            return this->virtual_oracle_evaluated_contents_cache_[handle->id()];
+            auto it = this->virtual_oracle_evaluated_contents_cache_.find(handle->id());
+            if (it != this->virtual_oracle_evaluated_contents_cache_.end())
+            {
+                return it->second;
+            }
         }
-        const virtual_oracle_registration& reg =
-            this->virtual_oracle_registrations_[handle->id()];
-
-        std::vector<std::shared_ptr<std::vector<FieldT>> > constituent_evaluations;
-        for (auto &constituent_handle : reg.constituent_oracles())
+        std::shared_ptr<const std::vector<FieldT>> result;
+        if (std::dynamic_pointer_cast<pointwise_virtual_oracle<FieldT>>(this->virtual_oracles_[handle->id()]))
         {
-            constituent_evaluations.emplace_back(this->get_oracle_evaluations(constituent_handle));
+            result = this->fused_virtual_oracle_evaluations(handle->id());
+        }
+        else
+        {
+            const std::vector<oracle_handle_ptr> &constituent_handles =
+                this->virtual_oracle_registrations_[handle->id()].constituent_oracles();
+            result = this->virtual_oracles_[handle->id()]->evaluated_contents(
+                this->get_all_oracle_evaluations(constituent_handles));
         }
 
-        const std::shared_ptr<std::vector<FieldT>> result = this->virtual_oracles_[handle->id()]->evaluated_contents(constituent_evaluations);
-
-        if (this->virtual_oracle_should_cache_evaluated_contents_[handle->id()])
+        if (should_cache)
         {
-            return this->virtual_oracle_evaluated_contents_cache_[handle->id()] = result;
+            this->virtual_oracle_evaluated_contents_cache_[handle->id()] = result;
         }
 
         return result;
@@ -666,6 +702,178 @@ std::shared_ptr<std::vector<FieldT>> iop_protocol<FieldT>::get_oracle_evaluation
     }
 }
 
+template<typename FieldT>
+std::vector<std::shared_ptr<const std::vector<FieldT>>> iop_protocol<FieldT>::get_all_oracle_evaluations(
+    const std::vector<oracle_handle_ptr> &handles)
+{
+    /** Each virtual oracle already spreads its own element-wise loops over every thread,
+     *  so the oracles are evaluated one after the other. */
+    std::vector<std::shared_ptr<const std::vector<FieldT>>> evaluations;
+    evaluations.reserve(handles.size());
+    for (auto &handle : handles)
+    {
+        evaluations.emplace_back(this->get_oracle_evaluations(handle));
+    }
+    return evaluations;
+}
+
+/** Evaluates a pointwise virtual oracle together with the pointwise virtual oracles below it.
+ *
+ *  Starting from the requested oracle, every constituent that is a pointwise virtual oracle
+ *  over the same domain, and isn't cached, is inlined into one expression DAG. The remaining
+ *  constituents (committed oracles, other virtual oracles, cached ones) are its leaves, and are
+ *  the only codewords that get materialized, apart from spilled committed oracles, which are
+ *  read back one block at a time. The DAG is then evaluated one block at a time, with the
+ *  inner nodes writing into per block scratch space. */
+template<typename FieldT>
+std::shared_ptr<std::vector<FieldT>> iop_protocol<FieldT>::fused_virtual_oracle_evaluations(
+    const std::size_t virtual_oracle_id)
+{
+    /* An input of a node is either leaf i (is_leaf), or the output of node i */
+    struct fused_input {
+        bool is_leaf;
+        std::size_t index;
+    };
+    struct fused_node {
+        std::shared_ptr<pointwise_virtual_oracle<FieldT>> oracle;
+        std::vector<fused_input> inputs;
+    };
+
+    const std::size_t domain_id = this->virtual_oracle_registrations_[virtual_oracle_id].domain().id();
+    std::vector<fused_node> nodes;
+    std::vector<oracle_handle_ptr> leaves;
+    std::map<std::size_t, std::size_t> node_by_virtual_oracle_id;
+    std::map<std::pair<bool, std::size_t>, std::size_t> leaf_by_oracle;
+
+    /* Appends the nodes of the given virtual oracle in topological order, so the root is last */
+    std::function<std::size_t(std::size_t)> add_node = [&](const std::size_t id) -> std::size_t {
+        fused_node node;
+        node.oracle = std::dynamic_pointer_cast<pointwise_virtual_oracle<FieldT>>(this->virtual_oracles_[id]);
+        for (auto &constituent : this->virtual_oracle_registrations_[id].constituent_oracles())
+        {
+            const bool is_virtual = (std::dynamic_pointer_cast<virtual_oracle_handle>(constituent) != nullptr);
+            const std::size_t constituent_id = constituent->id();
+            const bool can_inline = is_virtual &&
+                !this->virtual_oracle_should_cache_evaluated_contents_[constituent_id] &&
+                this->virtual_oracle_registrations_[constituent_id].domain().id() == domain_id &&
+                std::dynamic_pointer_cast<pointwise_virtual_oracle<FieldT>>(this->virtual_oracles_[constituent_id]);
+            if (can_inline)
+            {
+                auto it = node_by_virtual_oracle_id.find(constituent_id);
+                const std::size_t index = (it != node_by_virtual_oracle_id.end()) ?
+                    it->second : add_node(constituent_id);
+                node.inputs.push_back(fused_input{false, index});
+            }
+            else
+            {
+                const std::pair<bool, std::size_t> key(is_virtual, constituent_id);
+                auto it = leaf_by_oracle.find(key);
+                if (it == leaf_by_oracle.end())
+                {
+                    it = leaf_by_oracle.emplace(key, leaves.size()).first;
+                    leaves.emplace_back(constituent);
+                }
+                node.inputs.push_back(fused_input{true, it->second});
+            }
+        }
+        nodes.emplace_back(std::move(node));
+        node_by_virtual_oracle_id[id] = nodes.size() - 1;
+        return nodes.size() - 1;
+    };
+    add_node(virtual_oracle_id);
+
+    /* Committed oracles that were spilled are read back a block at a time, instead of being
+       reloaded whole, so that the leaves of a wide oracle are never all in memory at once */
+    std::vector<bool> leaf_is_spilled(leaves.size(), false);
+    std::vector<oracle_handle_ptr> resident_leaves;
+    for (std::size_t i = 0; i < leaves.size(); ++i)
+    {
+        leaf_is_spilled[i] = (std::dynamic_pointer_cast<oracle_handle>(leaves[i]) != nullptr &&
+                              this->oracles_[leaves[i]->id()].is_spilled());
+        if (!leaf_is_spilled[i])
+        {
+            resident_leaves.emplace_back(leaves[i]);
+        }
+    }
+    const std::vector<std::shared_ptr<const std::vector<FieldT>>> resident_evaluations =
+        this->get_all_oracle_evaluations(resident_leaves);
+    const std::size_t n = this->domains_[domain_id].num_elements();
+    std::vector<std::shared_ptr<const std::vector<FieldT>>> leaf_evaluations(leaves.size());
+    for (std::size_t i = 0, j = 0; i < leaves.size(); ++i)
+    {
+        if (leaf_is_spilled[i])
+        {
+            continue;
+        }
+        leaf_evaluations[i] = resident_evaluations[j++];
+        if (leaf_evaluations[i]->size() != n)
+        {
+            throw std::invalid_argument("Vectors of mismatched size.");
+        }
+    }
+
+    std::shared_ptr<std::vector<FieldT>> result = std::make_shared<std::vector<FieldT>>(n);
+    const std::size_t num_blocks =
+        (n + pointwise_evaluation_block_size - 1) / pointwise_evaluation_block_size;
+    std::vector<std::exception_ptr> errors(num_blocks);
+#ifdef MULTICORE
+    #pragma omp parallel for if (num_blocks > 1)
+#endif
+    for (std::size_t b = 0; b < num_blocks; ++b)
+    {
+        const std::size_t begin = b * pointwise_evaluation_block_size;
+        const std::size_t end = std::min(n, begin + pointwise_evaluation_block_size);
+        std::vector<std::vector<FieldT>> scratch(nodes.size() - 1, std::vector<FieldT>(end - begin));
+        std::vector<std::vector<FieldT>> spilled_blocks(leaves.size());
+        try
+        {
+            for (std::size_t i = 0; i < leaves.size(); ++i)
+            {
+                if (leaf_is_spilled[i])
+                {
+                    spilled_blocks[i].resize(end - begin);
+                    this->oracles_[leaves[i]->id()].evaluations_in_range(begin, end, spilled_blocks[i].data());
+                }
+            }
+            for (std::size_t k = 0; k < nodes.size(); ++k)
+            {
+                std::vector<const FieldT*> constituent_blocks;
+                constituent_blocks.reserve(nodes[k].inputs.size());
+                for (const fused_input &input : nodes[k].inputs)
+                {
+                    if (!input.is_leaf)
+                    {
+                        constituent_blocks.emplace_back(scratch[input.index].data());
+                    }
+                    else if (leaf_is_spilled[input.index])
+                    {
+                        constituent_blocks.emplace_back(spilled_blocks[input.index].data());
+                    }
+                    else
+                    {
+                        constituent_blocks.emplace_back(leaf_evaluations[input.index]->data() + begin);
+                    }
+                }
+                FieldT *out = (k + 1 == nodes.size()) ? result->data() + begin : scratch[k].data();
+                nodes[k].oracle->evaluate_block(begin, end, constituent_blocks, out);
+            }
+        }
+        catch (...)
+        {
+            errors[b] = std::current_exception();
+        }
+    }
+    for (auto &error : errors)
+    {
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+    return result;
+}
+
 template<typename FieldT>
 FieldT iop_protocol<FieldT>::get_oracle_evaluation_at_point(const oracle_handle_ptr &handle,
                                                             const std::size_t evaluation_position,
@@ -684,13 +892,14 @@ FieldT iop_protocol<FieldT>::get_oracle_evaluation_at_point(const oracle_handle_
             this->oracle_id_to_query_positions_[handle->id()].insert(evaluation_position);
         }
 
-        return this->oracles_[handle->id()].evaluated_contents()->operator[](evaluation_position);
+        return this->oracles_[handle->id()].evaluation_at_position(evaluation_position);
     }
     else if (std::dynamic_pointer_cast<virtual_oracle_handle>(handle))
     {
-        std::map<std::size_t, FieldT> &evaluation_cache = this->virtual_oracle_evaluation_cache_[handle->id()];
-        if(evaluation_cache.count(evaluation_position) == 1) {
-            return evaluation_cache[evaluation_position];
+        const FieldT *cached = this->virtual_oracle_evaluation_cache_[handle->id()].find(evaluation_position);
+        if (cached != nullptr)
+        {
+            return *cached;
         }
         const virtual_oracle_registration& reg =
             this->virtual_oracle_registrations_[handle->id()];
@@ -704,7 +913,7 @@ FieldT iop_protocol<FieldT>::get_oracle_evaluation_at_point(const oracle_handle_
         const FieldT evaluation_point = this->get_domain(reg.domain()).element_by_index(evaluation_position);
 
         const FieldT result = this->virtual_oracles_[handle->id()]->evaluation_at_point(evaluation_position, evaluation_point, constituent_evaluations);
-        evaluation_cache[evaluation_position] = result;
+        this->virtual_oracle_evaluation_cache_[handle->id()].insert(evaluation_position, result);
         return result;
     }
     else
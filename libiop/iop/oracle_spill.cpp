@@ -0,0 +1,119 @@
+#include "libiop/iop/oracle_spill.hpp"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace libiop {
+
+oracle_spill_file::oracle_spill_file(const std::string &directory)
+{
+    std::string dir = directory;
+    if (dir.empty())
+    {
+        const char *tmpdir = std::getenv("TMPDIR");
+        dir = (tmpdir != nullptr && tmpdir[0] != '\0') ? tmpdir : "/tmp";
+    }
+
+    const std::string name_template = dir + "/libiop_oracles_XXXXXX";
+    std::vector<char> name(name_template.begin(), name_template.end());
+    name.emplace_back('\0');
+
+    this->fd_ = mkstemp(name.data());
+    if (this->fd_ < 0)
+    {
+        throw std::runtime_error("Could not create oracle spill file in " + dir + ": " + std::strerror(errno));
+    }
+    unlink(name.data());
+}
+
+oracle_spill_file::~oracle_spill_file()
+{
+    close(this->fd_);
+}
+
+std::size_t oracle_spill_file::append(const void *data, const std::size_t num_bytes)
+{
+    const std::size_t offset = this->num_bytes_;
+    const char *bytes = static_cast<const char*>(data);
+    std::size_t written = 0;
+    while (written < num_bytes)
+    {
+        const ssize_t result = pwrite(this->fd_, bytes + written, num_bytes - written, offset + written);
+        if (result < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (result < 0)
+        {
+            throw std::runtime_error(std::string("Could not write to oracle spill file: ") + std::strerror(errno));
+        }
+        /* errno is not set when nothing is written */
+        if (result == 0)
+        {
+            throw std::runtime_error("Could not write to oracle spill file: no bytes written.");
+        }
+        written += result;
+    }
+    this->num_bytes_ += num_bytes;
+    return offset;
+}
+
+void oracle_spill_file::read(const std::size_t offset, void *out, const std::size_t num_bytes) const
+{
+    if (offset + num_bytes > this->num_bytes_)
+    {
+        throw std::invalid_argument("Read past the end of the oracle spill file.");
+    }
+
+    char *bytes = static_cast<char*>(out);
+    std::size_t done = 0;
+    while (done < num_bytes)
+    {
+        const ssize_t result = pread(this->fd_, bytes + done, num_bytes - done, offset + done);
+        if (result < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (result < 0)
+        {
+            throw std::runtime_error(std::string("Could not read from oracle spill file: ") + std::strerror(errno));
+        }
+        if (result == 0)
+        {
+            throw std::runtime_error("Unexpected end of oracle spill file.");
+        }
+        done += result;
+    }
+}
+
+std::size_t oracle_spill_file::num_bytes() const
+{
+    return this->num_bytes_;
+}
+
+void oracle_spill_file::note_reloaded(const std::size_t num_bytes) const
+{
+    const std::size_t reloaded = (this->num_reloaded_bytes_ += num_bytes);
+    std::size_t peak = this->peak_reloaded_bytes_.load();
+    while (peak < reloaded && !this->peak_reloaded_bytes_.compare_exchange_weak(peak, reloaded))
+    {
+    }
+}
+
+void oracle_spill_file::note_released(const std::size_t num_bytes) const
+{
+    this->num_reloaded_bytes_ -= num_bytes;
+}
+
+std::size_t oracle_spill_file::peak_reloaded_bytes() const
+{
+    return this->peak_reloaded_bytes_.load();
+}
+
+} // namespace libiop
@@ -0,0 +1,54 @@
+/**@file
+*****************************************************************************
+Temporary file that committed oracle evaluations can be moved into, so that
+the prover does not keep every oracle in memory for the whole proof.
+*****************************************************************************
+* @author     This file is part of libiop (see AUTHORS)
+* @copyright  MIT license (see LICENSE file)
+*****************************************************************************/
+#ifndef LIBIOP_IOP_ORACLE_SPILL_HPP_
+#define LIBIOP_IOP_ORACLE_SPILL_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+
+namespace libiop {
+
+/** An append-only scratch file. It is unlinked as soon as it is created, so it
+ *  disappears with its last file descriptor, even if the process dies.
+ *  Reads are positioned (pread), and so may run concurrently with each other,
+ *  but not with append. */
+class oracle_spill_file {
+protected:
+    int fd_;
+    std::size_t num_bytes_ = 0;
+
+    /* Bytes of whole codewords read back into memory, and not freed yet */
+    mutable std::atomic<std::size_t> num_reloaded_bytes_{0};
+    mutable std::atomic<std::size_t> peak_reloaded_bytes_{0};
+
+public:
+    /** Creates the file in directory, or in $TMPDIR (/tmp if unset) when directory is empty. */
+    explicit oracle_spill_file(const std::string &directory = "");
+    ~oracle_spill_file();
+
+    oracle_spill_file(const oracle_spill_file &other) = delete;
+    oracle_spill_file& operator=(const oracle_spill_file &other) = delete;
+
+    /** Writes num_bytes bytes at the end of the file, and returns the offset they start at. */
+    std::size_t append(const void *data, const std::size_t num_bytes);
+    void read(const std::size_t offset, void *out, const std::size_t num_bytes) const;
+
+    std::size_t num_bytes() const;
+
+    /** Readers that keep a whole codeword in memory report it here, and again once it is freed,
+     *  so that the peak amount of spilled data held at once can be checked. */
+    void note_reloaded(const std::size_t num_bytes) const;
+    void note_released(const std::size_t num_bytes) const;
+    std::size_t peak_reloaded_bytes() const;
+};
+
+} // namespace libiop
+
+#endif // LIBIOP_IOP_ORACLE_SPILL_HPP_
@@ -8,46 +8,128 @@ This file defines oracle interfaces
 #ifndef LIBIOP_IOP_ORACLES_HPP_
 #define LIBIOP_IOP_ORACLES_HPP_
 
+#include <algorithm>
 #include <cstddef>
+#include <exception>
 #include <functional>
 #include <map>
 #include <memory>
 #include <set>
+#include <stdexcept>
 #include <vector>
 
+#include "libiop/common/parallel.hpp"
+#include "libiop/iop/oracle_spill.hpp"
+
 namespace libiop {
 
 /* Oracles */
 template<typename FieldT>
 class oracle {
 protected:
-    std::shared_ptr<std::vector<FieldT>> evaluated_contents_;
+    std::shared_ptr<const std::vector<FieldT>> evaluated_contents_;
     bool erased_ = false;
 
+    /* Where the evaluations live once spilled (see spill_contents) */
+    std::shared_ptr<const oracle_spill_file> spill_file_;
+    std::size_t spill_offset_ = 0;
+    std::size_t num_spilled_elements_ = 0;
+
 public:
     oracle() = default;
     oracle(const std::vector<FieldT> &evaluated_contents) :
         evaluated_contents_(
-            std::make_shared<std::vector<FieldT>>(evaluated_contents)) {}
+            std::make_shared<const std::vector<FieldT>>(evaluated_contents)) {}
     oracle(std::vector<FieldT> &&evaluated_contents) :
         evaluated_contents_(
-            std::make_shared<std::vector<FieldT>>(std::move(evaluated_contents))) {}
-    // TODO: Should we make a method where the IOP infrastructure shares ownership
-    // of the provided oracle, instead of making its own copy
-    oracle(const std::shared_ptr<std::vector<FieldT>> &evaluated_contents) :
-        evaluated_contents_(
-            std::make_shared<std::vector<FieldT>>(*evaluated_contents.get())) {}
+            std::make_shared<const std::vector<FieldT>>(std::move(evaluated_contents))) {}
+    /* Shares ownership of the provided evaluations instead of copying them.
+       Submitted evaluations are immutable, which is why they are only ever
+       handed out as const: a caller that keeps a mutable pointer to the buffer
+       must not write to it afterwards. */
+    oracle(std::shared_ptr<const std::vector<FieldT>> evaluated_contents) :
+        evaluated_contents_(std::move(evaluated_contents)) {}
 
-    const std::shared_ptr<std::vector<FieldT>> evaluated_contents() const {
+    /** For a spilled oracle, this reads the evaluations back into a new buffer,
+     *  which is freed again once the caller drops it. */
+    std::shared_ptr<const std::vector<FieldT>> evaluated_contents() const {
         if (this->erased_)
         {
             throw std::invalid_argument("Oracle has been erased\n");
         }
+        if (this->spill_file_)
+        {
+            const std::shared_ptr<const oracle_spill_file> spill_file = this->spill_file_;
+            const std::size_t num_bytes = this->num_spilled_elements_ * sizeof(FieldT);
+            std::vector<FieldT> *buffer = new std::vector<FieldT>(this->num_spilled_elements_);
+            spill_file->note_reloaded(num_bytes);
+            std::shared_ptr<std::vector<FieldT>> contents(buffer,
+                [spill_file, num_bytes](std::vector<FieldT> *reloaded) {
+                    spill_file->note_released(num_bytes);
+                    delete reloaded;
+                });
+            spill_file->read(this->spill_offset_, contents->data(), num_bytes);
+            return contents;
+        }
         return this->evaluated_contents_;
     }
+    /** Copies the evaluations at positions [begin, end) into out.
+     *  A spilled oracle only reads those positions back, not the whole codeword. */
+    void evaluations_in_range(const std::size_t begin, const std::size_t end, FieldT *out) const {
+        if (this->erased_)
+        {
+            throw std::invalid_argument("Oracle has been erased\n");
+        }
+        const std::size_t num_elements = this->spill_file_ ?
+            this->num_spilled_elements_ : this->evaluated_contents_->size();
+        if (begin > end || end > num_elements)
+        {
+            throw std::invalid_argument("Evaluation range is outside of the oracle.");
+        }
+        if (this->spill_file_)
+        {
+            this->spill_file_->read(this->spill_offset_ + begin * sizeof(FieldT),
+                                    out, (end - begin) * sizeof(FieldT));
+            return;
+        }
+        std::copy(this->evaluated_contents_->begin() + begin,
+                  this->evaluated_contents_->begin() + end, out);
+    }
+    FieldT evaluation_at_position(const std::size_t position) const {
+        if (this->erased_)
+        {
+            throw std::invalid_argument("Oracle has been erased\n");
+        }
+        if (this->spill_file_)
+        {
+            FieldT result;
+            this->spill_file_->read(this->spill_offset_ + position * sizeof(FieldT),
+                                    &result, sizeof(FieldT));
+            return result;
+        }
+        return this->evaluated_contents_->operator[](position);
+    }
+    /** Moves the evaluations to the end of spill_file and releases this oracle's
+     *  reference to them. The evaluations are written out as raw bytes, so the
+     *  file is only meaningful within the current process. */
+    void spill_contents(const std::shared_ptr<oracle_spill_file> &spill_file) {
+        if (this->erased_ || this->spill_file_)
+        {
+            return;
+        }
+        this->num_spilled_elements_ = this->evaluated_contents_->size();
+        this->spill_offset_ = spill_file->append(this->evaluated_contents_->data(),
+                                                 this->num_spilled_elements_ * sizeof(FieldT));
+        this->spill_file_ = spill_file;
+        this->evaluated_contents_.reset();
+    }
+    bool is_spilled() const {
+        return (this->spill_file_ != nullptr);
+    }
     void erase_contents() {
         this->erased_ = true;
         this->evaluated_contents_.reset();
+        this->spill_file_.reset();
     }
 };
 
@@ -56,8 +138,7 @@ template<typename FieldT>
 class virtual_oracle : public oracle<FieldT> {
 public:
     virtual std::shared_ptr<std::vector<FieldT>> evaluated_contents(
-        const std::vector<std::shared_ptr<std::vector<FieldT>>>
-        &constituent_oracle_evaluations) const = 0;
+        const std::vector<std::shared_ptr<const std::vector<FieldT>>> &constituent_oracle_evaluations) const = 0;
 
     virtual FieldT evaluation_at_point(
         const std::size_t evaluation_position,
@@ -93,6 +174,91 @@ public:
     virtual ~virtual_oracle() = default;
 };
 
+/** Pointwise virtual oracles are evaluated in blocks of this many positions. Every block starts
+ *  at a multiple of this, so over an affine subspace, each block is an affine shift of the span
+ *  of the first log2(pointwise_evaluation_block_size) basis vectors. */
+const std::size_t pointwise_evaluation_block_size = 1ull << 12;
+
+/* Virtual oracle whose evaluation at a position only depends on that position and
+   on the evaluations of its constituents at the same position.
+
+   iop_protocol fuses a pointwise virtual oracle with those of its constituents that
+   are pointwise too (over the same domain, and not cached), and evaluates the whole
+   expression one block at a time, so the intermediate codewords are never built. */
+template<typename FieldT>
+class pointwise_virtual_oracle : public virtual_oracle<FieldT> {
+public:
+    /** Writes the evaluations at positions [begin, end) to out, where constituent_blocks[i][j]
+     *  is the evaluation of constituent i at position begin + j. begin is a multiple of
+     *  pointwise_evaluation_block_size, and end - begin is at most that. Blocks may be
+     *  evaluated concurrently. */
+    virtual void evaluate_block(
+        const std::size_t begin,
+        const std::size_t end,
+        const std::vector<const FieldT*> &constituent_blocks,
+        FieldT *out) const = 0;
+
+    /** Evaluates every block of the domain, in parallel. */
+    virtual std::shared_ptr<std::vector<FieldT>> evaluated_contents(
+        const std::vector<std::shared_ptr<const std::vector<FieldT>>> &constituent_oracle_evaluations) const;
+
+    virtual ~pointwise_virtual_oracle() = default;
+};
+
+template<typename FieldT>
+std::shared_ptr<std::vector<FieldT>> pointwise_virtual_oracle<FieldT>::evaluated_contents(
+    const std::vector<std::shared_ptr<const std::vector<FieldT>>> &constituent_oracle_evaluations) const
+{
+    if (constituent_oracle_evaluations.empty())
+    {
+        throw std::invalid_argument("A pointwise virtual oracle needs at least one constituent oracle.");
+    }
+    const std::size_t n = constituent_oracle_evaluations[0]->size();
+    for (auto &evaluations : constituent_oracle_evaluations)
+    {
+        if (evaluations->size() != n)
+        {
+            throw std::invalid_argument("Vectors of mismatched size.");
+        }
+    }
+
+    std::shared_ptr<std::vector<FieldT>> result = std::make_shared<std::vector<FieldT>>(n);
+    const std::size_t num_blocks =
+        (n + pointwise_evaluation_block_size - 1) / pointwise_evaluation_block_size;
+    std::vector<std::exception_ptr> errors(num_blocks);
+#ifdef MULTICORE
+    #pragma omp parallel for if (num_blocks > 1)
+#endif
+    for (std::size_t b = 0; b < num_blocks; ++b)
+    {
+        const std::size_t begin = b * pointwise_evaluation_block_size;
+        const std::size_t end = std::min(n, begin + pointwise_evaluation_block_size);
+        std::vector<const FieldT*> constituent_blocks;
+        constituent_blocks.reserve(constituent_oracle_evaluations.size());
+        for (auto &evaluations : constituent_oracle_evaluations)
+        {
+            constituent_blocks.emplace_back(evaluations->data() + begin);
+        }
+        try
+        {
+            this->evaluate_block(begin, end, constituent_blocks, result->data() + begin);
+        }
+        catch (...)
+        {
+            errors[b] = std::current_exception();
+        }
+    }
+    for (auto &error : errors)
+    {
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+    return result;
+}
+
 } // namespace libiop
 
 #endif // LIBIOP_IOP_ORACLES_HPP_
@@ -1,10 +1,10 @@
 namespace libiop {
 
 template<typename FieldT>
-std::vector<std::shared_ptr<std::vector<FieldT>>> get_all_oracle_evaluations(
+std::vector<std::shared_ptr<const std::vector<FieldT>>> get_all_oracle_evaluations(
     iop_protocol<FieldT> &IOP, const std::vector<oracle_handle_ptr> poly_handles)
 {
-    std::vector<std::shared_ptr<std::vector<FieldT>>> f_i_evaluations;
+    std::vector<std::shared_ptr<const std::vector<FieldT>>> f_i_evaluations;
     f_i_evaluations.reserve(poly_handles.size());
     for (size_t j = 0; j < poly_handles.size(); j++)
     {
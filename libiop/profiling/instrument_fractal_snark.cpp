@@ -260,7 +260,7 @@ int main(int argc, const char * argv[])
                 break;
             case 256:
                 libff::alt_bn128_pp::init_public_params();
-                if (default_vals.hash_enum == libiop::blake2b_type)
+                if (!libiop::is_algebraic_hash_type(default_vals.hash_enum))
                 {
                     instrument_fractal_snark<libff::alt_bn128_Fr, binary_hash_digest>(
                         default_vals, ldt_reducer_soundness_type, fri_soundness_type, optimize_localization);
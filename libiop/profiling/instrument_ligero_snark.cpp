@@ -182,7 +182,7 @@ int main(int argc, const char * argv[])
                 break;
             case 256:
                 libff::alt_bn128_pp::init_public_params();
-                if (default_vals.hash_enum == blake2b_type)
+                if (!is_algebraic_hash_type(default_vals.hash_enum))
                 {
                     instrument_ligero_snark<libff::alt_bn128_Fr, binary_hash_digest>(
                                             default_vals, ldt_reducer_soundness_type, multiplicative_coset_type,
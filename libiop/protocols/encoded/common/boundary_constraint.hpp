@@ -44,7 +44,7 @@ public:
     single_boundary_constraint(const field_subset<FieldT> &codeword_domain);
     void set_evaluation_point_and_eval(const FieldT eval_point, const FieldT oracle_eval);
     virtual std::shared_ptr<std::vector<FieldT>> evaluated_contents(
-        const std::vector<std::shared_ptr<std::vector<FieldT>>> &constituent_oracle_evaluations) const;
+        const std::vector<std::shared_ptr<const std::vector<FieldT>>> &constituent_oracle_evaluations) const;
     virtual FieldT evaluation_at_point(
         const std::size_t evaluation_position,
         const FieldT evaluation_point,
@@ -18,7 +18,7 @@ void single_boundary_constraint<FieldT>::set_evaluation_point_and_eval(
 /* Multiplies each oracle evaluation vector by the corresponding random coefficient */
 template<typename FieldT>
 std::shared_ptr<std::vector<FieldT>> single_boundary_constraint<FieldT>::evaluated_contents(
-    const std::vector<std::shared_ptr<std::vector<FieldT>>> &constituent_oracle_evaluations) const
+    const std::vector<std::shared_ptr<const std::vector<FieldT>>> &constituent_oracle_evaluations) const
 {
     if (constituent_oracle_evaluations.size() != 1)
     {
@@ -14,20 +14,25 @@ Virtual oracle for random linear combinations of other oracles
 #include <memory>
 #include <vector>
 
+#include "libiop/algebra/field_kernels.hpp"
 #include "libiop/algebra/lagrange.hpp"
+#include "libiop/iop/iop.hpp"
 
 namespace libiop {
 
 template<typename FieldT>
-class random_linear_combination_oracle : public virtual_oracle<FieldT> {
+class random_linear_combination_oracle : public pointwise_virtual_oracle<FieldT> {
 protected:
     std::vector<FieldT> random_coefficients_;
     std::size_t num_oracles_;
 public:
     random_linear_combination_oracle(const std::size_t num_oracles);
     void set_random_coefficients(const std::vector<FieldT>& random_coefficients);
-    virtual std::shared_ptr<std::vector<FieldT>> evaluated_contents(
-        const std::vector<std::shared_ptr<std::vector<FieldT>>> &constituent_oracle_evaluations) const;
+    virtual void evaluate_block(
+        const std::size_t begin,
+        const std::size_t end,
+        const std::vector<const FieldT*> &constituent_blocks,
+        FieldT *out) const;
     virtual FieldT evaluation_at_point(
         const std::size_t evaluation_position,
         const FieldT evaluation_point,
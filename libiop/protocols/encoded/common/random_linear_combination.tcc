@@ -24,35 +24,27 @@ void random_linear_combination_oracle<FieldT>::set_random_coefficients(const std
 
 /* Multiplies each oracle evaluation vector by the corresponding random coefficient */
 template<typename FieldT>
-std::shared_ptr<std::vector<FieldT>> random_linear_combination_oracle<FieldT>::evaluated_contents(
-    const std::vector<std::shared_ptr<std::vector<FieldT>>> &constituent_oracle_evaluations) const
+void random_linear_combination_oracle<FieldT>::evaluate_block(
+    const std::size_t begin,
+    const std::size_t end,
+    const std::vector<const FieldT*> &constituent_blocks,
+    FieldT *out) const
 {
-    if (constituent_oracle_evaluations.size() != this->num_oracles_)
+    if (constituent_blocks.size() != this->num_oracles_)
     {
         throw std::invalid_argument("Random Linear Combination Oracle: "
             "Expected same number of evaluations as in registration.");
     }
-    const size_t codeword_size = constituent_oracle_evaluations[0]->size();
-    std::shared_ptr<std::vector<FieldT>> result = std::make_shared<std::vector<FieldT>>();
-    result->reserve(codeword_size);
-    for (std::size_t j = 0; j < codeword_size; ++j) {
-        result->emplace_back(this->random_coefficients_[0] *
-            constituent_oracle_evaluations[0]->operator[](j));
+
+    const std::size_t block_size = end - begin;
+    for (std::size_t j = 0; j < block_size; ++j)
+    {
+        out[j] = this->random_coefficients_[0] * constituent_blocks[0][j];
     }
-    for (std::size_t i = 1; i < constituent_oracle_evaluations.size(); ++i)
+    for (std::size_t i = 1; i < constituent_blocks.size(); ++i)
     {
-        if (constituent_oracle_evaluations[i]->size() != codeword_size)
-        {
-            throw std::invalid_argument("Vectors of mismatched size.");
-        }
-        for (std::size_t j = 0; j < codeword_size; ++j)
-        {
-            result->operator[](j) +=
-                this->random_coefficients_[i] * constituent_oracle_evaluations[i]->operator[](j);
-        }
+        fma_by_constant<FieldT>(out, constituent_blocks[i], block_size, this->random_coefficients_[i]);
     }
-
-    return result;
 }
 
 /* Takes a random linear combination of the constituent oracle evaluations. */
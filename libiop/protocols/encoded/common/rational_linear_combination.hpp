@@ -20,13 +20,16 @@ Virtual oracle for linear combinations of rational oracles
 namespace libiop {
 
 template<typename FieldT>
-class combined_denominator : public virtual_oracle<FieldT> {
+class combined_denominator : public pointwise_virtual_oracle<FieldT> {
 protected:
     std::size_t num_rationals_;
 public:
     combined_denominator(const std::size_t num_rationals);
-    virtual std::shared_ptr<std::vector<FieldT>> evaluated_contents(
-        const std::vector<std::shared_ptr<std::vector<FieldT>>> &constituent_oracle_evaluations) const;
+    virtual void evaluate_block(
+        const std::size_t begin,
+        const std::size_t end,
+        const std::vector<const FieldT*> &constituent_blocks,
+        FieldT *out) const;
     virtual FieldT evaluation_at_point(
         const std::size_t evaluation_position,
         const FieldT evaluation_point,
@@ -34,7 +37,7 @@ public:
 };
 
 template<typename FieldT>
-class combined_numerator : public virtual_oracle<FieldT> {
+class combined_numerator : public pointwise_virtual_oracle<FieldT> {
 protected:
     std::vector<FieldT> coefficients_;
     std::size_t num_rationals_;
@@ -45,8 +48,11 @@ public:
      *  Suppose there are three rationals. This would return
      *      (r_1 * N_1 * D_2 * D_3) + (r_2 * N_2 * D_1 * D_3) + (r_3 * N_3 * D_1 * D_2)
      */
-    virtual std::shared_ptr<std::vector<FieldT>> evaluated_contents(
-        const std::vector<std::shared_ptr<std::vector<FieldT>>> &constituent_oracle_evaluations) const;
+    virtual void evaluate_block(
+        const std::size_t begin,
+        const std::size_t end,
+        const std::vector<const FieldT*> &constituent_blocks,
+        FieldT *out) const;
     virtual FieldT evaluation_at_point(
         const std::size_t evaluation_position,
         const FieldT evaluation_point,
@@ -76,8 +82,8 @@ public:
     void set_coefficients(const std::vector<FieldT>& coefficients);
 
     std::vector<FieldT> evaluated_contents(
-        const std::vector<std::shared_ptr<std::vector<FieldT>>> &numerator_evals,
-        const std::vector<std::shared_ptr<std::vector<FieldT>>> &denominator_evals) const;
+        const std::vector<std::shared_ptr<const std::vector<FieldT>>> &numerator_evals,
+        const std::vector<std::shared_ptr<const std::vector<FieldT>>> &denominator_evals) const;
 
     oracle_handle_ptr get_numerator_handle() const;
     oracle_handle_ptr get_denominator_handle() const;
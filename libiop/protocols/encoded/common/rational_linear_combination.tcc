@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "libiop/algebra/utils.hpp"
 
 namespace libiop {
@@ -10,29 +12,26 @@ combined_denominator<FieldT>::combined_denominator(const std::size_t num_rationa
 
 /* Returns the product of all the denominators */
 template<typename FieldT>
-std::shared_ptr<std::vector<FieldT>> combined_denominator<FieldT>::evaluated_contents(
-    const std::vector<std::shared_ptr<std::vector<FieldT>>> &constituent_oracle_evaluations) const
+void combined_denominator<FieldT>::evaluate_block(
+    const std::size_t begin,
+    const std::size_t end,
+    const std::vector<const FieldT*> &constituent_blocks,
+    FieldT *out) const
 {
-    if (constituent_oracle_evaluations.size() != this->num_rationals_)
+    if (constituent_blocks.size() != this->num_rationals_)
     {
         throw std::invalid_argument("Expected same number of evaluations as in registration.");
     }
 
-    std::shared_ptr<std::vector<FieldT>> result = std::make_shared<std::vector<FieldT>>(
-        *constituent_oracle_evaluations[0].get());
-    for (std::size_t i = 1; i < constituent_oracle_evaluations.size(); ++i)
+    const std::size_t block_size = end - begin;
+    std::copy(constituent_blocks[0], constituent_blocks[0] + block_size, out);
+    for (std::size_t i = 1; i < constituent_blocks.size(); ++i)
     {
-        if (constituent_oracle_evaluations[i]->size() != result->size())
+        for (std::size_t j = 0; j < block_size; ++j)
         {
-            throw std::invalid_argument("Vectors of mismatched size.");
-        }
-        for (std::size_t j = 0; j < result->size(); ++j)
-        {
-            result->operator[](j) *= constituent_oracle_evaluations[i]->operator[](j);
+            out[j] *= constituent_blocks[i][j];
         }
     }
-
-    return result;
 }
 
 /* Takes a random linear combination of the constituent oracle evaluations. */
@@ -78,23 +77,26 @@ void combined_numerator<FieldT>::set_coefficients(const std::vector<FieldT>& coe
 }
 
 template<typename FieldT>
-std::shared_ptr<std::vector<FieldT>> combined_numerator<FieldT>::evaluated_contents(
-    const std::vector<std::shared_ptr<std::vector<FieldT>>> &constituent_oracle_evaluations) const{
-    if (constituent_oracle_evaluations.size() != 2*this->num_rationals_)
+void combined_numerator<FieldT>::evaluate_block(
+    const std::size_t begin,
+    const std::size_t end,
+    const std::vector<const FieldT*> &constituent_blocks,
+    FieldT *out) const
+{
+    if (constituent_blocks.size() != 2*this->num_rationals_)
     {
         throw std::invalid_argument("Expected same number of evaluations as in registration.");
     }
 
-    const size_t codeword_domain_size = constituent_oracle_evaluations[0]->size();
-    std::shared_ptr<std::vector<FieldT>> result = std::make_shared<std::vector<FieldT>>(
-        codeword_domain_size, FieldT::zero());
-    for (size_t j = 0; j < codeword_domain_size; j++)
+    const std::size_t block_size = end - begin;
+    for (size_t j = 0; j < block_size; j++)
     {
+        FieldT sum = FieldT::zero();
         for (size_t i = 0; i < this->num_rationals_; i++)
         {
             FieldT cur = this->coefficients_[i];
             /** Multiply by numerator */
-            cur *= constituent_oracle_evaluations[i]->operator[](j);
+            cur *= constituent_blocks[i][j];
             /** Multiply by all other denominators */
             for (size_t k = this->num_rationals_; k < 2 * this->num_rationals_; k++)
             {
@@ -102,13 +104,12 @@ std::shared_ptr<std::vector<FieldT>> combined_numerator<FieldT>::evaluated_conte
                 {
                     continue;
                 }
-                cur *= constituent_oracle_evaluations[k]->operator[](j);
+                cur *= constituent_blocks[k][j];
             }
-            result->operator[](j) += cur;
+            sum += cur;
         }
+        out[j] = sum;
     }
-
-    return result;
 }
 
 template<typename FieldT>
@@ -199,15 +200,15 @@ void rational_linear_combination<FieldT>::set_coefficients(
 
 template<typename FieldT>
 std::vector<FieldT> rational_linear_combination<FieldT>::evaluated_contents(
-    const std::vector<std::shared_ptr<std::vector<FieldT>>> &numerator_evals,
-    const std::vector<std::shared_ptr<std::vector<FieldT>>> &denominator_evals) const
+    const std::vector<std::shared_ptr<const std::vector<FieldT>>> &numerator_evals,
+    const std::vector<std::shared_ptr<const std::vector<FieldT>>> &denominator_evals) const
 {
     std::vector<FieldT> combined_denominator_evals =
         *this->denominator_->evaluated_contents(denominator_evals).get();
     const bool denominator_can_contain_zeroes = false;
     combined_denominator_evals = batch_inverse<FieldT>(
         combined_denominator_evals, denominator_can_contain_zeroes);
-    std::vector<std::shared_ptr<std::vector<FieldT>>> all_evals;
+    std::vector<std::shared_ptr<const std::vector<FieldT>>> all_evals;
     for (size_t i = 0; i < this->num_rationals_; i++)
     {
         all_evals.emplace_back(numerator_evals[i]);
@@ -19,17 +19,22 @@ R1CS virtual rowcheck oracle
 namespace libiop {
 
 template<typename FieldT>
-class rowcheck_ABC_virtual_oracle : public virtual_oracle<FieldT> {
+class rowcheck_ABC_virtual_oracle : public pointwise_virtual_oracle<FieldT> {
 protected:
     field_subset<FieldT> codeword_domain_;
     field_subset<FieldT> constraint_domain_;
     vanishing_polynomial<FieldT> Z_;
+    /* Inverses of the distinct values of Z_H over the codeword domain, one per coset of H */
+    std::vector<FieldT> Z_inv_;
 public:
     rowcheck_ABC_virtual_oracle(const field_subset<FieldT> &codeword_domain,
                                 const field_subset<FieldT> &constraint_domain);
 
-    virtual std::shared_ptr<std::vector<FieldT>> evaluated_contents(
-        const std::vector<std::shared_ptr<std::vector<FieldT>>> &constituent_oracle_evaluations) const;
+    virtual void evaluate_block(
+        const std::size_t begin,
+        const std::size_t end,
+        const std::vector<const FieldT*> &constituent_blocks,
+        FieldT *out) const;
     virtual FieldT evaluation_at_point(
         const std::size_t evaluation_position,
         const FieldT evaluation_point,
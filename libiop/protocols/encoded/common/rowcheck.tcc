@@ -11,79 +11,47 @@ rowcheck_ABC_virtual_oracle<FieldT>::rowcheck_ABC_virtual_oracle(
     constraint_domain_(constraint_domain),
     Z_(constraint_domain)
 {
+    /** Since evaluations of Z_H repeat, we evaluate Z over its unique evaluations, and
+     *  invert those once. These evaluations are the same for every coset of H in L.
+     *  TODO: Add assert that codeword domain basis is prefixed by constraint domain basis.
+     *  We assume this in how we index domains
+     */
+    this->Z_inv_ = batch_inverse(
+        this->Z_.unique_evaluations_over_field_subset(this->codeword_domain_));
 }
 
 /** Takes as input oracles Az, Bz, Cz. */
 template<typename FieldT>
-std::shared_ptr<std::vector<FieldT>> rowcheck_ABC_virtual_oracle<FieldT>::evaluated_contents(
-    const std::vector<std::shared_ptr<std::vector<FieldT>> > &constituent_oracle_evaluations) const
+void rowcheck_ABC_virtual_oracle<FieldT>::evaluate_block(
+    const std::size_t begin,
+    const std::size_t end,
+    const std::vector<const FieldT*> &constituent_blocks,
+    FieldT *out) const
 {
-    libff::enter_block("rowcheck evaluated contents");
-    if (constituent_oracle_evaluations.size() != 3)
+    if (constituent_blocks.size() != 3)
     {
         throw std::invalid_argument("rowcheck_ABC has three constituent oracles.");
     }
 
-    const std::shared_ptr<std::vector<FieldT>> &Az = constituent_oracle_evaluations[0];
-    const std::shared_ptr<std::vector<FieldT>> &Bz = constituent_oracle_evaluations[1];
-    const std::shared_ptr<std::vector<FieldT>> &Cz = constituent_oracle_evaluations[2];
-    /** Since evaluations of Z_H repeat, we evaluate Z over its unique evaluations
-     *  Invert those evaluations, and use those within building the final codeword.
-     *  These evaluations are the same for every coset of H in L.
-     *  TODO: Add assert that codeword domain basis is prefixed by constraint domain basis.
-     *  We assume this in how we index domains
-     */
-    const std::vector<FieldT> &Z_inv = batch_inverse(
-        this->Z_.unique_evaluations_over_field_subset(this->codeword_domain_));
+    const FieldT *Az = constituent_blocks[0];
+    const FieldT *Bz = constituent_blocks[1];
+    const FieldT *Cz = constituent_blocks[2];
 
-    const size_t n = this->codeword_domain_.num_elements();
     const size_t order_H = this->constraint_domain_.num_elements();
-    const size_t num_cosets_of_H = n / order_H;
-    std::shared_ptr<std::vector<FieldT>> result = std::make_shared<std::vector<FieldT>>();
-    result->reserve(n);
+    const size_t num_cosets_of_H = this->codeword_domain_.num_elements() / order_H;
 
     /** We compute result(x) = Z_H(x)^{-1} (Az(x) * Bz(x) - Cz(x)))
      *  Since we want to optimize and use Z_H being a k to 1 map,
-     *  we have to split up the additive and multiplicative cases.*/
-    if (this->codeword_domain_.type() == multiplicative_coset_type)
-    {
-        /** We iterate over all elements in order.
-         *  We use 2 loops, so we always know which coset a particular position is in.
-         *  The outer loop specifies that we are looking at the ith element of a coset.
-         *  The inner loop specifies which coset we are looking at,
-         *  and consequently what its vanishing polynomial evaluation is.
-        */
-        for (size_t i = 0; i < order_H; i++)
-        {
-            for (size_t j = 0; j < num_cosets_of_H; j++)
-            {
-                const size_t cur_pos = i*num_cosets_of_H + j;
-                result->emplace_back(Z_inv[j] * (
-                    Az->operator[](cur_pos) * Bz->operator[](cur_pos) - Cz->operator[](cur_pos)));
-            }
-        }
-    }
-    else if (this->codeword_domain_.type() == affine_subspace_type)
+     *  we have to split up the additive and multiplicative cases.
+     *  In the multiplicative case, the ith element of each coset is at position i*num_cosets_of_H + j,
+     *  for coset j. In the additive case, coset i occupies positions [i * order_H, (i+1) * order_H). */
+    const bool is_multiplicative = (this->codeword_domain_.type() == multiplicative_coset_type);
+    for (size_t j = 0; j < end - begin; j++)
     {
-        /** We iterate over all elements in order.
-         *  We use 2 loops, so we always know which coset a particular position is in.
-         *  The outer loop specifies which coset we are looking at.
-         *  The inner loop ranges over all elements of that coset.
-         */
-        for (size_t i = 0; i < num_cosets_of_H; i++)
-        {
-            const FieldT Z_inv_val = Z_inv[i];
-            const size_t coset_pos_upper_bound = (i + 1) * order_H;
-            for (size_t cur_pos = i * order_H;
-                cur_pos < coset_pos_upper_bound; cur_pos++)
-            {
-                result->emplace_back(Z_inv_val *
-                    (Az->operator[](cur_pos) * Bz->operator[](cur_pos) - Cz->operator[](cur_pos)));
-            }
-        }
+        const size_t cur_pos = begin + j;
+        const size_t coset = is_multiplicative ? (cur_pos % num_cosets_of_H) : (cur_pos / order_H);
+        out[j] = this->Z_inv_[coset] * (Az[j] * Bz[j] - Cz[j]);
     }
-    libff::leave_block("rowcheck evaluated contents");
-    return result;
 }
 
 template<typename FieldT>
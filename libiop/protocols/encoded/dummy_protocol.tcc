@@ -14,7 +14,7 @@ dummy_oracle<FieldT>::dummy_oracle(const std::size_t num_oracles) :
 
 template<typename FieldT>
 std::shared_ptr<std::vector<FieldT>> dummy_oracle<FieldT>::evaluated_contents(
-    const std::vector<std::shared_ptr<std::vector<FieldT>>> &constituent_oracle_evaluations) const
+    const std::vector<std::shared_ptr<const std::vector<FieldT>>> &constituent_oracle_evaluations) const
 {
     if (constituent_oracle_evaluations.size() != this->num_oracles_)
     {
@@ -17,7 +17,7 @@ interleaved_lincheck_et_protocol<FieldT>::interleaved_lincheck_et_protocol(
     const std::size_t num_interactions,
     const bool make_zk,
     const field_subset_type domain_type,
-    const naive_sparse_matrix<FieldT> constraint_matrix,
+    const csr_sparse_matrix<FieldT> &constraint_matrix,
     const std::vector<FieldT> target_vector) :
     IOP_(IOP),
     codeword_domain_handle_(codeword_domain_handle),
@@ -66,7 +66,7 @@ void interleaved_lincheck_et_protocol<FieldT>::register_linear_combinations()
     this->random_linear_combination_handles_.resize(this->num_interactions_);
     for (size_t i = 0; i < this->num_interactions_; ++i)
     {
-        this->random_linear_combination_handles_[i] = this->IOP_.register_verifier_random_message(this->constraint_matrix_.size());
+        this->random_linear_combination_handles_[i] = this->IOP_.register_verifier_random_message(this->constraint_matrix_.num_rows());
     }
 }
 
@@ -151,18 +151,9 @@ void interleaved_lincheck_et_protocol<FieldT>::calculate_and_submit_responses()
 
         /** Multiply constraint matrix by random values, to build a
          * vector of s_i evaluations */
-        std::vector<FieldT> row_vector(this->num_oracles_ * this->systematic_domain_size_, FieldT(0));
-        for (size_t j = 0; j < this->constraint_matrix_.size(); ++j)
-        {
-            std::map<std::size_t, FieldT> row = this->constraint_matrix_[j];
-            typename std::map<std::size_t, FieldT>::iterator it;
-            for (it = row.begin(); it != row.end(); it++)
-            {
-                const std::size_t idx = it->first;
-                const FieldT val = it->second;
-                row_vector[idx] += random_linear_combination[j] * val;
-            }
-        }
+        std::vector<FieldT> row_vector =
+            this->constraint_matrix_.transpose_multiply(random_linear_combination);
+        row_vector.resize(this->num_oracles_ * this->systematic_domain_size_, FieldT(0));
 
         for (size_t j = 0; j < this->num_oracles_; ++j)
         {
@@ -178,7 +169,7 @@ void interleaved_lincheck_et_protocol<FieldT>::calculate_and_submit_responses()
             const std::vector<FieldT> current_evaluations =
                 FFT_over_field_subset<FieldT>(poly_coefficients, this->codeword_domain_);
 
-            const std::shared_ptr<std::vector<FieldT>> row_evaluations =
+            const std::shared_ptr<const std::vector<FieldT>> row_evaluations =
                 this->IOP_.get_oracle_evaluations(this->input_vector_row_oracle_handles_[j]);
 
             for (size_t a = 0; a < this->codeword_domain_size_; ++a)
@@ -189,7 +180,7 @@ void interleaved_lincheck_et_protocol<FieldT>::calculate_and_submit_responses()
 
         if (this->make_zk_)
         {
-            const std::shared_ptr<std::vector<FieldT>> blinding_vec =
+            const std::shared_ptr<const std::vector<FieldT>> blinding_vec =
                 this->IOP_.get_oracle_evaluations(this->blinding_vector_row_oracle_handles_[i]);
             for (size_t a = 0; a < this->codeword_domain_size_; ++a)
             {
@@ -266,18 +257,9 @@ bool interleaved_lincheck_et_protocol<FieldT>::verifier_predicate()
         std::vector<polynomial<FieldT>> randomized_matrix_row_polys;
 
         /* Multiply matrix by random values. */
-        std::vector<FieldT> randomized_constraint_matrix(this->num_oracles_ * this->systematic_domain_size_, FieldT(0));
-        for (size_t j = 0; j < this->constraint_matrix_.size(); ++j)
-        {
-            std::map<std::size_t, FieldT> row = this->constraint_matrix_[j];
-            typename std::map<std::size_t, FieldT>::iterator it;
-            for (it = row.begin(); it != row.end(); it++)
-            {
-                const std::size_t idx = it->first;
-                const FieldT val = it->second;
-                randomized_constraint_matrix[idx] += random_linear_combination[j] * val;
-            }
-        }
+        std::vector<FieldT> randomized_constraint_matrix =
+            this->constraint_matrix_.transpose_multiply(random_linear_combination);
+        randomized_constraint_matrix.resize(this->num_oracles_ * this->systematic_domain_size_, FieldT(0));
 
         /* Split vector into rows over the systematic domain, to interpolate into polynomials (for
            the consistency test). */
@@ -20,6 +20,7 @@
 #include "libiop/algebra/field_subset/subspace.hpp"
 #include "libiop/iop/iop.hpp"
 #include "libiop/relations/r1cs.hpp"
+#include "libiop/relations/sparse_matrix.hpp"
 
 namespace libiop {
 
@@ -47,7 +48,7 @@ protected:
     const bool make_zk_;
     const field_subset_type field_subset_type_;
 
-    const naive_sparse_matrix<FieldT> constraint_matrix_;
+    const csr_sparse_matrix<FieldT> constraint_matrix_;
 
     std::vector<verifier_random_message_handle> random_linear_combination_handles_;
     std::vector<prover_message_handle> response_handles_;
@@ -72,7 +73,7 @@ public:
                                      const std::size_t num_interactions,
                                      const bool make_zk,
                                      const field_subset_type domain_type,
-                                     const naive_sparse_matrix<FieldT> constraint_matrix);
+                                     const csr_sparse_matrix<FieldT> &constraint_matrix);
     void attach_input_vector_row_oracles(const std::vector<oracle_handle_ptr> &handles);
     void attach_target_vector_row_oracles(const std::vector<oracle_handle_ptr> &handles);
     void attach_blinding_vector_row_oracles(const std::vector<oracle_handle_ptr> &handles);
@@ -20,7 +20,7 @@ interleaved_lincheck_ot_protocol<FieldT>::interleaved_lincheck_ot_protocol(
     const std::size_t num_interactions,
     const bool make_zk,
     const field_subset_type domain_type,
-    const naive_sparse_matrix<FieldT> constraint_matrix) :
+    const csr_sparse_matrix<FieldT> &constraint_matrix) :
     IOP_(IOP),
     codeword_domain_handle_(codeword_domain_handle),
     systematic_domain_handle_(systematic_domain_handle),
@@ -76,7 +76,7 @@ void interleaved_lincheck_ot_protocol<FieldT>::register_linear_combinations()
     this->random_linear_combination_handles_.resize(this->num_interactions_);
     for (size_t i = 0; i < this->num_interactions_; ++i)
     {
-        this->random_linear_combination_handles_[i] = this->IOP_.register_verifier_random_message(this->constraint_matrix_.size());
+        this->random_linear_combination_handles_[i] = this->IOP_.register_verifier_random_message(this->constraint_matrix_.num_rows());
     }
 }
 
@@ -266,18 +266,9 @@ void interleaved_lincheck_ot_protocol<FieldT>::calculate_and_submit_responses(co
         /** Set row vector to be the concatenation of evaluations of s_i in the systematic domain.
          * It can be thought of as a flattened matrix with num_oracles_input rows, and
          * systematic_domain_size columns, where each row is the evaluations for a given s_i. */
-        std::vector<FieldT> row_vector(this->num_oracles_input_ * this->systematic_domain_size_, FieldT(0));
-        for (size_t j = 0; j < this->constraint_matrix_.size(); ++j)
-        {
-            std::map<std::size_t, FieldT> row = this->constraint_matrix_[j];
-            typename std::map<std::size_t, FieldT>::iterator it;
-            for (it = row.begin(); it != row.end(); it++)
-            {
-                const std::size_t idx = it->first;
-                const FieldT val = it->second;
-                row_vector[idx] += random_linear_combination[j] * val;
-            }
-        }
+        std::vector<FieldT> row_vector =
+            this->constraint_matrix_.transpose_multiply(random_linear_combination);
+        row_vector.resize(this->num_oracles_input_ * this->systematic_domain_size_, FieldT(0));
 
         /** handles creating the component of p for
          *  the sum over all output oracles: r_i * f_{x,i} */
@@ -296,7 +287,7 @@ void interleaved_lincheck_ot_protocol<FieldT>::calculate_and_submit_responses(co
             const std::vector<FieldT> current_evaluations =
                 FFT_over_field_subset<FieldT>(poly_coefficients, this->codeword_domain_);
 
-            const std::shared_ptr<std::vector<FieldT>> row_evaluations =
+            const std::shared_ptr<const std::vector<FieldT>> row_evaluations =
                 this->IOP_.get_oracle_evaluations(this->target_vector_row_oracle_handles_[i]);
 
             for (size_t a = 0; a < this->codeword_domain_size_; ++a)
@@ -322,7 +313,7 @@ void interleaved_lincheck_ot_protocol<FieldT>::calculate_and_submit_responses(co
             const std::vector<FieldT> current_evaluations =
                 FFT_over_field_subset<FieldT>(poly_coefficients, this->codeword_domain_);
 
-            const std::shared_ptr<std::vector<FieldT>> row_evaluations =
+            const std::shared_ptr<const std::vector<FieldT>> row_evaluations =
                 this->IOP_.get_oracle_evaluations(this->input_vector_row_oracle_handles_[i]);
 
             for (size_t a = 0; a < this->codeword_domain_size_; ++a)
@@ -334,7 +325,7 @@ void interleaved_lincheck_ot_protocol<FieldT>::calculate_and_submit_responses(co
 
         if (this->make_zk_)
         {
-            const std::shared_ptr<std::vector<FieldT>> blinding_vec =
+            const std::shared_ptr<const std::vector<FieldT>> blinding_vec =
                 this->IOP_.get_oracle_evaluations(this->blinding_vector_row_oracle_handles_[h]);
             for (size_t a = 0; a < this->codeword_domain_size_; ++a)
             {
@@ -513,18 +504,9 @@ bool interleaved_lincheck_ot_protocol<FieldT>::verifier_predicate(const std::vec
         }
 
         /* Multiply matrix by random values. (building s_i) */
-        std::vector<FieldT> randomized_matrix_vector(this->num_oracles_input_ * this->systematic_domain_size_, FieldT(0));
-        for (size_t j = 0; j < this->constraint_matrix_.size(); ++j)
-        {
-            std::map<std::size_t, FieldT> row = this->constraint_matrix_[j];
-            typename std::map<std::size_t, FieldT>::iterator it;
-            for (it = row.begin(); it != row.end(); it++)
-            {
-                const std::size_t idx = it->first;
-                const FieldT val = it->second;
-                randomized_matrix_vector[idx] += random_linear_combination[j] * val;
-            }
-        }
+        std::vector<FieldT> randomized_matrix_vector =
+            this->constraint_matrix_.transpose_multiply(random_linear_combination);
+        randomized_matrix_vector.resize(this->num_oracles_input_ * this->systematic_domain_size_, FieldT(0));
 
         /* Split vector into rows over the systematic domain, to interpolate into polynomials (for
            the consistency test). */
@@ -166,13 +166,13 @@ void interleaved_rowcheck_protocol<FieldT>::calculate_and_submit_responses()
         /** Build the response polynomial's evaluations row by row. */
         for (size_t i = 0; i < this->num_oracles_; ++i)
         {
-            const std::shared_ptr<std::vector<FieldT>> p_x_row_evaluations =
+            const std::shared_ptr<const std::vector<FieldT>> p_x_row_evaluations =
                 this->IOP_.get_oracle_evaluations(this->x_vector_row_oracle_handles_[i]);
 
-            const std::shared_ptr<std::vector<FieldT>> p_y_row_evaluations =
+            const std::shared_ptr<const std::vector<FieldT>> p_y_row_evaluations =
                 this->IOP_.get_oracle_evaluations(this->y_vector_row_oracle_handles_[i]);
 
-            const std::shared_ptr<std::vector<FieldT>> p_z_row_evaluations =
+            const std::shared_ptr<const std::vector<FieldT>> p_z_row_evaluations =
                 this->IOP_.get_oracle_evaluations(this->z_vector_row_oracle_handles_[i]);
 
             /** For each column, add to that column's corresponding response polynomial evaluation
@@ -188,7 +188,7 @@ void interleaved_rowcheck_protocol<FieldT>::calculate_and_submit_responses()
 
         if (this->make_zk_)
         {
-            const std::shared_ptr<std::vector<FieldT>> blinding_vec =
+            const std::shared_ptr<const std::vector<FieldT>> blinding_vec =
                 this->IOP_.get_oracle_evaluations(this->blinding_vector_row_oracle_handles_[h]);
             for (size_t i = 0; i < this->codeword_domain_size_; ++i)
             {
@@ -14,6 +14,7 @@
 
 #include "libiop/iop/iop.hpp"
 #include "libiop/relations/r1cs.hpp"
+#include "libiop/relations/sparse_matrix.hpp"
 
 #include <libff/algebra/field_utils/field_utils.hpp>
 #include "libiop/algebra/field_subset/subgroup.hpp"
@@ -87,9 +88,9 @@ protected:
     std::vector<oracle_handle_ptr> lincheck_C_blinding_vector_handles_;
     std::vector<oracle_handle_ptr> rowcheck_blinding_vector_handles_;
 
-    naive_sparse_matrix<FieldT> A_matrix_;
-    naive_sparse_matrix<FieldT> B_matrix_;
-    naive_sparse_matrix<FieldT> C_matrix_;
+    csr_sparse_matrix<FieldT> A_matrix_;
+    csr_sparse_matrix<FieldT> B_matrix_;
+    csr_sparse_matrix<FieldT> C_matrix_;
 public:
     /* Initialization and registration */
     interleaved_r1cs_protocol(iop_protocol<FieldT> &IOP,
@@ -51,14 +51,14 @@ interleaved_r1cs_protocol<FieldT>::interleaved_r1cs_protocol(
     libff::print_indent(); printf("num oracles for vectors / R1CS constraints (m_2): %zu\n", this->num_oracles_vectors_);
 
     /* Get R1CS matrices */
-    this->A_matrix_ = this->constraint_system_.A_matrix();
-    this->B_matrix_ = this->constraint_system_.B_matrix();
-    this->C_matrix_ = this->constraint_system_.C_matrix();
+    this->A_matrix_ = csr_sparse_matrix<FieldT>(this->constraint_system_, r1cs_sparse_matrix_A);
+    this->B_matrix_ = csr_sparse_matrix<FieldT>(this->constraint_system_, r1cs_sparse_matrix_B);
+    this->C_matrix_ = csr_sparse_matrix<FieldT>(this->constraint_system_, r1cs_sparse_matrix_C);
 
     /* Add extra rows */
-    this->A_matrix_.resize(this->matrix_height_);
-    this->B_matrix_.resize(this->matrix_height_);
-    this->C_matrix_.resize(this->matrix_height_);
+    this->A_matrix_.pad_rows(this->matrix_height_);
+    this->B_matrix_.pad_rows(this->matrix_height_);
+    this->C_matrix_.pad_rows(this->matrix_height_);
 
     this->lincheck_A_.reset(new interleaved_lincheck_ot_protocol<FieldT>(this->IOP_,
                                                                          this->codeword_domain_handle_,
@@ -244,62 +244,27 @@ void interleaved_r1cs_protocol<FieldT>::submit_witness_oracles(const r1cs_primar
     libff::leave_block("Generate extended witness and auxiliary witness");
 
     libff::enter_block("Perform matrix multiplications");
-    std::vector<FieldT> a_result_vector;
-    for (size_t i = 0; i < this->matrix_height_; ++i)
-    {
-        FieldT sum(0);
-        std::map<std::size_t, FieldT> row = this->A_matrix_[i];
-        typename std::map<std::size_t, FieldT>::iterator it;
-        for (it = row.begin(); it != row.end(); it++)
-        {
-            std::size_t idx = it->first;
-            FieldT val = it->second;
-            sum += val * extended_witness[idx];
-        }
-        a_result_vector.push_back(sum);
-    }
-
-    std::vector<FieldT> b_result_vector;
-    for (size_t i = 0; i < this->matrix_height_; ++i)
-    {
-        FieldT sum(0);
-        std::map<std::size_t, FieldT> row = this->B_matrix_[i];
-        typename std::map<std::size_t, FieldT>::iterator it;
-        for (it = row.begin(); it != row.end(); it++)
-        {
-            std::size_t idx = it->first;
-            FieldT val = it->second;
-            sum += val * extended_witness[idx];
-        }
-        b_result_vector.push_back(sum);
-    }
-
-    std::vector<FieldT> c_result_vector;
-    for (size_t i = 0; i < this->matrix_height_; ++i)
-    {
-        FieldT sum(0);
-        std::map<std::size_t, FieldT> row = this->C_matrix_[i];
-        typename std::map<std::size_t, FieldT>::iterator it;
-        for (it = row.begin(); it != row.end(); it++)
-        {
-            std::size_t idx = it->first;
-            FieldT val = it->second;
-            sum += val * extended_witness[idx];
-        }
-        c_result_vector.push_back(sum);
-    }
+    const std::vector<FieldT> a_result_vector = this->A_matrix_.multiply(extended_witness);
+    const std::vector<FieldT> b_result_vector = this->B_matrix_.multiply(extended_witness);
+    const std::vector<FieldT> c_result_vector = this->C_matrix_.multiply(extended_witness);
     libff::leave_block("Perform matrix multiplications");
 
+    /* All rows are encoded over the same pair of domains, so they are transformed in batches */
     libff::enter_block("Submit input oracles");
+    std::vector<std::vector<FieldT>> w_rows;
+    w_rows.reserve(this->num_oracles_input_);
     for (size_t i = 0; i < this->num_oracles_input_; ++i)
     {
         const std::size_t start = i * this->systematic_domain_size_;
         const std::size_t end = start + this->systematic_domain_size_;
 
-        const std::vector<FieldT> w_row(&auxiliary_only_witness[start], &auxiliary_only_witness[end]);
-        const std::vector<FieldT> w_row_coefficients =
-            IFFT_over_field_subset<FieldT>(w_row, this->systematic_domain_);
-        oracle<FieldT> w_row_oracle(FFT_over_field_subset(w_row_coefficients, this->codeword_domain_));
+        w_rows.emplace_back(&auxiliary_only_witness[start], &auxiliary_only_witness[end]);
+    }
+    std::vector<std::vector<FieldT>> w_rows_over_codeword_domain = batch_FFT_over_field_subset<FieldT>(
+        batch_IFFT_over_field_subset<FieldT>(w_rows, this->systematic_domain_), this->codeword_domain_);
+    for (size_t i = 0; i < this->num_oracles_input_; ++i)
+    {
+        oracle<FieldT> w_row_oracle(std::move(w_rows_over_codeword_domain[i]));
         this->IOP_.submit_oracle(this->w_vector_handles_[i], std::move(w_row_oracle));
     }
     libff::leave_block("Submit input oracles");
@@ -310,22 +275,20 @@ void interleaved_r1cs_protocol<FieldT>::submit_witness_oracles(const r1cs_primar
         const std::size_t start = i * this->systematic_domain_size_;
         const std::size_t end = start + this->systematic_domain_size_;
 
-        const std::vector<FieldT> a_row(&a_result_vector[start], &a_result_vector[end]);
-        const std::vector<FieldT> a_row_coefficients =
-            IFFT_over_field_subset<FieldT>(a_row, this->systematic_domain_);
-        oracle<FieldT> a_row_oracle(FFT_over_field_subset(a_row_coefficients, this->codeword_domain_));
+        const std::vector<std::vector<FieldT>> abc_rows({
+            std::vector<FieldT>(&a_result_vector[start], &a_result_vector[end]),
+            std::vector<FieldT>(&b_result_vector[start], &b_result_vector[end]),
+            std::vector<FieldT>(&c_result_vector[start], &c_result_vector[end])});
+        std::vector<std::vector<FieldT>> abc_rows_over_codeword_domain = batch_FFT_over_field_subset<FieldT>(
+            batch_IFFT_over_field_subset<FieldT>(abc_rows, this->systematic_domain_), this->codeword_domain_);
+
+        oracle<FieldT> a_row_oracle(std::move(abc_rows_over_codeword_domain[0]));
         this->IOP_.submit_oracle(this->a_vector_handles_[i], std::move(a_row_oracle));
 
-        const std::vector<FieldT> b_row(&b_result_vector[start], &b_result_vector[end]);
-        const std::vector<FieldT> b_row_coefficients =
-            IFFT_over_field_subset<FieldT>(b_row, this->systematic_domain_);
-        oracle<FieldT> b_row_oracle(FFT_over_field_subset(b_row_coefficients, this->codeword_domain_));
+        oracle<FieldT> b_row_oracle(std::move(abc_rows_over_codeword_domain[1]));
         this->IOP_.submit_oracle(this->b_vector_handles_[i], std::move(b_row_oracle));
 
-        const std::vector<FieldT> c_row(&c_result_vector[start], &c_result_vector[end]);
-        const std::vector<FieldT> c_row_coefficients =
-            IFFT_over_field_subset<FieldT>(c_row, this->systematic_domain_);
-        oracle<FieldT> c_row_oracle(FFT_over_field_subset(c_row_coefficients, this->codeword_domain_));
+        oracle<FieldT> c_row_oracle(std::move(abc_rows_over_codeword_domain[2]));
         this->IOP_.submit_oracle(this->c_vector_handles_[i], std::move(c_row_oracle));
     }
     libff::leave_block("Submit vector oracles");
@@ -16,6 +16,7 @@ Basic R1CS multi lincheck virtual oracle
 
 #include "libiop/relations/sparse_matrix.hpp"
 #include "libiop/algebra/lagrange.hpp"
+#include "libiop/common/parallel.hpp"
 #include "libiop/iop/iop.hpp"
 
 
@@ -68,7 +69,7 @@ public:
     void set_challenge(const FieldT &alpha, const std::vector<FieldT> r_Mz);
 
     virtual std::shared_ptr<std::vector<FieldT>> evaluated_contents(
-        const std::vector<std::shared_ptr<std::vector<FieldT>>> &constituent_oracle_evaluations) const;
+        const std::vector<std::shared_ptr<const std::vector<FieldT>>> &constituent_oracle_evaluations) const;
     virtual FieldT evaluation_at_point(
         const std::size_t evaluation_position,
         const FieldT evaluation_point,
@@ -65,22 +65,20 @@ void multi_lincheck_virtual_oracle<FieldT>::set_challenge(const FieldT &alpha, c
         this->summation_domain_.num_elements(), FieldT::zero());
     for (std::size_t m_index = 0; m_index < this->matrices_.size(); m_index++)
     {
-        const std::shared_ptr<sparse_matrix<FieldT>> M = this->matrices_[m_index];
-        // M is cons_domain X var_domain
-        for (std::size_t i = 0; i < this->constraint_domain_.num_elements(); i++)
+        // M is cons_domain X var_domain, so this is sum_i alpha^i M_{i,j} for each column j
+        const std::vector<FieldT> alpha_M = this->matrices_[m_index]->transpose_multiply(alpha_powers);
+        for (std::size_t j = 0; j < alpha_M.size(); j++)
         {
-            const linear_combination<FieldT> row = M->get_row(i);
-
-            for (auto &term : row.terms)
+            if (alpha_M[j] == FieldT::zero())
             {
-                // TODO: Could we instead pass in domains that had this reindexing handled already within them?
-                const std::size_t variable_index = this->variable_domain_.reindex_by_subset(
-                    this->input_variable_dim_, term.index_);
-                const std::size_t summation_index = this->summation_domain_.reindex_by_subset(
-                    this->variable_domain_.dimension(), variable_index);
-                p_alpha_ABC_evals[summation_index] +=
-                    this->r_Mz_[m_index] * term.coeff_ * alpha_powers[i];
+                continue;
             }
+            // TODO: Could we instead pass in domains that had this reindexing handled already within them?
+            const std::size_t variable_index = this->variable_domain_.reindex_by_subset(
+                this->input_variable_dim_, j);
+            const std::size_t summation_index = this->summation_domain_.reindex_by_subset(
+                this->variable_domain_.dimension(), variable_index);
+            p_alpha_ABC_evals[summation_index] += this->r_Mz_[m_index] * alpha_M[j];
         }
     }
     libff::leave_block("multi_lincheck compute p_alpha_ABC");
@@ -100,7 +98,7 @@ void multi_lincheck_virtual_oracle<FieldT>::set_challenge(const FieldT &alpha, c
 
 template<typename FieldT>
 std::shared_ptr<std::vector<FieldT>> multi_lincheck_virtual_oracle<FieldT>::evaluated_contents(
-    const std::vector<std::shared_ptr<std::vector<FieldT>>> &constituent_oracle_evaluations) const
+    const std::vector<std::shared_ptr<const std::vector<FieldT>>> &constituent_oracle_evaluations) const
 {
     libff::enter_block("multi_lincheck evaluated contents");
     if (constituent_oracle_evaluations.size() != this->matrices_.size() + 1)
@@ -118,26 +116,21 @@ std::shared_ptr<std::vector<FieldT>> multi_lincheck_virtual_oracle<FieldT>::eval
 
     const std::size_t n = this->codeword_domain_.num_elements();
 
-    const std::shared_ptr<std::vector<FieldT>> &fz = constituent_oracle_evaluations[0];
-    /* Random linear combination of Mz's */
-    std::vector<FieldT> f_combined_Mz(n, FieldT::zero());
-    for (std::size_t i = 0; i < n; i++) {
-        for (std::size_t m = 0; m < this->matrices_.size(); m++) {
-            f_combined_Mz[i] += this->r_Mz_[m] * constituent_oracle_evaluations[m + 1]->operator[](i);
-        }
-    }
-
-    // TODO: Investigate if combining these loops improves speed.
-    // It would improve cache efficiency, but its not immediate how it will affect compiler optimizations
-    // (re-structuring loop for data parallelism, unrolling, etc.)
-    // However, this time may become negligible after making the result over an intermediate sumcheck domain
-    std::shared_ptr<std::vector<FieldT>> result = std::make_shared<std::vector<FieldT>>();
-    result->reserve(n);
+    const std::shared_ptr<const std::vector<FieldT>> &fz = constituent_oracle_evaluations[0];
+    /* Random linear combination of Mz's, combined with the rest of the result in the same pass */
+    std::shared_ptr<std::vector<FieldT>> result = std::make_shared<std::vector<FieldT>>(n);
+#ifdef MULTICORE
+    #pragma omp parallel for if (n >= parallel_min_size)
+#endif
     for (std::size_t i = 0; i < n; ++i)
     {
-        result->emplace_back(
-            f_combined_Mz[i] * p_alpha_prime_over_codeword_domain[i] -
-            fz->operator[](i) * p_alpha_ABC_over_codeword_domain[i]);
+        FieldT f_combined_Mz = FieldT::zero();
+        for (std::size_t m = 0; m < this->matrices_.size(); m++) {
+            f_combined_Mz += this->r_Mz_[m] * constituent_oracle_evaluations[m + 1]->operator[](i);
+        }
+        result->operator[](i) =
+            f_combined_Mz * p_alpha_prime_over_codeword_domain[i] -
+            fz->operator[](i) * p_alpha_ABC_over_codeword_domain[i];
     }
     libff::leave_block("multi_lincheck evaluated contents");
     return result;
@@ -12,20 +12,17 @@ std::vector<FieldT> compute_p_alpha_M(
         summation_domain.num_elements(), FieldT::zero());
     for (std::size_t m_index = 0; m_index < matrices.size(); m_index++)
     {
-        const std::shared_ptr<sparse_matrix<FieldT>> M = matrices[m_index];
-        // M is cons_domain X var_domain
-        for (std::size_t i = 0; i < summation_domain.num_elements(); i++)
+        // M is cons_domain X var_domain, so this is sum_i p_alpha(h_i) M_{i,j} for each column j
+        const std::vector<FieldT> p_alpha_times_M = matrices[m_index]->transpose_multiply(p_alpha_over_H);
+        for (std::size_t j = 0; j < p_alpha_times_M.size(); j++)
         {
-            const linear_combination<FieldT> row = M->get_row(i);
-
-            for (auto &term : row.terms)
+            if (p_alpha_times_M[j] == FieldT::zero())
             {
-                const std::size_t summation_index = summation_domain.reindex_by_subset(
-                    input_variable_dim, term.index_);
-                // TODO: Change this to only do |H| multiplications by r_Mz
-                p_alpha_M_over_H[summation_index] +=
-                    r_Mz[m_index] * term.coeff_ * p_alpha_over_H[i];
+                continue;
             }
+            const std::size_t summation_index = summation_domain.reindex_by_subset(
+                input_variable_dim, j);
+            p_alpha_M_over_H[summation_index] += r_Mz[m_index] * p_alpha_times_M[j];
         }
     }
     libff::enter_block("multi_lincheck IFFT p_alpha_M");
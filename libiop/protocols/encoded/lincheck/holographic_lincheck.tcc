@@ -420,14 +420,14 @@ void holographic_multi_lincheck<FieldT>::calculate_response_alpha()
 }
 
 template<typename FieldT>
-std::vector<std::shared_ptr<std::vector<FieldT>>> convert_to_shared(
+std::vector<std::shared_ptr<const std::vector<FieldT>>> convert_to_shared(
     std::vector<std::vector<FieldT>> vec)
 {
-    std::vector<std::shared_ptr<std::vector<FieldT>>> result;
+    std::vector<std::shared_ptr<const std::vector<FieldT>>> result;
     for (size_t i = 0; i < vec.size(); i++)
     {
         result.emplace_back(
-            std::make_shared<std::vector<FieldT>>(std::move(vec[i])));
+            std::make_shared<const std::vector<FieldT>>(std::move(vec[i])));
     }
     return result;
 }
@@ -445,8 +445,8 @@ void holographic_multi_lincheck<FieldT>::calculate_response_beta()
             this->beta_handle_[repetition])[0];
         /** We have to compute the combined rational function over K,
          *  to pass into rational sumcheck.    */
-        std::vector<std::shared_ptr<std::vector<FieldT>>> numerator_oracles_over_K;
-        std::vector<std::shared_ptr<std::vector<FieldT>>> denominator_oracles_over_K;
+        std::vector<std::shared_ptr<const std::vector<FieldT>>> numerator_oracles_over_K;
+        std::vector<std::shared_ptr<const std::vector<FieldT>>> denominator_oracles_over_K;
         libff::enter_block("Compute rational function over K");
         for (size_t i = 0; i < this->num_matrices_; i++)
         {
@@ -458,7 +458,7 @@ void holographic_multi_lincheck<FieldT>::calculate_response_beta()
                 this->codeword_domain_handle_,
                 this->input_variable_dim_,
                 this->matrices_[i]);
-            std::vector<std::shared_ptr<std::vector<FieldT>>> index_evals_over_K =
+            std::vector<std::shared_ptr<const std::vector<FieldT>>> index_evals_over_K =
                 convert_to_shared<FieldT>(indexer.compute_oracles_over_K());
 
             numerator_oracles_over_K.emplace_back(index_evals_over_K[2]);
@@ -29,7 +29,7 @@ void holographic_multi_lincheck_virtual_oracle<FieldT>::set_challenge(const Fiel
 
 template<typename FieldT>
 std::shared_ptr<std::vector<FieldT>> holographic_multi_lincheck_virtual_oracle<FieldT>::evaluated_contents(
-    const std::vector<std::shared_ptr<std::vector<FieldT>>> &constituent_oracle_evaluations) const
+    const std::vector<std::shared_ptr<const std::vector<FieldT>>> &constituent_oracle_evaluations) const
 {
     libff::enter_block("multi_lincheck evaluated contents");
     if (constituent_oracle_evaluations.size() != this->matrices_.size() + 2)
@@ -43,7 +43,7 @@ std::shared_ptr<std::vector<FieldT>> holographic_multi_lincheck_virtual_oracle<F
 
     const std::size_t n = this->codeword_domain_.num_elements();
 
-    const std::shared_ptr<std::vector<FieldT>> &fz = constituent_oracle_evaluations[0];
+    const std::shared_ptr<const std::vector<FieldT>> &fz = constituent_oracle_evaluations[0];
     /* Random linear combination of Mz's */
     std::vector<FieldT> f_combined_Mz(n, FieldT::zero());
     for (std::size_t i = 0; i < n; i++) {
@@ -114,7 +114,7 @@ void single_matrix_denominator<FieldT>::set_challenge(
 
 template<typename FieldT>
 std::shared_ptr<std::vector<FieldT>> single_matrix_denominator<FieldT>::evaluated_contents(
-    const std::vector<std::shared_ptr<std::vector<FieldT>>> &constituent_oracle_evaluations) const
+    const std::vector<std::shared_ptr<const std::vector<FieldT>>> &constituent_oracle_evaluations) const
 {
     if (constituent_oracle_evaluations.size() != 3)
     {
@@ -79,10 +79,18 @@ std::vector<std::vector<FieldT>> matrix_indexer<FieldT>::compute_oracles_over_K(
     val_evals.reserve(this->index_domain_.num_elements());
     row_times_col_evals.reserve(this->index_domain_.num_elements());
 
+    /* R1CS rows are read in place, other matrices are copied one row at a time */
+    const std::shared_ptr<const r1cs_sparse_matrix<FieldT>> r1cs_matrix =
+        std::dynamic_pointer_cast<const r1cs_sparse_matrix<FieldT>>(this->matrix_);
+    linear_combination<FieldT> copied_row;
     std::size_t num_nonzero_cnt = 0;
     for (size_t i = 0; i < this->matrix_->num_rows(); i++)
     {
-        const linear_combination<FieldT> row = this->matrix_->get_row(i);
+        if (r1cs_matrix == nullptr)
+        {
+            copied_row = this->matrix_->get_row(i);
+        }
+        const linear_combination<FieldT> &row = (r1cs_matrix != nullptr) ? r1cs_matrix->row(i) : copied_row;
         const FieldT row_index_elem = this->matrix_domain_.element_by_index(i);
 
         for (auto &term : row.terms)
@@ -124,35 +132,18 @@ template<typename FieldT>
 void matrix_indexer<FieldT>::compute_oracles()
 {
     std::vector<std::vector<FieldT>> index_oracles_over_K = this->compute_oracles_over_K();
-    /** TODO: Handle domain conversion in another function
-     *  to reduce memory overhead and code duplication.*/
-    const std::vector<FieldT> row_poly_over_codeword_domain
-        = FFT_over_field_subset<FieldT>(
-            IFFT_over_field_subset<FieldT>(
-                index_oracles_over_K[0], this->index_domain_),
-            this->codeword_domain_);
-    this->IOP_.submit_oracle(this->row_oracle_handle_, row_poly_over_codeword_domain);
-
-    const std::vector<FieldT> col_poly_over_codeword_domain
-        = FFT_over_field_subset<FieldT>(
-            IFFT_over_field_subset<FieldT>(
-                index_oracles_over_K[1], this->index_domain_),
-            this->codeword_domain_);
-    this->IOP_.submit_oracle(this->col_oracle_handle_, col_poly_over_codeword_domain);
-
-    const std::vector<FieldT> row_times_col_poly_over_codeword_domain
-        = FFT_over_field_subset<FieldT>(
-            IFFT_over_field_subset<FieldT>(
-                index_oracles_over_K[3], this->index_domain_),
-            this->codeword_domain_);
-    this->IOP_.submit_oracle(this->row_times_col_oracle_handle_, row_times_col_poly_over_codeword_domain);
-
-    const std::vector<FieldT> val_poly_over_codeword_domain
-        = FFT_over_field_subset<FieldT>(
-            IFFT_over_field_subset<FieldT>(
-                index_oracles_over_K[2], this->index_domain_),
-            this->codeword_domain_);
-    this->IOP_.submit_oracle(this->val_oracle_handle_, val_poly_over_codeword_domain);
+    /** Each oracle is interpolated over K and then extended to the codeword domain in place,
+     *  so the conversion reuses the buffer computed over K. */
+    for (std::vector<FieldT> &oracle : index_oracles_over_K)
+    {
+        oracle.reserve(this->codeword_domain_.num_elements());
+        IFFT_over_field_subset_in_place<FieldT>(oracle, this->index_domain_);
+        FFT_over_field_subset_in_place<FieldT>(oracle, this->codeword_domain_);
+    }
+    this->IOP_.submit_oracle(this->row_oracle_handle_, std::move(index_oracles_over_K[0]));
+    this->IOP_.submit_oracle(this->col_oracle_handle_, std::move(index_oracles_over_K[1]));
+    this->IOP_.submit_oracle(this->row_times_col_oracle_handle_, std::move(index_oracles_over_K[3]));
+    this->IOP_.submit_oracle(this->val_oracle_handle_, std::move(index_oracles_over_K[2]));
 }
 
 template<typename FieldT>
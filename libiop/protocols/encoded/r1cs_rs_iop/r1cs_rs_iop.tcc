@@ -179,7 +179,7 @@ public:
     }
 
     virtual std::shared_ptr<std::vector<FieldT>> evaluated_contents(
-        const std::vector<std::shared_ptr<std::vector<FieldT>>> &constituent_oracle_evaluations) const
+        const std::vector<std::shared_ptr<const std::vector<FieldT>>> &constituent_oracle_evaluations) const
     {
         libff::enter_block("fz evaluated contents");
         if (constituent_oracle_evaluations.size() != 1)
@@ -192,7 +192,7 @@ public:
             throw std::logic_error("Evaluation requested before primary_input is set.");
         }
 
-        const std::shared_ptr<std::vector<FieldT>> &fw = constituent_oracle_evaluations[0];
+        const std::shared_ptr<const std::vector<FieldT>> &fw = constituent_oracle_evaluations[0];
 
         if (fw->size() != this->codeword_domain_.num_elements())
         {
@@ -204,13 +204,13 @@ public:
         std::vector<FieldT> input_vp_over_codeword_domain =
             input_vp.evaluations_over_field_subset(this->codeword_domain_);
 
-        std::vector<FieldT> f_1v_evaluations({ FieldT::one() });
-        f_1v_evaluations.insert(f_1v_evaluations.end(),
-                                this->primary_input_.begin(), this->primary_input_.end());
-        std::vector<FieldT> f_1v_coefficients =
-            IFFT_over_field_subset<FieldT>(f_1v_evaluations, this->input_variable_domain_);
-        const std::vector<FieldT> f_1v_over_codeword_domain =
-            FFT_over_field_subset<FieldT>(f_1v_coefficients, this->codeword_domain_);
+        std::vector<FieldT> f_1v_over_codeword_domain;
+        f_1v_over_codeword_domain.reserve(this->codeword_domain_.num_elements());
+        f_1v_over_codeword_domain.emplace_back(FieldT::one());
+        f_1v_over_codeword_domain.insert(f_1v_over_codeword_domain.end(),
+                                         this->primary_input_.begin(), this->primary_input_.end());
+        IFFT_over_field_subset_in_place<FieldT>(f_1v_over_codeword_domain, this->input_variable_domain_);
+        FFT_over_field_subset_in_place<FieldT>(f_1v_over_codeword_domain, this->codeword_domain_);
 
         /* TODO: Initialize result to f_1v_over_codeword_domain */
         std::shared_ptr<std::vector<FieldT>> result = std::make_shared<std::vector<FieldT>>();
@@ -455,12 +455,12 @@ void encoded_aurora_protocol<FieldT>::compute_fprime_ABCz_over_codeword_domain(
      *  These matrices may be randomized due to fz' randomness from f_w in the zk case.
      */
 
-    polynomial<FieldT> f_Az(std::move(
-            IFFT_over_field_subset<FieldT>(Az, this->constraint_domain_)));
-    polynomial<FieldT> f_Bz(std::move(
-            IFFT_over_field_subset<FieldT>(Bz, this->constraint_domain_)));
-    polynomial<FieldT> f_Cz(std::move(
-            IFFT_over_field_subset<FieldT>(Cz, this->constraint_domain_)));
+    /* The three transforms share their domains, so they are done as one batch */
+    std::vector<std::vector<FieldT>> ABCz_coefficients =
+        batch_IFFT_over_field_subset<FieldT>({Az, Bz, Cz}, this->constraint_domain_);
+    polynomial<FieldT> f_Az(std::move(ABCz_coefficients[0]));
+    polynomial<FieldT> f_Bz(std::move(ABCz_coefficients[1]));
+    polynomial<FieldT> f_Cz(std::move(ABCz_coefficients[2]));
 
     if (this->params_.make_zk()) {
         // Add constraint_vp * R_A/B/Cz to each of the polynomials
@@ -470,12 +470,12 @@ void encoded_aurora_protocol<FieldT>::compute_fprime_ABCz_over_codeword_domain(
         f_Cz += constraint_vp * this->R_Cz_;
     }
 
-    this->fprime_Az_over_codeword_domain_ =
-        FFT_over_field_subset<FieldT>(f_Az.coefficients(), this->codeword_domain_);
-    this->fprime_Bz_over_codeword_domain_=
-        FFT_over_field_subset<FieldT>(f_Bz.coefficients(), this->codeword_domain_);
-    this->fprime_Cz_over_codeword_domain_ =
-        FFT_over_field_subset<FieldT>(f_Cz.coefficients(), this->codeword_domain_);
+    std::vector<std::vector<FieldT>> fprime_ABCz_over_codeword_domain =
+        batch_FFT_over_field_subset<FieldT>(
+            {f_Az.coefficients(), f_Bz.coefficients(), f_Cz.coefficients()}, this->codeword_domain_);
+    this->fprime_Az_over_codeword_domain_ = std::move(fprime_ABCz_over_codeword_domain[0]);
+    this->fprime_Bz_over_codeword_domain_ = std::move(fprime_ABCz_over_codeword_domain[1]);
+    this->fprime_Cz_over_codeword_domain_ = std::move(fprime_ABCz_over_codeword_domain[2]);
 }
 
 template<typename FieldT>
@@ -544,15 +544,13 @@ void encoded_aurora_protocol<FieldT>::submit_witness_oracles(
      *     with the expected degree and systematic evaluations.
      * iii) We do an FFT to evaluate fw_prime over the codeword domain. */
 
-    const std::vector<FieldT> fw_prime_over_variable_domain = create_fw_prime_evals(
+    std::vector<FieldT> fw_prime_over_variable_domain = create_fw_prime_evals(
         f_1v_over_variable_domain,
         primary_input.size(), auxiliary_input,
         this->variable_domain_);
     assert(fw_prime_over_variable_domain.size() == this->variable_domain_.num_elements());
-    polynomial<FieldT> fw_prime(
-        std::move(
-            IFFT_over_field_subset<FieldT>(fw_prime_over_variable_domain, this->variable_domain_)
-        ));
+    IFFT_over_field_subset_in_place<FieldT>(fw_prime_over_variable_domain, this->variable_domain_);
+    polynomial<FieldT> fw_prime(std::move(fw_prime_over_variable_domain));
 
     if (this->params_.make_zk()) {
         // fw = fw_prime + Z_{var} * R2
@@ -583,14 +581,9 @@ void encoded_aurora_protocol<FieldT>::submit_witness_oracles(
     variable_assignment.insert(variable_assignment.end(),
                             auxiliary_input.begin(), auxiliary_input.end());
 
-    std::vector<FieldT> Az;
-    std::vector<FieldT> Bz;
-    std::vector<FieldT> Cz;
-    Az.reserve(this->constraint_domain_.num_elements());
-    Bz.reserve(this->constraint_domain_.num_elements());
-    Cz.reserve(this->constraint_domain_.num_elements());
-    this->constraint_system_->create_Az_Bz_Cz_from_variable_assignment(
-        variable_assignment, Az, Bz, Cz);
+    std::vector<FieldT> Az = this->r1cs_A_->multiply(variable_assignment);
+    std::vector<FieldT> Bz = this->r1cs_B_->multiply(variable_assignment);
+    std::vector<FieldT> Cz = this->r1cs_C_->multiply(variable_assignment);
 
     libff::leave_block("Compute A/B/Cz");
 
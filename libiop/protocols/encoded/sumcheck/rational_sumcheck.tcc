@@ -23,6 +23,8 @@ protected:
 
     const field_subset_type field_subset_type_;
     const vanishing_polynomial<FieldT> Z_;
+    /* Z_H^{-1} and x^{|H| - 1} over L, shared with the other sumchecks over H and L */
+    std::shared_ptr<domain_evaluation_cache<FieldT>> domain_evaluation_cache_;
 
     FieldT claimed_sum_;
     FieldT order_H_inv_times_claimed_sum_;
@@ -32,11 +34,13 @@ public:
     sumcheck_constraint_oracle(
         const field_subset<FieldT> &summation_domain,
         const field_subset<FieldT> &codeword_domain,
-        const field_subset_type domain_type) :
+        const field_subset_type domain_type,
+        const std::shared_ptr<domain_evaluation_cache<FieldT>> &domain_evaluation_cache) :
         summation_domain_(summation_domain),
         codeword_domain_(codeword_domain),
         field_subset_type_(domain_type),
-        Z_(vanishing_polynomial<FieldT>(summation_domain))
+        Z_(vanishing_polynomial<FieldT>(summation_domain)),
+        domain_evaluation_cache_(domain_evaluation_cache)
     {
         if (this->field_subset_type_ == affine_subspace_type) {
             /* coefficient for the linear term of the vanishing polynomial */
@@ -61,7 +65,7 @@ public:
     }
 
     virtual std::shared_ptr<std::vector<FieldT>> evaluated_contents(
-        const std::vector<std::shared_ptr<std::vector<FieldT>> > &constituent_oracle_evaluations) const
+        const std::vector<std::shared_ptr<const std::vector<FieldT>>> &constituent_oracle_evaluations) const
     {
         /** The input is expected to be of the form: (p, N, D)
          *  where p is output by rational sumcheck,
@@ -75,18 +79,19 @@ public:
         /* evaluations of p */
         std::shared_ptr<std::vector<FieldT>> result = std::make_shared<std::vector<FieldT>>(
             *constituent_oracle_evaluations[0].get());
-        const std::vector<FieldT> Z_inv_over_L = batch_inverse(
-            this->Z_.evaluations_over_field_subset(this->codeword_domain_));
+        const std::shared_ptr<const std::vector<FieldT>> Z_inv_over_L_table =
+            this->domain_evaluation_cache_->inverse_vanishing_polynomial_evaluations(
+                this->summation_domain_, this->codeword_domain_);
+        const std::vector<FieldT> &Z_inv_over_L = *Z_inv_over_L_table;
         if (this->field_subset_type_ == affine_subspace_type)
         {
             /** In the additive case q(x) is:
              *  q(x) = (D(x) * (p(x) + eps^{-1} * claimed_sum * X^{|H| - 1}) - N(x)) / Z_H
              */
-            const std::vector<FieldT> eps_inv_times_claimed_sum_times_x_to_H_minus_1 =
-                constant_times_subspace_to_order_H_minus_1(
-                    this->eps_inv_times_claimed_sum_,
-                    this->codeword_domain_.subspace(),
-                    this->summation_domain_.num_elements());
+            const std::shared_ptr<const std::vector<FieldT>> x_to_H_minus_1_table =
+                subspace_to_order_H_minus_1(
+                    *this->domain_evaluation_cache_, this->summation_domain_, this->codeword_domain_);
+            const std::vector<FieldT> &x_to_H_minus_1 = *x_to_H_minus_1_table;
 
             /** Compute q, by performing the correct arithmetic on the evaluations */
             for (std::size_t i = 0; i < result->size(); ++i)
@@ -95,7 +100,7 @@ public:
                 const FieldT D_x = constituent_oracle_evaluations[2]->operator[](i);
                 result->operator[](i) = ((D_x *
                     (
-                        result->operator[](i) + eps_inv_times_claimed_sum_times_x_to_H_minus_1[i])) - N_x
+                        result->operator[](i) + this->eps_inv_times_claimed_sum_ * x_to_H_minus_1[i])) - N_x
                     ) * Z_inv_over_L[i];
             }
         } else if (this->field_subset_type_ == multiplicative_coset_type) {
@@ -211,7 +216,8 @@ void rational_sumcheck_protocol<FieldT>::register_proof()
             this->reextended_oracle_degree_,
             make_zk);
     this->constraint_oracle_ = std::make_shared<sumcheck_constraint_oracle<FieldT>>(
-        this->summation_domain_, this->codeword_domain_, this->field_subset_type_);
+        this->summation_domain_, this->codeword_domain_, this->field_subset_type_,
+        this->IOP_.get_domain_evaluation_cache());
     this->constraint_oracle_handle_ = this->IOP_.register_virtual_oracle(
         this->codeword_domain_handle_,
         this->constraint_oracle_degree_,
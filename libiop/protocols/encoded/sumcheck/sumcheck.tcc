@@ -5,6 +5,7 @@
 #include "libiop/algebra/fft.hpp"
 #include "libiop/algebra/utils.hpp"
 #include "libiop/algebra/polynomials/polynomial.hpp"
+#include "libiop/common/parallel.hpp"
 
 namespace libiop {
 
@@ -24,14 +25,18 @@ protected:
     FieldT eps_inv_times_claimed_sum_;
     const field_subset_type field_subset_type_;
     const vanishing_polynomial<FieldT> Z_;
+    /* Z_H and x^{|H| - 1} over L, shared with the other sumchecks over H and L */
+    std::shared_ptr<domain_evaluation_cache<FieldT>> domain_evaluation_cache_;
 public:
     sumcheck_g_oracle(const field_subset<FieldT> &summation_domain,
                       const field_subset<FieldT> &codeword_domain,
-                      const field_subset_type domain_type) :
+                      const field_subset_type domain_type,
+                      const std::shared_ptr<domain_evaluation_cache<FieldT>> &domain_evaluation_cache) :
         summation_domain_(summation_domain),
         codeword_domain_(codeword_domain),
         field_subset_type_(domain_type),
-        Z_(vanishing_polynomial<FieldT>(summation_domain))
+        Z_(vanishing_polynomial<FieldT>(summation_domain)),
+        domain_evaluation_cache_(domain_evaluation_cache)
     {
         if (this->field_subset_type_ == affine_subspace_type) {
             /* coefficient for the linear term of the vanishing polynomial */
@@ -56,7 +61,7 @@ public:
     }
 
     virtual std::shared_ptr<std::vector<FieldT>> evaluated_contents(
-        const std::vector<std::shared_ptr<std::vector<FieldT>> > &constituent_oracle_evaluations) const
+        const std::vector<std::shared_ptr<const std::vector<FieldT>>> &constituent_oracle_evaluations) const
     {
         /** [BCRSVW18] protocol 5.3, step 3, computing p in RS[L, (|H|-1) / L] */
         if (constituent_oracle_evaluations.size() != 2)
@@ -69,7 +74,10 @@ public:
         /* evaluations of \hat{f} */
         std::shared_ptr<std::vector<FieldT>> result = std::make_shared<std::vector<FieldT>>(
             *constituent_oracle_evaluations[0].get());
-        const std::vector<FieldT> Z_over_L = this->Z_.evaluations_over_field_subset(this->codeword_domain_);
+        const std::shared_ptr<const std::vector<FieldT>> Z_over_L_table =
+            this->domain_evaluation_cache_->vanishing_polynomial_evaluations(
+                this->summation_domain_, this->codeword_domain_);
+        const std::vector<FieldT> &Z_over_L = *Z_over_L_table;
         if (this->field_subset_type_ == affine_subspace_type) {
             /** In the additive case this is computing p in RS[L, (|H|-1) / L],
              *  where p as described in the paper is:
@@ -81,16 +89,19 @@ public:
              *  We use the latter due to the reduced prover time.
              */
 
-            const std::vector<FieldT> eps_inv_times_claimed_sum_times_x_to_H_minus_1 =
-                constant_times_subspace_to_order_H_minus_1(
-                    this->eps_inv_times_claimed_sum_,
-                    this->codeword_domain_.subspace(),
-                    this->summation_domain_.num_elements());
+            const std::shared_ptr<const std::vector<FieldT>> x_to_H_minus_1_table =
+                subspace_to_order_H_minus_1(
+                    *this->domain_evaluation_cache_, this->summation_domain_, this->codeword_domain_);
+            const std::vector<FieldT> &x_to_H_minus_1 = *x_to_H_minus_1_table;
 
             /** Compute p, by performing the correct arithmetic on the evaluations */
-            for (std::size_t i = 0; i < result->size(); ++i)
+            const std::size_t n = result->size();
+#ifdef MULTICORE
+            #pragma omp parallel for if (n >= parallel_min_size)
+#endif
+            for (std::size_t i = 0; i < n; ++i)
             {
-                result->operator[](i) -= (eps_inv_times_claimed_sum_times_x_to_H_minus_1[i]
+                result->operator[](i) -= (this->eps_inv_times_claimed_sum_ * x_to_H_minus_1[i]
                     + Z_over_L[i] * constituent_oracle_evaluations[1]->operator[](i));
             }
         } else if (this->field_subset_type_ == multiplicative_coset_type) {
@@ -104,17 +115,20 @@ public:
              *  We use the latter due to the reduced prover time.
              */
 
-            FieldT cur_x_inv = this->codeword_domain_.shift().inverse();
-            FieldT generator_inv = this->codeword_domain_.generator().inverse();
+            const FieldT shift_inv = this->codeword_domain_.shift().inverse();
+            const FieldT generator_inv = this->codeword_domain_.generator().inverse();
 
             /** Compute p, by performing the correct arithmetic on the evaluations */
-            for (std::size_t i = 0; i < result->size(); ++i)
-            {
-                result->operator[](i) -= (this->order_H_inv_times_claimed_sum_ +
-                    Z_over_L[i] * constituent_oracle_evaluations[1]->operator[](i));
-                result->operator[](i) *= cur_x_inv;
-                cur_x_inv *= generator_inv;
-            }
+            parallel_for_ranges(result->size(), [&](const std::size_t begin, const std::size_t end) {
+                FieldT cur_x_inv = shift_inv * libff::power(generator_inv, begin);
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    result->operator[](i) -= (this->order_H_inv_times_claimed_sum_ +
+                        Z_over_L[i] * constituent_oracle_evaluations[1]->operator[](i));
+                    result->operator[](i) *= cur_x_inv;
+                    cur_x_inv *= generator_inv;
+                }
+            });
         }
         libff::leave_block("Sumcheck: g evaluated contents");
         return result;
@@ -257,7 +271,8 @@ void batch_sumcheck_protocol<FieldT>::register_proof()
         true);
 
     this->g_oracle_ = std::make_shared<sumcheck_g_oracle<FieldT> >(
-        this->summation_domain_, this->codeword_domain_, this->field_subset_type_);
+        this->summation_domain_, this->codeword_domain_, this->field_subset_type_,
+        this->IOP_.get_domain_evaluation_cache());
 
     this->g_handle_ = this->IOP_.register_virtual_oracle(
         this->codeword_domain_handle_,
@@ -347,7 +362,7 @@ void batch_sumcheck_protocol<FieldT>::calculate_and_submit_proof()
         this->IOP_.obtain_verifier_random_message(this->challenge_handle_);
     this->combined_f_oracle_->set_random_coefficients(challenge);
 
-    const std::shared_ptr<std::vector<FieldT>> combined_f_oracle_evaluations
+    const std::shared_ptr<const std::vector<FieldT>> combined_f_oracle_evaluations
         = this->IOP_.get_oracle_evaluations(std::make_shared<virtual_oracle_handle>(this->combined_f_oracle_handle_));
     std::vector<FieldT> combined_f_oracle_polynomial =
         IFFT_of_known_degree_over_field_subset<FieldT>(
@@ -8,11 +8,13 @@
 #ifndef LIBIOP_PROTOCOLS_ENCODED_SUMCHECK_AUX_HPP_
 #define LIBIOP_PROTOCOLS_ENCODED_SUMCHECK_AUX_HPP_
 
+#include <memory>
 #include <vector>
 #include "libiop/algebra/field_subset/field_subset.hpp"
 #include "libiop/algebra/field_subset/subgroup.hpp"
 #include "libiop/algebra/field_subset/subspace.hpp"
 #include "libiop/algebra/exponentiation.hpp"
+#include "libiop/iop/domain_evaluation_cache.hpp"
 
 namespace libiop {
 
@@ -22,6 +24,14 @@ std::vector<FieldT> constant_times_subspace_to_order_H_minus_1(
     const affine_subspace<FieldT> &subspace,
     const size_t H);
 
+/** x^{|H| - 1} over the affine codeword domain L, computed once per cache.
+ *  Sumchecks multiply it by their own constant. */
+template<typename FieldT>
+std::shared_ptr<const std::vector<FieldT>> subspace_to_order_H_minus_1(
+    domain_evaluation_cache<FieldT> &cache,
+    const field_subset<FieldT> &summation_domain,
+    const field_subset<FieldT> &codeword_domain);
+
 } // namespace libiop
 
 #include "libiop/protocols/encoded/sumcheck/sumcheck_aux.tcc"
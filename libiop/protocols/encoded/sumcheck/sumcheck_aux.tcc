@@ -31,4 +31,17 @@ std::vector<FieldT> constant_times_subspace_to_order_H_minus_1(
     return constant_times_x_to_H_minus_1;
 }
 
+template<typename FieldT>
+std::shared_ptr<const std::vector<FieldT>> subspace_to_order_H_minus_1(
+    domain_evaluation_cache<FieldT> &cache,
+    const field_subset<FieldT> &summation_domain,
+    const field_subset<FieldT> &codeword_domain)
+{
+    return cache.get_table("x^{|H| - 1}", summation_domain, codeword_domain,
+        [&summation_domain, &codeword_domain]() {
+            return constant_times_subspace_to_order_H_minus_1(
+                FieldT::one(), codeword_domain.subspace(), summation_domain.num_elements());
+        });
+}
+
 } // libiop
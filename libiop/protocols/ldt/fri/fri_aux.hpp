@@ -8,6 +8,8 @@
 #ifndef LIBIOP_PROTOCOLS_LDT_FRI_FRI_AUX_HPP_
 #define LIBIOP_PROTOCOLS_LDT_FRI_FRI_AUX_HPP_
 
+#include <cstddef>
+#include <memory>
 #include <vector>
 
 #include "libiop/algebra/field_subset/field_subset.hpp"
@@ -20,13 +22,63 @@
 
 namespace libiop {
 
+/** Number of codeword elements whose Lagrange coefficients are batch inverted together
+ *  when folding a whole codeword. */
+const std::size_t fri_fold_block_size = 1ull << 12;
+
 template<typename FieldT>
 std::shared_ptr<std::vector<FieldT>> evaluate_next_f_i_over_entire_domain(
-    const std::shared_ptr<std::vector<FieldT>> &f_i_evals,
+    const std::shared_ptr<const std::vector<FieldT>> &f_i_evals,
     const field_subset<FieldT> &f_i_domain,
     const size_t coset_size,
     const FieldT x_i);
 
+/** Folds every codeword f_i_evals[c] (each over f_i_domain) with the challenge x_i[c].
+ *  Codewords with the same challenge share their Lagrange coefficients. */
+template<typename FieldT>
+std::vector<std::shared_ptr<std::vector<FieldT>>> evaluate_next_f_i_over_entire_domain(
+    const std::vector<std::shared_ptr<const std::vector<FieldT>>> &f_i_evals,
+    const field_subset<FieldT> &f_i_domain,
+    const size_t coset_size,
+    const std::vector<FieldT> &x_i);
+
+/** Folds the codewords f_i_evals[c] for c in codeword_indices, all with challenge x_i,
+ *  over the cosets [coset_begin, coset_end), into the same positions of next_f_i[c]. */
+template<typename FieldT>
+void additive_evaluate_next_f_i_over_cosets(
+    const std::vector<std::shared_ptr<const std::vector<FieldT>>> &f_i_evals,
+    const std::vector<size_t> &codeword_indices,
+    const field_subset<FieldT> &f_i_domain,
+    const size_t coset_size,
+    const FieldT x_i,
+    const size_t coset_begin,
+    const size_t coset_end,
+    std::vector<std::shared_ptr<std::vector<FieldT>>> &next_f_i);
+
+/** additive_evaluate_next_f_i_over_cosets for cosets of size 2, where folding is one
+ *  additive FFT butterfly per coset. The cosets must be a block starting at a multiple of
+ *  its power of two size. */
+template<typename FieldT>
+void additive_fold_cosets_of_size_two(
+    const std::vector<std::shared_ptr<const std::vector<FieldT>>> &f_i_evals,
+    const std::vector<size_t> &codeword_indices,
+    const field_subset<FieldT> &f_i_domain,
+    const FieldT x_i,
+    const size_t coset_begin,
+    const size_t coset_end,
+    std::vector<std::shared_ptr<std::vector<FieldT>>> &next_f_i);
+
+template<typename FieldT>
+void multiplicative_evaluate_next_f_i_over_cosets(
+    const std::vector<std::shared_ptr<const std::vector<FieldT>>> &f_i_evals,
+    const std::vector<size_t> &codeword_indices,
+    const field_subset<FieldT> &f_i_domain,
+    const size_t coset_size,
+    const FieldT x_i,
+    const size_t coset_begin,
+    const size_t coset_end,
+    std::vector<std::shared_ptr<std::vector<FieldT>>> &next_f_i);
+
 /** TODO: We should make a "lagrange cache" per reduction */
 template<typename FieldT>
 FieldT evaluate_next_f_i_at_coset(
@@ -51,6 +103,40 @@ FieldT multiplicative_evaluate_next_f_i_at_coset(
     const FieldT coset_h,
     const FieldT x_i);
 
+/** Interpolates many cosets of the same FRI round, as the verifier does for its query sets.
+ *  f_i_evals_over_cosets[q] holds f_i over the coset with the given shift (shifts[q] + localizer_domain,
+ *  or shifts[q] * localizer_domain), and is interpolated at x_i[q].
+ *  The denominators of all cosets are inverted together, one batch inversion per thread. */
+template<typename FieldT>
+std::vector<FieldT> evaluate_next_f_i_at_cosets(
+    const std::vector<std::vector<FieldT>> &f_i_evals_over_cosets,
+    const field_subset<FieldT> &localizer_domain,
+    const std::vector<FieldT> &shifts,
+    const localizer_polynomial<FieldT> &unshifted_vp,
+    const std::vector<FieldT> &x_i);
+
+/** The cosets in [begin, end) of evaluate_next_f_i_at_cosets */
+template<typename FieldT>
+void additive_evaluate_next_f_i_at_cosets(
+    const std::vector<std::vector<FieldT>> &f_i_evals_over_cosets,
+    const field_subset<FieldT> &localizer_domain,
+    const std::vector<FieldT> &shifts,
+    const localizer_polynomial<FieldT> &unshifted_vp,
+    const std::vector<FieldT> &x_i,
+    const size_t begin,
+    const size_t end,
+    std::vector<FieldT> &interpolations);
+
+template<typename FieldT>
+void multiplicative_evaluate_next_f_i_at_cosets(
+    const std::vector<std::vector<FieldT>> &f_i_evals_over_cosets,
+    const field_subset<FieldT> &localizer_domain,
+    const std::vector<FieldT> &shifts,
+    const std::vector<FieldT> &x_i,
+    const size_t begin,
+    const size_t end,
+    std::vector<FieldT> &interpolations);
+
 template<typename FieldT>
 std::vector<query_position_handle> calculate_next_coset_query_positions(
     iop_protocol<FieldT> &IOP,
@@ -1,13 +1,29 @@
+#include <algorithm>
 #include <cstdint>
+#include <stdexcept>
+
+#include "libiop/common/parallel.hpp"
 
 namespace libiop {
 
 template<typename FieldT>
 std::shared_ptr<std::vector<FieldT>> evaluate_next_f_i_over_entire_domain(
-    const std::shared_ptr<std::vector<FieldT>> &f_i_evals,
+    const std::shared_ptr<const std::vector<FieldT>> &f_i_evals,
     const field_subset<FieldT> &f_i_domain,
     const size_t coset_size,
     const FieldT x_i)
+{
+    return evaluate_next_f_i_over_entire_domain<FieldT>(
+        std::vector<std::shared_ptr<const std::vector<FieldT>>>({ f_i_evals }),
+        f_i_domain, coset_size, std::vector<FieldT>({ x_i }))[0];
+}
+
+template<typename FieldT>
+std::vector<std::shared_ptr<std::vector<FieldT>>> evaluate_next_f_i_over_entire_domain(
+    const std::vector<std::shared_ptr<const std::vector<FieldT>>> &f_i_evals,
+    const field_subset<FieldT> &f_i_domain,
+    const size_t coset_size,
+    const std::vector<FieldT> &x_i)
 {
     /** The f_i_domain is partitioned into cosets by the localizer polynomial.
      *  This function computes the evaluations of f_{i + 1}, over its systematic domain.
@@ -21,98 +37,226 @@ std::shared_ptr<std::vector<FieldT>> evaluate_next_f_i_over_entire_domain(
      *    * f_{i + 1}(j) = P(x_i)
      *
      *  Since we only need to evaluate P at a single point, we do lagrange interpolation at that point.
+     *  The Lagrange coefficients only depend on x_i and on the coset, so they are computed once
+     *  for all codewords folded with the same x_i, a block of cosets at a time (with one batch
+     *  inversion per block). Blocks are processed in parallel.
      *  This dispatches to domain-type dependent functions due to lagrange interpolation optimizations.
      */
-    if (f_i_domain.type() == affine_subspace_type) {
-        return additive_evaluate_next_f_i_over_entire_domain(
-            f_i_evals, f_i_domain, coset_size, x_i);
-    } else if (f_i_domain.type() == multiplicative_coset_type) {
-        return multiplicative_evaluate_next_f_i_over_entire_domain(
-            f_i_evals, f_i_domain, coset_size, x_i);
+    if (f_i_evals.size() != x_i.size())
+    {
+        throw std::invalid_argument("Expected one folding challenge per codeword.");
+    }
+    for (auto &evals : f_i_evals)
+    {
+        if (evals->size() != f_i_domain.num_elements())
+        {
+            throw std::invalid_argument("Codeword size does not match the domain size.");
+        }
+    }
+    if (f_i_domain.type() != affine_subspace_type && f_i_domain.type() != multiplicative_coset_type)
+    {
+        throw std::invalid_argument("f_i_domain is of unsupported domain type");
+    }
+
+    /* Codewords folded with the same challenge (e.g. every LDT instance of an interactive repetition) */
+    std::vector<FieldT> distinct_x;
+    std::vector<std::vector<size_t>> codewords_by_x;
+    for (size_t c = 0; c < x_i.size(); c++)
+    {
+        const size_t x_index = std::find(distinct_x.begin(), distinct_x.end(), x_i[c]) - distinct_x.begin();
+        if (x_index == distinct_x.size())
+        {
+            distinct_x.emplace_back(x_i[c]);
+            codewords_by_x.emplace_back();
+        }
+        codewords_by_x[x_index].emplace_back(c);
     }
-    throw std::invalid_argument("f_i_domain is of unsupported domain type");
+
+    const size_t num_cosets = f_i_domain.num_elements() / coset_size;
+    std::vector<std::shared_ptr<std::vector<FieldT>>> next_f_i(f_i_evals.size());
+    for (auto &next : next_f_i)
+    {
+        next = std::make_shared<std::vector<FieldT>>(num_cosets);
+    }
+
+    const size_t cosets_per_block = std::max<size_t>(1, fri_fold_block_size / coset_size);
+    const size_t num_blocks = (num_cosets + cosets_per_block - 1) / cosets_per_block;
+    const size_t num_tasks = distinct_x.size() * num_blocks;
+#ifdef MULTICORE
+    #pragma omp parallel for if (num_tasks > 1 && f_i_domain.num_elements() * f_i_evals.size() >= parallel_min_size)
+#endif
+    for (size_t t = 0; t < num_tasks; t++)
+    {
+        const size_t x_index = t / num_blocks;
+        const size_t coset_begin = (t % num_blocks) * cosets_per_block;
+        const size_t coset_end = std::min(num_cosets, coset_begin + cosets_per_block);
+        if (f_i_domain.type() == affine_subspace_type)
+        {
+            additive_evaluate_next_f_i_over_cosets(
+                f_i_evals, codewords_by_x[x_index], f_i_domain, coset_size,
+                distinct_x[x_index], coset_begin, coset_end, next_f_i);
+        }
+        else
+        {
+            multiplicative_evaluate_next_f_i_over_cosets(
+                f_i_evals, codewords_by_x[x_index], f_i_domain, coset_size,
+                distinct_x[x_index], coset_begin, coset_end, next_f_i);
+        }
+    }
+    return next_f_i;
 }
 
 template<typename FieldT>
-std::shared_ptr<std::vector<FieldT>> additive_evaluate_next_f_i_over_entire_domain(
-    const std::shared_ptr<std::vector<FieldT>> &f_i_evals,
+void additive_evaluate_next_f_i_over_cosets(
+    const std::vector<std::shared_ptr<const std::vector<FieldT>>> &f_i_evals,
+    const std::vector<size_t> &codeword_indices,
     const field_subset<FieldT> &f_i_domain,
     const size_t coset_size,
-    const FieldT x_i)
+    const FieldT x_i,
+    const size_t coset_begin,
+    const size_t coset_end,
+    std::vector<std::shared_ptr<std::vector<FieldT>>> &next_f_i)
 {
-    const std::vector<FieldT> all_elements = f_i_domain.all_elements();
-    const size_t num_cosets = all_elements.size() / coset_size;
-    std::shared_ptr<std::vector<FieldT>> next_f_i = std::make_shared<std::vector<FieldT>>();
-    next_f_i->reserve(num_cosets);
+    if (coset_size == 2)
+    {
+        additive_fold_cosets_of_size_two(f_i_evals, codeword_indices, f_i_domain,
+                                         x_i, coset_begin, coset_end, next_f_i);
+        return;
+    }
 
     /** Lagrange coefficient for coset element k is: vp_coset(x) / vp_coset[1] * (x - v[k])
      *
      *  The only change in vp_coset between cosets of the same domain is the constant term.
      *  As a consequence, we only need to calculate the vp_coset(x) and vp_coset[1] once.
      *  We then just adjust the vp_coset(x) by the constant term when processing each coset.
-     *  TODO: Investigate if we can lower the number of inversions by taking advantage of
-     *        v[k] = unshifted v[k % coset_size] + shift
+     *  The elements of coset j are v[k] = shift_j + u[k], where u is the unshifted coset,
+     *  so they are never materialized for the whole domain.
+     *  vp_coset(x) / vp_coset[1] is the same for the whole coset, so it is multiplied in
+     *  once per interpolation, rather than once per coefficient.
      */
-
     const std::vector<FieldT> coset_basis = f_i_domain.get_subset_of_order(coset_size).basis();
+    const std::vector<FieldT> unshifted_coset_elements = all_subset_sums<FieldT>(coset_basis, FieldT::zero());
     const affine_subspace<FieldT> unshifted_coset(coset_basis, FieldT::zero());
     const linearized_polynomial<FieldT> unshifted_vp =
         vanishing_polynomial_from_subspace(unshifted_coset);
 
     const FieldT unshifted_vp_x = unshifted_vp.evaluation_at_point(x_i);
     const FieldT inv_vp_linear_term = unshifted_vp.coefficients()[1].inverse();
-    /** We process cosets one at a time.
-     *  We should batch process them for fewer inversions,
-     *  but at too large of a batch size we will lose out on cache efficiency.    */
-    /* x - V[k] vector, defined outside the loop to avoid re-allocations. */
-    std::vector<FieldT> shifted_coset_elements(coset_size);
-    for (size_t j = 0; j < num_cosets; j++)
+
+    const size_t num_cosets_in_block = coset_end - coset_begin;
+    /* x - V[k] for every coset in the block, or ones for a coset containing x */
+    std::vector<FieldT> shifted_coset_elements(num_cosets_in_block * coset_size);
+    std::vector<FieldT> coset_constants(num_cosets_in_block);
+    /* Position of x within its coset, or coset_size if x is not in the coset */
+    std::vector<size_t> x_position_in_coset(num_cosets_in_block, coset_size);
+    for (size_t j = 0; j < num_cosets_in_block; j++)
     {
         /** By definition of cosets,
          *  shifted vp = unshifted vp - unshifted_vp(shift) */
-        const FieldT coset_shift = all_elements[coset_size * j];
+        const FieldT coset_shift = f_i_domain.element_by_index((coset_begin + j) * coset_size);
         const FieldT shifted_vp_x = unshifted_vp_x -
             unshifted_vp.evaluation_at_point(coset_shift);
+        coset_constants[j] = inv_vp_linear_term * shifted_vp_x;
 
-        const bool x_in_domain = shifted_vp_x == FieldT::zero();
-        FieldT interpolation = FieldT::zero();
-        for (std::size_t k = 0; k < coset_size; k++)
+        const bool x_in_coset = (shifted_vp_x == FieldT::zero());
+        for (size_t k = 0; k < coset_size; k++)
         {
-            /** If x in coset, set the interpolation accordingly. */
-            if (x_in_domain && x_i == all_elements[j*coset_size + k])
+            const FieldT x_minus_v = x_i - coset_shift - unshifted_coset_elements[k];
+            if (x_in_coset && x_minus_v == FieldT::zero())
             {
-                interpolation = f_i_evals->operator[](j*coset_size + k);
-                break;
+                x_position_in_coset[j] = k;
             }
-            /* If it's not in the coset, set this element to x - V[k] */
-            shifted_coset_elements[k] = x_i - all_elements[j*coset_size + k];
+            shifted_coset_elements[j*coset_size + k] = x_in_coset ? FieldT::one() : x_minus_v;
         }
-        if (!x_in_domain)
+    }
+    const std::vector<FieldT> inverses = batch_inverse(shifted_coset_elements);
+
+    for (const size_t c : codeword_indices)
+    {
+        const FieldT *f = f_i_evals[c]->data() + coset_begin * coset_size;
+        FieldT *next = next_f_i[c]->data() + coset_begin;
+        for (size_t j = 0; j < num_cosets_in_block; j++)
         {
-            const FieldT k = inv_vp_linear_term * shifted_vp_x;
-            const std::vector<FieldT> lagrange_coefficients =
-                batch_inverse_and_mul(shifted_coset_elements, k);
-            for (std::size_t k = 0; k < coset_size; k++)
+            if (x_position_in_coset[j] < coset_size)
+            {
+                next[j] = f[j*coset_size + x_position_in_coset[j]];
+                continue;
+            }
+            FieldT interpolation = FieldT::zero();
+            for (size_t k = 0; k < coset_size; k++)
             {
-                interpolation += f_i_evals->operator[](j*coset_size + k) * lagrange_coefficients[k];
+                interpolation += f[j*coset_size + k] * inverses[j*coset_size + k];
             }
+            next[j] = coset_constants[j] * interpolation;
         }
-        next_f_i->emplace_back(interpolation);
     }
-    return next_f_i;
 }
 
+template<typename FieldT>
+void additive_fold_cosets_of_size_two(
+    const std::vector<std::shared_ptr<const std::vector<FieldT>>> &f_i_evals,
+    const std::vector<size_t> &codeword_indices,
+    const field_subset<FieldT> &f_i_domain,
+    const FieldT x_i,
+    const size_t coset_begin,
+    const size_t coset_end,
+    std::vector<std::shared_ptr<std::vector<FieldT>>> &next_f_i)
+{
+    /** Coset j is {s_j, s_j + b}, where b is the first basis vector, and the line through
+     *  (s_j, f_0) and (s_j + b, f_1) evaluates at x to
+     *      f_0 + (f_0 + f_1) * (x + s_j) / b
+     *  (in characteristic 2, where addition and subtraction agree). This is one butterfly of
+     *  the additive FFT, with twiddle factor (x + s_j) / b: one multiplication per pair, and
+     *  no inversions.
+     *
+     *  s_j is the domain shift plus the subset sum of the other basis vectors selected by the
+     *  bits of j, so the twiddle factors of a block are the subset sums of the other basis
+     *  vectors divided by b, shifted by the block's first twiddle factor, and cost one addition
+     *  each. Over a Cantor basis, b = 1, so not even the basis needs rescaling.
+     *  Blocks start at a multiple of their power of two size, so the low bits of j select
+     *  the basis vectors within the block. */
+    const std::vector<FieldT> &basis = f_i_domain.basis();
+    const FieldT b = basis[0];
+    const bool b_is_one = (b == FieldT::one());
+    const FieldT b_inv = b_is_one ? FieldT::one() : b.inverse();
+
+    const size_t num_cosets_in_block = coset_end - coset_begin;
+    const size_t log_num_cosets_in_block = libff::log2(num_cosets_in_block);
+    std::vector<FieldT> twiddle_basis(basis.begin() + 1, basis.begin() + 1 + log_num_cosets_in_block);
+    FieldT first_twiddle = x_i + f_i_domain.element_by_index(2 * coset_begin);
+    if (!b_is_one)
+    {
+        for (auto &el : twiddle_basis)
+        {
+            el *= b_inv;
+        }
+        first_twiddle *= b_inv;
+    }
+    const std::vector<FieldT> twiddles = all_subset_sums<FieldT>(twiddle_basis, first_twiddle);
+
+    for (const size_t c : codeword_indices)
+    {
+        const FieldT *f = f_i_evals[c]->data() + 2 * coset_begin;
+        FieldT *next = next_f_i[c]->data() + coset_begin;
+        for (size_t j = 0; j < num_cosets_in_block; j++)
+        {
+            next[j] = f[2*j] + (f[2*j] + f[2*j + 1]) * twiddles[j];
+        }
+    }
+}
 
 template<typename FieldT>
-std::shared_ptr<std::vector<FieldT>> multiplicative_evaluate_next_f_i_over_entire_domain(
-    const std::shared_ptr<std::vector<FieldT>> &f_i_evals,
+void multiplicative_evaluate_next_f_i_over_cosets(
+    const std::vector<std::shared_ptr<const std::vector<FieldT>>> &f_i_evals,
+    const std::vector<size_t> &codeword_indices,
     const field_subset<FieldT> &f_i_domain,
     const size_t coset_size,
-    const FieldT x_i)
+    const FieldT x_i,
+    const size_t coset_begin,
+    const size_t coset_end,
+    std::vector<std::shared_ptr<std::vector<FieldT>>> &next_f_i)
 {
     const size_t num_cosets = f_i_domain.num_elements() / coset_size;
-    std::shared_ptr<std::vector<FieldT>> next_f_i = std::make_shared<std::vector<FieldT>>();
-    next_f_i->reserve(num_cosets);
 
     /** Let g be the generator for the coset, and h be the affine shift.
      *  Then the Lagrange coefficient for coset element k is:
@@ -121,7 +265,7 @@ std::shared_ptr<std::vector<FieldT>> multiplicative_evaluate_next_f_i_over_entir
      *  See algebra/lagrange.tcc for the derivation of this equation.
      *
      *  We now optimize this for interpolating many equal sized cosets of a domain.
-     *  To minimize inversions, we will do a single batch inversion for all cosets.
+     *  To minimize inversions, we do a single batch inversion for all cosets of the block.
      *
      *  As cosets change, in these equations h changes,
      *  which also changes v[k] as v[k] = hg^k.
@@ -166,27 +310,28 @@ std::shared_ptr<std::vector<FieldT>> multiplicative_evaluate_next_f_i_over_entir
         shifted_x_elements[i] = shifted_x_elements[i - 1] * g_inv;
     }
 
-    FieldT cur_h = f_i_domain.shift();
-    const FieldT first_h_to_coset_inv_plus_one = libff::power(cur_h, coset_size).inverse() * cur_h;
-    FieldT cur_coset_constant_plus_h = x_to_order_coset * first_h_to_coset_inv_plus_one;
+    /* The shift of the first coset of the block */
+    FieldT cur_h = f_i_domain.shift() * libff::power(h_inc, coset_begin);
+    FieldT cur_coset_constant_plus_h =
+        x_to_order_coset * libff::power(cur_h, coset_size).inverse() * cur_h;
 
-    /* xg^{-k} - h, for all combinations of k, h.  */
+    const size_t num_cosets_in_block = coset_end - coset_begin;
+    /* xg^{-k} - h, for all combinations of k, h, or ones for a coset containing x.  */
     std::vector<FieldT> elements_to_invert;
-    elements_to_invert.reserve(f_i_evals->size());
+    elements_to_invert.reserve(num_cosets_in_block * coset_size);
     /** constant for each coset, equal to
      *  vp_coset(x) / h^{|coset| - 1} = x^{|coset|} h^{-|coset| + 1} - h */
     std::vector<FieldT> constant_for_each_coset;
-    constant_for_each_coset.reserve(num_cosets);
+    constant_for_each_coset.reserve(num_cosets_in_block);
+    /* Position of x within f_i_domain if it is in the coset, or f_i_domain.num_elements() */
+    std::vector<size_t> x_position(num_cosets_in_block, f_i_domain.num_elements());
 
     const FieldT constant_for_all_cosets = FieldT(coset_size).inverse();
-    bool x_ever_in_domain = false;
-    size_t x_coset_index = 0;
-    size_t x_index_in_domain = 0;
 
     /** First we create all the constants for each coset,
      *  and the entire vector of elements to invert, xg^{-k} - h.
      */
-    for (size_t j = 0; j < num_cosets; j++)
+    for (size_t j = 0; j < num_cosets_in_block; j++)
     {
         /* coset constant = x^|coset| * h^{1 - |coset|} - h */
         const FieldT coset_constant = cur_coset_constant_plus_h - cur_h;
@@ -194,31 +339,28 @@ std::shared_ptr<std::vector<FieldT>> multiplicative_evaluate_next_f_i_over_entir
         /** coset_constant = vp_coset(x) * h^{-|coset| + 1},
          * since h is non-zero, coset_constant is zero iff vp_coset(x) is zero.
          * If vp_coset(x) is zero, then x is in the coset. */
-        const bool x_in_coset = (coset_constant == FieldT::zero());
-        /** if x is in the coset, we mark which position x is within f_i_domain,
-         *  and we pad elements to invert to simplify inversion later. */
-        if (x_in_coset)
+        if (coset_constant == FieldT::zero())
         {
-            x_ever_in_domain = true;
-            x_coset_index = j;
-            // find which element in the coset x belongs to.
-            // also pad elements_to_invert to simplify indexing
+            /** find which element in the coset x is, and pad elements to invert
+             *  to simplify indexing */
             FieldT cur_elem = cur_h;
             for (size_t k = 0; k < coset_size; k++)
             {
                 if (cur_elem == x_i)
                 {
-                    x_index_in_domain = k * num_cosets + j;
+                    x_position[j] = k * num_cosets + coset_begin + j;
                 }
                 cur_elem *= g;
                 elements_to_invert.emplace_back(FieldT::one());
             }
-            continue;
         }
-        /** Append all elements to invert, (xg^{-k} - h) */
-        for (std::size_t k = 0; k < coset_size; k++)
+        else
         {
-            elements_to_invert.emplace_back(shifted_x_elements[k] - cur_h);
+            /** Append all elements to invert, (xg^{-k} - h) */
+            for (std::size_t k = 0; k < coset_size; k++)
+            {
+                elements_to_invert.emplace_back(shifted_x_elements[k] - cur_h);
+            }
         }
 
         cur_h *= h_inc;
@@ -229,23 +371,28 @@ std::shared_ptr<std::vector<FieldT>> multiplicative_evaluate_next_f_i_over_entir
     /* Technically not lagrange coefficients, its missing the constant for each coset */
     const std::vector<FieldT> lagrange_coefficients =
         batch_inverse_and_mul(elements_to_invert, constant_for_all_cosets);
-    for (size_t j = 0; j < num_cosets; j++)
+
+    for (const size_t c : codeword_indices)
     {
-        FieldT interpolation = FieldT::zero();
-        for (std::size_t k = 0; k < coset_size; k++) {
-            interpolation += f_i_evals->operator[](k * num_cosets + j) *
-                lagrange_coefficients[j*coset_size + k];
+        const std::vector<FieldT> &f = *f_i_evals[c];
+        FieldT *next = next_f_i[c]->data() + coset_begin;
+        for (size_t j = 0; j < num_cosets_in_block; j++)
+        {
+            /* if x is in the coset, its evaluation is known. */
+            if (x_position[j] < f_i_domain.num_elements())
+            {
+                next[j] = f[x_position[j]];
+                continue;
+            }
+            FieldT interpolation = FieldT::zero();
+            for (std::size_t k = 0; k < coset_size; k++) {
+                interpolation += f[k * num_cosets + coset_begin + j] *
+                    lagrange_coefficients[j*coset_size + k];
+            }
+            /* Multiply the constant for each coset, to get the correct interpolation */
+            next[j] = interpolation * constant_for_each_coset[j];
         }
-        /* Multiply the constant for each coset, to get the correct interpolation */
-        interpolation *= constant_for_each_coset[j];
-        next_f_i->emplace_back(interpolation);
-    }
-    /* if x ever in domain, correct that evaluation. */
-    if (x_ever_in_domain)
-    {
-        next_f_i->operator[](x_coset_index) = f_i_evals->operator[](x_index_in_domain);
     }
-    return next_f_i;
 }
 
 template<typename FieldT>
@@ -348,6 +495,191 @@ FieldT multiplicative_evaluate_next_f_i_at_coset(
     return interpolation;
 }
 
+template<typename FieldT>
+std::vector<FieldT> evaluate_next_f_i_at_cosets(
+    const std::vector<std::vector<FieldT>> &f_i_evals_over_cosets,
+    const field_subset<FieldT> &localizer_domain,
+    const std::vector<FieldT> &shifts,
+    const localizer_polynomial<FieldT> &unshifted_vp,
+    const std::vector<FieldT> &x_i)
+{
+    const size_t num_cosets = f_i_evals_over_cosets.size();
+    if (shifts.size() != num_cosets || x_i.size() != num_cosets)
+    {
+        throw std::invalid_argument("Expected one shift and one interpolation point per coset.");
+    }
+    const size_t coset_size = localizer_domain.num_elements();
+    for (auto &evals : f_i_evals_over_cosets)
+    {
+        if (evals.size() != coset_size)
+        {
+            throw std::invalid_argument("Coset evaluations do not match the localizer domain size.");
+        }
+    }
+    if (localizer_domain.type() != affine_subspace_type && localizer_domain.type() != multiplicative_coset_type)
+    {
+        throw std::invalid_argument("localizer_domain is of unsupported domain type");
+    }
+
+    std::vector<FieldT> interpolations(num_cosets);
+    const size_t num_chunks = (num_cosets * coset_size >= parallel_min_size) ?
+        num_parallel_chunks(num_cosets) : 1;
+#ifdef MULTICORE
+    #pragma omp parallel for if (num_chunks > 1)
+#endif
+    for (size_t c = 0; c < num_chunks; c++)
+    {
+        const size_t begin = chunk_begin(c, num_chunks, num_cosets);
+        const size_t end = chunk_begin(c + 1, num_chunks, num_cosets);
+        if (localizer_domain.type() == affine_subspace_type)
+        {
+            additive_evaluate_next_f_i_at_cosets(
+                f_i_evals_over_cosets, localizer_domain, shifts, unshifted_vp, x_i, begin, end, interpolations);
+        }
+        else
+        {
+            multiplicative_evaluate_next_f_i_at_cosets(
+                f_i_evals_over_cosets, localizer_domain, shifts, x_i, begin, end, interpolations);
+        }
+    }
+    return interpolations;
+}
+
+template<typename FieldT>
+void additive_evaluate_next_f_i_at_cosets(
+    const std::vector<std::vector<FieldT>> &f_i_evals_over_cosets,
+    const field_subset<FieldT> &localizer_domain,
+    const std::vector<FieldT> &shifts,
+    const localizer_polynomial<FieldT> &unshifted_vp,
+    const std::vector<FieldT> &x_i,
+    const size_t begin,
+    const size_t end,
+    std::vector<FieldT> &interpolations)
+{
+    /** As in additive_evaluate_next_f_i_at_coset, the interpolation over coset q is
+     *  vp_q(x) * c * sum_k f[k] / (x - v_q[k]), where v_q[k] = shift_q + u[k] for the unshifted coset u.
+     *  c and u are shared by every coset, and the (x - v_q[k]) of all cosets are inverted together.
+     *  A coset containing x is answered directly, and takes no part in the inversion. */
+    const size_t coset_size = localizer_domain.num_elements();
+    const std::vector<FieldT> unshifted_coset_elements =
+        all_subset_sums<FieldT>(localizer_domain.basis(), FieldT::zero());
+    const FieldT c = unshifted_vp.get_linearized_polynomial().coefficients()[1].inverse();
+
+    std::vector<FieldT> denominators;
+    denominators.reserve((end - begin) * coset_size);
+    std::vector<FieldT> scales;
+    std::vector<size_t> interpolated_cosets;
+    for (size_t q = begin; q < end; q++)
+    {
+        const FieldT vp_x = unshifted_vp.evaluation_at_point(x_i[q]) -
+            unshifted_vp.evaluation_at_point(shifts[q]);
+        /* In binary fields addition and subtraction are the same operation */
+        const FieldT x_minus_shift = x_i[q] + shifts[q];
+        if (vp_x == FieldT::zero())
+        {
+            const size_t k = std::find(unshifted_coset_elements.begin(), unshifted_coset_elements.end(),
+                                       x_minus_shift) - unshifted_coset_elements.begin();
+            interpolations[q] = f_i_evals_over_cosets[q][k];
+            continue;
+        }
+        for (size_t k = 0; k < coset_size; k++)
+        {
+            denominators.emplace_back(x_minus_shift + unshifted_coset_elements[k]);
+        }
+        scales.emplace_back(vp_x * c);
+        interpolated_cosets.emplace_back(q);
+    }
+    if (interpolated_cosets.empty())
+    {
+        return;
+    }
+
+    const std::vector<FieldT> inverses = batch_inverse(denominators);
+    for (size_t t = 0; t < interpolated_cosets.size(); t++)
+    {
+        const std::vector<FieldT> &f_i_evals = f_i_evals_over_cosets[interpolated_cosets[t]];
+        FieldT interpolation = FieldT::zero();
+        for (size_t k = 0; k < coset_size; k++)
+        {
+            interpolation += inverses[t * coset_size + k] * f_i_evals[k];
+        }
+        interpolations[interpolated_cosets[t]] = scales[t] * interpolation;
+    }
+}
+
+template<typename FieldT>
+void multiplicative_evaluate_next_f_i_at_cosets(
+    const std::vector<std::vector<FieldT>> &f_i_evals_over_cosets,
+    const field_subset<FieldT> &localizer_domain,
+    const std::vector<FieldT> &shifts,
+    const std::vector<FieldT> &x_i,
+    const size_t begin,
+    const size_t end,
+    std::vector<FieldT> &interpolations)
+{
+    /** As in multiplicative_evaluate_next_f_i_at_coset, the interpolation over coset q is
+     *  (x^m - h^m) / (m * h^{m-1}) * sum_k f[k] * g^k / (x - h * g^k), for shift h.
+     *  The powers of g are shared by every coset. Each coset contributes its m denominators
+     *  and m * h^{m-1} to a single batch inversion.
+     *  A coset containing x is answered directly, and takes no part in the inversion. */
+    const size_t coset_size = localizer_domain.num_elements();
+    const FieldT m = FieldT(coset_size);
+    const FieldT g = localizer_domain.generator();
+    std::vector<FieldT> unshifted_coset_elements(coset_size);
+    unshifted_coset_elements[0] = FieldT::one();
+    for (size_t k = 1; k < coset_size; k++)
+    {
+        unshifted_coset_elements[k] = unshifted_coset_elements[k - 1] * g;
+    }
+
+    std::vector<FieldT> denominators;
+    denominators.reserve((end - begin) * (coset_size + 1));
+    std::vector<FieldT> scales;
+    std::vector<size_t> interpolated_cosets;
+    for (size_t q = begin; q < end; q++)
+    {
+        const FieldT h = shifts[q];
+        const FieldT h_to_m_minus_1 = libff::power(h, coset_size - 1);
+        const FieldT vp_x = libff::power(x_i[q], coset_size) - h_to_m_minus_1 * h;
+        if (vp_x == FieldT::zero())
+        {
+            for (size_t k = 0; k < coset_size; k++)
+            {
+                if (h * unshifted_coset_elements[k] == x_i[q])
+                {
+                    interpolations[q] = f_i_evals_over_cosets[q][k];
+                    break;
+                }
+            }
+            continue;
+        }
+        for (size_t k = 0; k < coset_size; k++)
+        {
+            denominators.emplace_back(x_i[q] - h * unshifted_coset_elements[k]);
+        }
+        denominators.emplace_back(m * h_to_m_minus_1);
+        scales.emplace_back(vp_x);
+        interpolated_cosets.emplace_back(q);
+    }
+    if (interpolated_cosets.empty())
+    {
+        return;
+    }
+
+    const std::vector<FieldT> inverses = batch_inverse(denominators);
+    for (size_t t = 0; t < interpolated_cosets.size(); t++)
+    {
+        const std::vector<FieldT> &f_i_evals = f_i_evals_over_cosets[interpolated_cosets[t]];
+        const size_t offset = t * (coset_size + 1);
+        FieldT interpolation = FieldT::zero();
+        for (size_t k = 0; k < coset_size; k++)
+        {
+            interpolation += inverses[offset + k] * unshifted_coset_elements[k] * f_i_evals[k];
+        }
+        interpolations[interpolated_cosets[t]] = scales[t] * inverses[offset + coset_size] * interpolation;
+    }
+}
+
 /** Given a query position handle for something in the previous coset,
  *  generate query position handles for every position in the next coset we localize to,
  *  with the handles ordered by position in coset.
@@ -186,7 +186,6 @@ public:
     virtual ~FRI_protocol() {};
 protected:
     void compute_domains();
-    bool predicate_for_query_set(const FRI_query_set &Q);
     std::size_t num_queries_made_;
 };
 
@@ -476,11 +476,11 @@ template<typename FieldT>
 void FRI_protocol<FieldT>::calculate_and_submit_proof()
 {
     /* First set of codewords: the original purported codewords we're testing. */
-    std::vector<std::shared_ptr<std::vector<FieldT>>> multi_f_i_evaluations =
+    std::vector<std::shared_ptr<const std::vector<FieldT>>> multi_f_i_evaluations =
         get_all_oracle_evaluations(this->IOP_, this->poly_handles_);
 
     /* indexed by interaction, then LDT instance index */
-    std::vector<std::vector<std::shared_ptr<std::vector<FieldT>>>>
+    std::vector<std::vector<std::shared_ptr<const std::vector<FieldT>>>>
         multi_f_i_evaluations_by_interaction;
     for (size_t j = 0; j < this->params_.interactive_repetitions(); j++)
     {
@@ -500,8 +500,9 @@ void FRI_protocol<FieldT>::calculate_and_submit_proof()
             {
                 for (size_t ldt_index = 0; ldt_index < this->poly_handles_.size(); ldt_index++)
                 {
-                    oracle<FieldT> cur_f_i_oracle(multi_f_i_evaluations_by_interaction[j][ldt_index]);
-                    this->IOP_.submit_oracle(this->oracle_handles_[i][j][ldt_index], std::move(cur_f_i_oracle));
+                    /* Shared with the IOP, not copied: the next round folds into a fresh buffer */
+                    this->IOP_.submit_oracle(this->oracle_handles_[i][j][ldt_index],
+                                             multi_f_i_evaluations_by_interaction[j][ldt_index]);
                 }
             }
 
@@ -510,22 +511,32 @@ void FRI_protocol<FieldT>::calculate_and_submit_proof()
             libff::leave_block("LDT signal prover round done");
         }
 
-        /* For each interaction, receive the verifier challenge and create f_{i + 1} */
+        /** For each interaction, receive the verifier challenge, and create f_{i + 1}.
+         *  Every codeword of every interaction is folded in the same pass. */
+        std::vector<std::shared_ptr<const std::vector<FieldT>>> f_i_evaluations;
+        std::vector<FieldT> challenges;
         for (size_t j = 0; j < this->params_.interactive_repetitions(); j++)
         {
             const FieldT x_i = this->IOP_.obtain_verifier_random_message(
                 this->verifier_challenge_handles_[i][j])[0];
+            for (size_t ldt_index = 0; ldt_index < this->poly_handles_.size(); ldt_index++)
+            {
+                f_i_evaluations.emplace_back(multi_f_i_evaluations_by_interaction[j][ldt_index]);
+                challenges.emplace_back(x_i);
+            }
+        }
 
-            libff::enter_block("evaluating next FRI codeword");
+        libff::enter_block("evaluating next FRI codewords");
+        const std::vector<std::shared_ptr<std::vector<FieldT>>> next_f_i_evaluations =
+            evaluate_next_f_i_over_entire_domain(f_i_evaluations, this->domains_[i], coset_size, challenges);
+        libff::leave_block("evaluating next FRI codewords");
+        for (size_t j = 0; j < this->params_.interactive_repetitions(); j++)
+        {
             for (size_t ldt_index = 0; ldt_index < this->poly_handles_.size(); ldt_index++)
             {
-                multi_f_i_evaluations_by_interaction[j][ldt_index] = evaluate_next_f_i_over_entire_domain(
-                    multi_f_i_evaluations_by_interaction[j][ldt_index],
-                    this->domains_[i],
-                    coset_size,
-                    x_i);
+                multi_f_i_evaluations_by_interaction[j][ldt_index] =
+                    next_f_i_evaluations[j * this->poly_handles_.size() + ldt_index];
             }
-            libff::leave_block("evaluating next FRI codeword");
         }
     }
 
@@ -550,94 +561,106 @@ void FRI_protocol<FieldT>::calculate_and_submit_proof()
 template<typename FieldT>
 bool FRI_protocol<FieldT>::verifier_predicate()
 {
+    /** The query sets are checked together, one round at a time.
+     *  Every query set's coset of f_i is gathered first, serially, since the IOP's query
+     *  response caches are not thread safe. The cosets of the round are then interpolated
+     *  together, with a single batch inversion per thread. */
+    const size_t num_query_sets = this->query_sets_.size();
     this->num_queries_made_ = 0;
 
-    bool decision = true;
-    for (auto &Q : this->query_sets_)
+    std::vector<size_t> si_idx(num_query_sets);
+    std::vector<FieldT> si(num_query_sets);
+    for (size_t q = 0; q < num_query_sets; q++)
     {
-        if (!this->predicate_for_query_set(Q))
-        {
-            decision = false;
-        }
+        si_idx[q] = this->IOP_.obtain_query_position(this->query_sets_[q].s0_position_handle_);
+        si[q] = this->domains_[0].element_by_index(si_idx[q]);
     }
 
-    libff::print_indent(); printf("* Number of FRI interactions: %zu\n", this->params_.interactive_repetitions());
-    libff::print_indent(); printf("* Number of FRI query sets per interaction: %zu\n",
-        this->query_sets_.size() / this->params_.interactive_repetitions());
-    libff::print_indent(); printf("* Total number of FRI queries over all query sets (incl. repeated queries): %zu\n", this->num_queries_made_);
-    // libff::print_indent(); printf("* Analytical expression: %zu\n", (2 + ((this->num_reductions_ - 1) << this->localization_parameter_)) * this->query_sets_.size());
-
-    return decision;
-}
-
-template<typename FieldT>
-bool FRI_protocol<FieldT>::predicate_for_query_set(const FRI_query_set &Q)
-{
-    /* Verifier work */
-    const std::size_t s0_idx = this->IOP_.obtain_query_position(Q.s0_position_handle_);
-    const FieldT s0 = this->domains_[0].element_by_index(s0_idx);
-
-    FieldT si = s0;
-    size_t si_idx = s0_idx;
-    FieldT last_interpolation;
-
-    bool decision = true;
-
+    std::vector<bool> query_set_accepted(num_query_sets, true);
+    std::vector<FieldT> last_interpolations;
     for (std::size_t i = 0; i < this->num_reductions_; ++i)
     {
-        const FieldT x_i = this->IOP_.obtain_verifier_random_message(
-            this->verifier_challenge_handles_[i][Q.interaction_index_])[0];
-
         const size_t current_coset_size = 1ull << this->params_.get_localization_parameters()[i];
-        size_t si_j = this->domains_[i].coset_index(si_idx, current_coset_size);
-        size_t si_k = this->domains_[i].intra_coset_index(si_idx, current_coset_size);
-        si_idx = si_j; /* next si position is the same as the coset index for si */
-
-        /* Query the entire si coset */
-        std::vector<FieldT> fi_on_si_coset;
-        for (std::size_t k = 0; k < current_coset_size; ++k)
+        std::vector<std::vector<FieldT>> fi_on_si_cosets(num_query_sets);
+        std::vector<FieldT> shifts(num_query_sets);
+        std::vector<FieldT> x_i(num_query_sets);
+        for (size_t q = 0; q < num_query_sets; q++)
         {
-            fi_on_si_coset.emplace_back(
-                this->IOP_.obtain_query_response(Q.f_at_s_coset_query_handles_[i][k]));
-            ++(this->num_queries_made_);
-        }
+            const FRI_query_set &Q = this->query_sets_[q];
+            x_i[q] = this->IOP_.obtain_verifier_random_message(
+                this->verifier_challenge_handles_[i][Q.interaction_index_])[0];
 
-        /* Check that the coset matches interpolation computed in the
-           previous round. */
-        if (i > 0)
-        {
-            if (last_interpolation != fi_on_si_coset[si_k])
+            const size_t si_j = this->domains_[i].coset_index(si_idx[q], current_coset_size);
+            const size_t si_k = this->domains_[i].intra_coset_index(si_idx[q], current_coset_size);
+            si_idx[q] = si_j; /* next si position is the same as the coset index for si */
+
+            /* Query the entire si coset */
+            fi_on_si_cosets[q].reserve(current_coset_size);
+            for (std::size_t k = 0; k < current_coset_size; ++k)
             {
-                return false;
+                fi_on_si_cosets[q].emplace_back(
+                    this->IOP_.obtain_query_response(Q.f_at_s_coset_query_handles_[i][k]));
+                ++(this->num_queries_made_);
             }
+
+            /* Check that the coset matches interpolation computed in the
+               previous round. */
+            if (i > 0 && last_interpolations[q] != fi_on_si_cosets[q][si_k])
+            {
+                query_set_accepted[q] = false;
+            }
+
+            const size_t shift_position =
+                this->domains_[i].position_by_coset_indices(si_j, 0, current_coset_size);
+            shifts[q] = this->domains_[i].element_by_index(shift_position);
+            si[q] = this->localizer_polynomials_[i].evaluation_at_point(si[q]);
         }
 
         /* Now compute interpolant of f_i|S_i evaluated at x_i
            (for use in next round). */
-        const size_t shift_position =
-            this->domains_[i].position_by_coset_indices(si_j, 0, current_coset_size);
-        const FieldT shift = this->domains_[i].element_by_index(shift_position);
-        FieldT interpolation = evaluate_next_f_i_at_coset(
-            fi_on_si_coset,
+        last_interpolations = evaluate_next_f_i_at_cosets(
+            fi_on_si_cosets,
             this->localizer_domains_[i],
-            shift,
+            shifts,
             this->localizer_polynomials_[i],
             x_i);
-        last_interpolation = interpolation;
-        si = this->localizer_polynomials_[i].evaluation_at_point(si);
     }
 
     /* Finally, check that the LAST round polynomial, evaluated at si,
        matches the final interpolation from the loop. */
-    const polynomial<FieldT> last_poly(
-        this->IOP_.receive_prover_message(this->final_polynomial_handles_[Q.interaction_index_][Q.LDT_index_]));
-    const FieldT last_poly_at_si = last_poly.evaluation_at_point(si);
+    std::vector<std::vector<polynomial<FieldT>>> last_polys(this->final_polynomial_handles_.size());
+    for (size_t j = 0; j < this->final_polynomial_handles_.size(); j++)
+    {
+        for (auto &handle : this->final_polynomial_handles_[j])
+        {
+            last_polys[j].emplace_back(this->IOP_.receive_prover_message(handle));
+        }
+    }
+    std::vector<FieldT> last_poly_at_si(num_query_sets);
+#ifdef MULTICORE
+    #pragma omp parallel for if (num_query_sets * this->final_polynomial_degree_bound_ >= parallel_min_size)
+#endif
+    for (size_t q = 0; q < num_query_sets; q++)
+    {
+        const FRI_query_set &Q = this->query_sets_[q];
+        last_poly_at_si[q] = last_polys[Q.interaction_index_][Q.LDT_index_].evaluation_at_point(si[q]);
+    }
 
-    if (last_poly_at_si != last_interpolation)
+    bool decision = true;
+    for (size_t q = 0; q < num_query_sets; q++)
     {
-        decision = false;
+        if (!query_set_accepted[q] || last_poly_at_si[q] != last_interpolations[q])
+        {
+            decision = false;
+        }
     }
 
+    libff::print_indent(); printf("* Number of FRI interactions: %zu\n", this->params_.interactive_repetitions());
+    libff::print_indent(); printf("* Number of FRI query sets per interaction: %zu\n",
+        this->query_sets_.size() / this->params_.interactive_repetitions());
+    libff::print_indent(); printf("* Total number of FRI queries over all query sets (incl. repeated queries): %zu\n", this->num_queries_made_);
+    // libff::print_indent(); printf("* Analytical expression: %zu\n", (2 + ((this->num_reductions_ - 1) << this->localization_parameter_)) * this->query_sets_.size());
+
     return decision;
 }
 
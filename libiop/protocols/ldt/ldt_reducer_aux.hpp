@@ -15,8 +15,10 @@ appearing in the random linear combiniation.
 #define LIBIOP_PROTOCOLS_LDT_LDT_REDUCER_AUX_HPP_
 
 #include <algorithm>
+#include <vector>
 
 #include "libiop/algebra/exponentiation.hpp"
+#include "libiop/algebra/field_kernels.hpp"
 #include "libiop/iop/iop.hpp"
 #include "libiop/iop/utilities/batching.hpp"
 #include "libiop/protocols/ldt/multi_ldt_base.hpp"
@@ -24,7 +26,7 @@ appearing in the random linear combiniation.
 namespace libiop {
 
 template<typename FieldT>
-class combined_LDT_virtual_oracle : public virtual_oracle<FieldT> {
+class combined_LDT_virtual_oracle : public pointwise_virtual_oracle<FieldT> {
 protected:
     field_subset<FieldT> codeword_domain_;
     std::vector<std::size_t> input_oracle_degrees_;
@@ -36,14 +38,22 @@ protected:
 
     std::vector<std::size_t> submaximal_oracle_indices_;
     std::vector<std::size_t> maximal_oracle_indices_;
+
+    /* The distinct differences max degree - degree(f) over submaximal oracles f, and for each
+       submaximal oracle, the position of its own difference there */
+    std::vector<std::size_t> degree_differences_;
+    std::vector<std::size_t> degree_difference_indices_;
 public:
     combined_LDT_virtual_oracle(const field_subset<FieldT> &codeword_domain,
                                 const std::vector<std::size_t>& input_oracle_degrees);
 
     void set_random_coefficients(const std::vector<FieldT>& random_coefficients);
 
-    std::shared_ptr<std::vector<FieldT>> evaluated_contents(
-        const std::vector<std::shared_ptr<std::vector<FieldT>>> &constituent_oracle_evaluations) const;
+    void evaluate_block(
+        const std::size_t begin,
+        const std::size_t end,
+        const std::vector<const FieldT*> &constituent_blocks,
+        FieldT *out) const;
 
     FieldT evaluation_at_point(
         const std::size_t evaluation_position,
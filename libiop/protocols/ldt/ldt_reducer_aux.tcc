@@ -21,6 +21,22 @@ combined_LDT_virtual_oracle<FieldT>::combined_LDT_virtual_oracle(
             this->maximal_oracle_indices_.emplace_back(i);
         }
     }
+
+    for (const std::size_t index : this->submaximal_oracle_indices_)
+    {
+        this->degree_differences_.emplace_back(this->max_degree_ - this->input_oracle_degrees_[index]);
+    }
+    std::sort(this->degree_differences_.begin(), this->degree_differences_.end());
+    this->degree_differences_.erase(
+        std::unique(this->degree_differences_.begin(), this->degree_differences_.end()),
+        this->degree_differences_.end());
+    for (const std::size_t index : this->submaximal_oracle_indices_)
+    {
+        const std::size_t degree_diff = this->max_degree_ - this->input_oracle_degrees_[index];
+        this->degree_difference_indices_.emplace_back(
+            std::lower_bound(this->degree_differences_.begin(), this->degree_differences_.end(), degree_diff) -
+            this->degree_differences_.begin());
+    }
 }
 
 template<typename FieldT>
@@ -37,31 +53,25 @@ void combined_LDT_virtual_oracle<FieldT>::set_random_coefficients(
 }
 
 template<typename FieldT>
-std::shared_ptr<std::vector<FieldT>> combined_LDT_virtual_oracle<FieldT>::evaluated_contents(
-    const std::vector<std::shared_ptr<std::vector<FieldT>>> &constituent_oracle_evaluations) const
+void combined_LDT_virtual_oracle<FieldT>::evaluate_block(
+    const std::size_t begin,
+    const std::size_t end,
+    const std::vector<const FieldT*> &constituent_blocks,
+    FieldT *out) const
 {
-    if (constituent_oracle_evaluations.size() != this->num_input_oracles_)
+    if (constituent_blocks.size() != this->num_input_oracles_)
     {
         throw std::invalid_argument("Expected same number of evaluations as in registration.");
     }
 
-    std::shared_ptr<std::vector<FieldT>> result = std::make_shared<std::vector<FieldT>>
-        (constituent_oracle_evaluations[0]->size(), FieldT::zero());
+    const std::size_t block_size = end - begin;
+    std::fill(out, out + block_size, FieldT::zero());
 
     /* Handle maximal degree oracles */
     for (size_t i = 0; i < this->maximal_oracle_indices_.size(); i++)
     {
         const size_t index = this->maximal_oracle_indices_[i];
-        if (constituent_oracle_evaluations[index]->size() != result->size())
-        {
-            throw std::invalid_argument("Vectors of mismatched size.");
-        }
-
-        for (std::size_t j = 0; j < result->size(); ++j)
-        {
-            result->operator[](j) += this->coefficients_[index] *
-                constituent_oracle_evaluations[index]->operator[](j);
-        }
+        fma_by_constant<FieldT>(out, constituent_blocks[index], block_size, this->coefficients_[index]);
     }
 
     /** Now deal with submaximal oracles.
@@ -70,32 +80,39 @@ std::shared_ptr<std::vector<FieldT>> combined_LDT_virtual_oracle<FieldT>::evalua
      *
      *  In the multiplicative case, we can compute r_2 * x^shift directly
      *  with no additional multiplications.
-     *  In the additive case, we re-use shift coefficients whenever possible instead.
-     *  TODO: Implement re-using coefficients,
-     *        multiplicative case benchmark re-using coefficients vs combined method,
+     *  In the additive case, the powers of each distinct shift are computed once per block,
+     *  and shared between the oracles with that shift.
+     *  TODO: multiplicative case benchmark re-using coefficients vs combined method,
      *        re-using may be faster after some threshold due to data-dependency concerns
      * */
     if (this->codeword_domain_.type() == affine_subspace_type)
     {
+        /* The powers are only tabulated for this block, so that a whole codeword's worth never
+           lives in memory at once. The block is itself an affine subspace: the span of the
+           first basis vectors of the codeword domain, shifted by its first element. */
+        const std::vector<FieldT> &basis = this->codeword_domain_.basis();
+        const affine_subspace<FieldT> block_domain(
+            std::vector<FieldT>(basis.begin(), basis.begin() + libff::log2(block_size)),
+            this->codeword_domain_.element_by_index(begin));
+        const std::vector<std::vector<FieldT>> block_powers =
+            subspace_element_powers_for_exponents(block_domain, this->degree_differences_);
+
         for (std::size_t i = 0; i < this->submaximal_oracle_indices_.size(); ++i)
         {
             /* Which oracle are we dealing with now? */
             const std::size_t submaximal_oracle_index =
                 this->submaximal_oracle_indices_[i];
 
-            /* Raise each element in the codeword domain to the power of the degree difference. */
-            const std::vector<FieldT> bump_factors =
-                subset_element_powers(
-                    this->codeword_domain_,
-                    this->max_degree_ - this->input_oracle_degrees_[submaximal_oracle_index]);
+            /* Each element of the block raised to the power of the degree difference. */
+            const FieldT *bump_factors = block_powers[this->degree_difference_indices_[i]].data();
 
-            for (std::size_t j = 0; j < result->size(); ++j)
+            const FieldT *evaluations = constituent_blocks[submaximal_oracle_index];
+            for (std::size_t j = 0; j < block_size; ++j)
             {
-                result->operator[](j) += (
+                out[j] += (
                     this->coefficients_[submaximal_oracle_index] +
                     this->coefficients_[this->num_input_oracles_ + i] *
-                    bump_factors[j]) *
-                    constituent_oracle_evaluations[submaximal_oracle_index]->operator[](j);
+                    bump_factors[j]) * evaluations[j];
             }
         }
     }
@@ -109,23 +126,22 @@ std::shared_ptr<std::vector<FieldT>> combined_LDT_virtual_oracle<FieldT>::evalua
 
             /* cur_bump_factor = r_{shifted index} * elem^shift */
             const size_t shift = this->max_degree_ - this->input_oracle_degrees_[submaximal_oracle_index];
-            FieldT cur_bump_factor = this->coefficients_[this->num_input_oracles_ + i] *
-                libff::power(this->codeword_domain_.shift(), shift);
             const FieldT bump_factor_inc =
                 libff::power(this->codeword_domain_.generator(), shift);
+            FieldT cur_bump_factor = this->coefficients_[this->num_input_oracles_ + i] *
+                libff::power(this->codeword_domain_.shift(), shift) *
+                libff::power(bump_factor_inc, begin);
 
-            for (std::size_t j = 0; j < result->size(); ++j)
+            const FieldT *evaluations = constituent_blocks[submaximal_oracle_index];
+            for (std::size_t j = 0; j < block_size; ++j)
             {
-                result->operator[](j) += (
+                out[j] += (
                     this->coefficients_[submaximal_oracle_index] +
-                    cur_bump_factor) *
-                    constituent_oracle_evaluations[submaximal_oracle_index]->operator[](j);
+                    cur_bump_factor) * evaluations[j];
                 cur_bump_factor *= bump_factor_inc;
             }
         }
     }
-
-    return result;
 }
 
 template<typename FieldT>
@@ -11,6 +11,7 @@
 
 #include <cstddef>
 #include <memory>
+#include <vector>
 
 #include "libiop/relations/r1cs.hpp"
 #include "libiop/relations/variable.hpp"
@@ -27,6 +28,12 @@ public:
     virtual std::size_t num_columns() const = 0;
     virtual std::size_t num_nonzero_entries() const = 0;
 
+    /** Returns M v. v must have at least num_columns() entries. */
+    virtual std::vector<FieldT> multiply(const std::vector<FieldT> &v) const;
+    /** Returns M^T v, with num_columns() entries. v holds the first v.size() <= num_rows()
+     *  entries of the vector, and the rest are zero. */
+    virtual std::vector<FieldT> transpose_multiply(const std::vector<FieldT> &v) const;
+
     virtual ~sparse_matrix() = default;
 };
 
@@ -38,20 +45,68 @@ enum r1cs_sparse_matrix_type {
 
 extern std::vector<r1cs_sparse_matrix_type> all_r1cs_sparse_matrix_types;
 
+/** Compressed sparse row matrix. The entries of row i are at positions
+ *  row_offsets()[i] to row_offsets()[i+1] of column_indices() and coefficients(),
+ *  so products walk two flat arrays instead of building a linear combination per row.
+ *  multiply and transpose_multiply split the rows across threads in MULTICORE builds. */
+template<typename FieldT>
+class csr_sparse_matrix : public sparse_matrix<FieldT> {
+protected:
+    std::size_t num_columns_ = 0;
+    std::vector<std::size_t> row_offsets_ = {0};
+    std::vector<std::size_t> column_indices_;
+    std::vector<FieldT> coefficients_;
+
+    void append_row(const linear_combination<FieldT> &row);
+public:
+    csr_sparse_matrix() = default;
+    explicit csr_sparse_matrix(const sparse_matrix<FieldT> &matrix);
+    /* Has as many columns as one past the largest index used */
+    explicit csr_sparse_matrix(const naive_sparse_matrix<FieldT> &matrix);
+    csr_sparse_matrix(const r1cs_constraint_system<FieldT> &constraint_system,
+                      const r1cs_sparse_matrix_type matrix_type);
+
+    /** Appends empty rows until there are num_rows of them. */
+    void pad_rows(const std::size_t num_rows);
+
+    const std::vector<std::size_t> &row_offsets() const;
+    const std::vector<std::size_t> &column_indices() const;
+    const std::vector<FieldT> &coefficients() const;
+
+    virtual linear_combination<FieldT> get_row(const std::size_t row_index) const;
+    virtual std::size_t num_rows() const;
+    virtual std::size_t num_columns() const;
+    virtual std::size_t num_nonzero_entries() const;
+
+    virtual std::vector<FieldT> multiply(const std::vector<FieldT> &v) const;
+    virtual std::vector<FieldT> transpose_multiply(const std::vector<FieldT> &v) const;
+};
+
+/** One of the R1CS matrices, read in place from the constraint system rather than copied.
+ *  Each row is already a flat vector of terms, so the products walk the constraints directly
+ *  and split the rows across threads in MULTICORE builds, like the CSR ones. */
 template<typename FieldT>
 class r1cs_sparse_matrix : public sparse_matrix<FieldT> {
 protected:
     std::shared_ptr<r1cs_constraint_system<FieldT> > constraint_system_;
     r1cs_sparse_matrix_type matrix_type_;
+    std::size_t num_nonzero_entries_ = 0;
 public:
     r1cs_sparse_matrix(
         std::shared_ptr<r1cs_constraint_system<FieldT> > constraint_system,
         const r1cs_sparse_matrix_type matrix_type);
 
+    /** The row itself, in the constraint system, where get_row returns a copy of it.
+     *  Does not check bounds. */
+    const linear_combination<FieldT> &row(const std::size_t row_index) const;
+
     virtual linear_combination<FieldT> get_row(const std::size_t row_index) const;
     virtual std::size_t num_rows() const;
     virtual std::size_t num_columns() const;
     virtual std::size_t num_nonzero_entries() const;
+
+    virtual std::vector<FieldT> multiply(const std::vector<FieldT> &v) const;
+    virtual std::vector<FieldT> transpose_multiply(const std::vector<FieldT> &v) const;
 };
 
 } // libiop
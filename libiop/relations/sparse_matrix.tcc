@@ -1,37 +1,288 @@
+#include <algorithm>
 #include <stdexcept>
 
+#include "libiop/common/parallel.hpp"
+
 namespace libiop {
 
 template<typename FieldT>
-r1cs_sparse_matrix<FieldT>::r1cs_sparse_matrix(
-    std::shared_ptr<r1cs_constraint_system<FieldT> > constraint_system,
+std::vector<FieldT> sparse_matrix<FieldT>::multiply(const std::vector<FieldT> &v) const
+{
+    if (v.size() < this->num_columns())
+    {
+        throw std::invalid_argument("Vector is shorter than the number of columns.");
+    }
+
+    std::vector<FieldT> result(this->num_rows(), FieldT::zero());
+    for (std::size_t i = 0; i < this->num_rows(); ++i)
+    {
+        const linear_combination<FieldT> row = this->get_row(i);
+        for (auto &term : row.terms)
+        {
+            result[i] += term.coeff_ * v[term.index_];
+        }
+    }
+    return result;
+}
+
+template<typename FieldT>
+std::vector<FieldT> sparse_matrix<FieldT>::transpose_multiply(const std::vector<FieldT> &v) const
+{
+    std::vector<FieldT> result(this->num_columns(), FieldT::zero());
+    for (std::size_t i = 0; i < v.size(); ++i)
+    {
+        const linear_combination<FieldT> row = this->get_row(i);
+        for (auto &term : row.terms)
+        {
+            result[term.index_] += term.coeff_ * v[i];
+        }
+    }
+    return result;
+}
+
+template<typename FieldT>
+csr_sparse_matrix<FieldT>::csr_sparse_matrix(const sparse_matrix<FieldT> &matrix) :
+    num_columns_(matrix.num_columns())
+{
+    const std::size_t num_entries = matrix.num_nonzero_entries();
+    this->row_offsets_.reserve(matrix.num_rows() + 1);
+    this->column_indices_.reserve(num_entries);
+    this->coefficients_.reserve(num_entries);
+    for (std::size_t i = 0; i < matrix.num_rows(); ++i)
+    {
+        this->append_row(matrix.get_row(i));
+    }
+}
+
+template<typename FieldT>
+csr_sparse_matrix<FieldT>::csr_sparse_matrix(const naive_sparse_matrix<FieldT> &matrix)
+{
+    this->row_offsets_.reserve(matrix.size() + 1);
+    for (const std::map<std::size_t, FieldT> &row : matrix)
+    {
+        for (const std::pair<const std::size_t, FieldT> &entry : row)
+        {
+            this->column_indices_.emplace_back(entry.first);
+            this->coefficients_.emplace_back(entry.second);
+            this->num_columns_ = std::max(this->num_columns_, entry.first + 1);
+        }
+        this->row_offsets_.emplace_back(this->column_indices_.size());
+    }
+}
+
+template<typename FieldT>
+csr_sparse_matrix<FieldT>::csr_sparse_matrix(
+    const r1cs_constraint_system<FieldT> &constraint_system,
     const r1cs_sparse_matrix_type matrix_type) :
-    constraint_system_(constraint_system),
-    matrix_type_(matrix_type)
+    num_columns_(constraint_system.num_variables() + 1)
 {
+    this->row_offsets_.reserve(constraint_system.num_constraints() + 1);
+    for (const r1cs_constraint<FieldT> &constraint : constraint_system.constraints_)
+    {
+        switch (matrix_type)
+        {
+        case r1cs_sparse_matrix_A:
+            this->append_row(constraint.a_);
+            break;
+        case r1cs_sparse_matrix_B:
+            this->append_row(constraint.b_);
+            break;
+        case r1cs_sparse_matrix_C:
+            this->append_row(constraint.c_);
+            break;
+        default:
+            throw std::logic_error("Invalid matrix type.");
+        }
+    }
 }
 
 template<typename FieldT>
-linear_combination<FieldT> r1cs_sparse_matrix<FieldT>::get_row(const std::size_t row_index) const
+void csr_sparse_matrix<FieldT>::append_row(const linear_combination<FieldT> &row)
+{
+    for (auto &term : row.terms)
+    {
+        this->column_indices_.emplace_back(term.index_);
+        this->coefficients_.emplace_back(term.coeff_);
+    }
+    this->row_offsets_.emplace_back(this->column_indices_.size());
+}
+
+template<typename FieldT>
+void csr_sparse_matrix<FieldT>::pad_rows(const std::size_t num_rows)
+{
+    if (num_rows > this->num_rows())
+    {
+        this->row_offsets_.resize(num_rows + 1, this->column_indices_.size());
+    }
+}
+
+template<typename FieldT>
+const std::vector<std::size_t> &csr_sparse_matrix<FieldT>::row_offsets() const
+{
+    return this->row_offsets_;
+}
+
+template<typename FieldT>
+const std::vector<std::size_t> &csr_sparse_matrix<FieldT>::column_indices() const
+{
+    return this->column_indices_;
+}
+
+template<typename FieldT>
+const std::vector<FieldT> &csr_sparse_matrix<FieldT>::coefficients() const
+{
+    return this->coefficients_;
+}
+
+template<typename FieldT>
+linear_combination<FieldT> csr_sparse_matrix<FieldT>::get_row(const std::size_t row_index) const
 {
     if (row_index >= this->num_rows())
     {
         throw std::invalid_argument("Requested row out of bounds.");
     }
 
+    linear_combination<FieldT> row;
+    row.terms.reserve(this->row_offsets_[row_index + 1] - this->row_offsets_[row_index]);
+    for (std::size_t k = this->row_offsets_[row_index]; k < this->row_offsets_[row_index + 1]; ++k)
+    {
+        row.add_term(variable<FieldT>(this->column_indices_[k]), this->coefficients_[k]);
+    }
+    return row;
+}
+
+template<typename FieldT>
+std::size_t csr_sparse_matrix<FieldT>::num_rows() const
+{
+    return this->row_offsets_.size() - 1;
+}
+
+template<typename FieldT>
+std::size_t csr_sparse_matrix<FieldT>::num_columns() const
+{
+    return this->num_columns_;
+}
+
+template<typename FieldT>
+std::size_t csr_sparse_matrix<FieldT>::num_nonzero_entries() const
+{
+    return this->column_indices_.size();
+}
+
+template<typename FieldT>
+std::vector<FieldT> csr_sparse_matrix<FieldT>::multiply(const std::vector<FieldT> &v) const
+{
+    if (v.size() < this->num_columns_)
+    {
+        throw std::invalid_argument("Vector is shorter than the number of columns.");
+    }
+
+    const std::size_t n = this->num_rows();
+    std::vector<FieldT> result(n);
+#ifdef MULTICORE
+    #pragma omp parallel for if (this->num_nonzero_entries() >= parallel_min_size)
+#endif
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        FieldT sum = FieldT::zero();
+        for (std::size_t k = this->row_offsets_[i]; k < this->row_offsets_[i + 1]; ++k)
+        {
+            sum += this->coefficients_[k] * v[this->column_indices_[k]];
+        }
+        result[i] = sum;
+    }
+    return result;
+}
+
+/* Each chunk of rows scatters into its own copy of the result, and the copies are then summed
+   column by column, so that no two threads write to the same entry. */
+template<typename FieldT>
+std::vector<FieldT> csr_sparse_matrix<FieldT>::transpose_multiply(const std::vector<FieldT> &v) const
+{
+    if (v.size() > this->num_rows())
+    {
+        throw std::invalid_argument("Requested row out of bounds.");
+    }
+
+    const std::size_t num_chunks = (this->row_offsets_[v.size()] >= parallel_min_size) ?
+        num_parallel_chunks(v.size()) : 1;
+    std::vector<std::vector<FieldT>> partial_results(num_chunks, std::vector<FieldT>(this->num_columns_, FieldT::zero()));
+#ifdef MULTICORE
+    #pragma omp parallel for if (num_chunks > 1)
+#endif
+    for (std::size_t c = 0; c < num_chunks; ++c)
+    {
+        std::vector<FieldT> &partial_result = partial_results[c];
+        const std::size_t end = chunk_begin(c + 1, num_chunks, v.size());
+        for (std::size_t i = chunk_begin(c, num_chunks, v.size()); i < end; ++i)
+        {
+            for (std::size_t k = this->row_offsets_[i]; k < this->row_offsets_[i + 1]; ++k)
+            {
+                partial_result[this->column_indices_[k]] += this->coefficients_[k] * v[i];
+            }
+        }
+    }
+
+    std::vector<FieldT> result(std::move(partial_results[0]));
+#ifdef MULTICORE
+    #pragma omp parallel for if (num_chunks > 1 && this->num_columns_ >= parallel_min_size)
+#endif
+    for (std::size_t j = 0; j < this->num_columns_; ++j)
+    {
+        for (std::size_t c = 1; c < num_chunks; ++c)
+        {
+            result[j] += partial_results[c][j];
+        }
+    }
+    return result;
+}
+
+template<typename FieldT>
+r1cs_sparse_matrix<FieldT>::r1cs_sparse_matrix(
+    std::shared_ptr<r1cs_constraint_system<FieldT> > constraint_system,
+    const r1cs_sparse_matrix_type matrix_type) :
+    constraint_system_(constraint_system),
+    matrix_type_(matrix_type)
+{
+    if (matrix_type != r1cs_sparse_matrix_A &&
+        matrix_type != r1cs_sparse_matrix_B &&
+        matrix_type != r1cs_sparse_matrix_C)
+    {
+        throw std::logic_error("Invalid matrix type.");
+    }
+
+    for (std::size_t i = 0; i < this->num_rows(); ++i)
+    {
+        this->num_nonzero_entries_ += this->row(i).terms.size();
+    }
+}
+
+template<typename FieldT>
+const linear_combination<FieldT> &r1cs_sparse_matrix<FieldT>::row(const std::size_t row_index) const
+{
+    const r1cs_constraint<FieldT> &constraint = this->constraint_system_->constraints_[row_index];
     switch (this->matrix_type_)
     {
     case r1cs_sparse_matrix_A:
-        return this->constraint_system_->constraints_[row_index].a_;
+        return constraint.a_;
     case r1cs_sparse_matrix_B:
-        return this->constraint_system_->constraints_[row_index].b_;
-    case r1cs_sparse_matrix_C:
-        return this->constraint_system_->constraints_[row_index].c_;
+        return constraint.b_;
     default:
-        throw std::logic_error("Invalid matrix type.");
+        return constraint.c_;
     }
 }
 
+template<typename FieldT>
+linear_combination<FieldT> r1cs_sparse_matrix<FieldT>::get_row(const std::size_t row_index) const
+{
+    if (row_index >= this->num_rows())
+    {
+        throw std::invalid_argument("Requested row out of bounds.");
+    }
+
+    return this->row(row_index);
+}
+
 template<typename FieldT>
 std::size_t r1cs_sparse_matrix<FieldT>::num_rows() const
 {
@@ -44,18 +295,85 @@ std::size_t r1cs_sparse_matrix<FieldT>::num_columns() const
     return this->constraint_system_->num_variables() + 1;
 }
 
-/** TODO: To save an iteration over the (potentially large) matrix,
- *  we should build this value during matrix construction. */
 template<typename FieldT>
 std::size_t r1cs_sparse_matrix<FieldT>::num_nonzero_entries() const
 {
-    size_t total_nonzero_entries = 0;
-    for (size_t i = 0; i < this->constraint_system_->num_constraints(); i++)
+    return this->num_nonzero_entries_;
+}
+
+template<typename FieldT>
+std::vector<FieldT> r1cs_sparse_matrix<FieldT>::multiply(const std::vector<FieldT> &v) const
+{
+    if (v.size() < this->num_columns())
+    {
+        throw std::invalid_argument("Vector is shorter than the number of columns.");
+    }
+
+    const std::size_t n = this->num_rows();
+    std::vector<FieldT> result(n);
+#ifdef MULTICORE
+    #pragma omp parallel for if (this->num_nonzero_entries_ >= parallel_min_size)
+#endif
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        FieldT sum = FieldT::zero();
+        for (const linear_term<FieldT> &term : this->row(i).terms)
+        {
+            sum += term.coeff_ * v[term.index_];
+        }
+        result[i] = sum;
+    }
+    return result;
+}
+
+/* Chunked the same way as csr_sparse_matrix::transpose_multiply */
+template<typename FieldT>
+std::vector<FieldT> r1cs_sparse_matrix<FieldT>::transpose_multiply(const std::vector<FieldT> &v) const
+{
+    if (v.size() > this->num_rows())
+    {
+        throw std::invalid_argument("Requested row out of bounds.");
+    }
+
+    /* Only the entries of the first v.size() rows are used */
+    std::size_t num_entries_used = 0;
+    for (std::size_t i = 0; i < v.size(); ++i)
+    {
+        num_entries_used += this->row(i).terms.size();
+    }
+
+    const std::size_t num_columns = this->num_columns();
+    const std::size_t num_chunks = (num_entries_used >= parallel_min_size) ?
+        num_parallel_chunks(v.size()) : 1;
+    std::vector<std::vector<FieldT>> partial_results(num_chunks, std::vector<FieldT>(num_columns, FieldT::zero()));
+#ifdef MULTICORE
+    #pragma omp parallel for if (num_chunks > 1)
+#endif
+    for (std::size_t c = 0; c < num_chunks; ++c)
+    {
+        std::vector<FieldT> &partial_result = partial_results[c];
+        const std::size_t end = chunk_begin(c + 1, num_chunks, v.size());
+        for (std::size_t i = chunk_begin(c, num_chunks, v.size()); i < end; ++i)
+        {
+            for (const linear_term<FieldT> &term : this->row(i).terms)
+            {
+                partial_result[term.index_] += term.coeff_ * v[i];
+            }
+        }
+    }
+
+    std::vector<FieldT> result(std::move(partial_results[0]));
+#ifdef MULTICORE
+    #pragma omp parallel for if (num_chunks > 1 && num_columns >= parallel_min_size)
+#endif
+    for (std::size_t j = 0; j < num_columns; ++j)
     {
-        linear_combination<FieldT> row = this->get_row(i);
-        total_nonzero_entries += row.terms.size();
+        for (std::size_t c = 1; c < num_chunks; ++c)
+        {
+            result[j] += partial_results[c][j];
+        }
     }
-    return total_nonzero_entries;
+    return result;
 }
 
 } // libiop
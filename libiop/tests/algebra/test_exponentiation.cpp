@@ -43,6 +43,24 @@ TEST(ExponentiationTest, SubspaceElementPowersTest) {
     }
 }
 
+TEST(ExponentiationTest, SubspaceElementPowersForExponentsTest) {
+    typedef libff::gf64 FieldT;
+
+    const std::size_t dimension = 10;
+    const affine_subspace<FieldT> S = affine_subspace<FieldT>::random_affine_subspace(dimension);
+
+    /* Unsorted, with repeats, zero, and exponents whose bits contain those of others */
+    const std::vector<std::size_t> exponents({ 13, 1, 5, 0, 13, 64, 77, 6, 1023 });
+    const std::vector<std::vector<FieldT>> powers =
+        subspace_element_powers_for_exponents(S, exponents);
+
+    ASSERT_EQ(powers.size(), exponents.size());
+    for (std::size_t i = 0; i < exponents.size(); ++i)
+    {
+        EXPECT_EQ(powers[i], domain_element_powers_naive(field_subset<FieldT>(S), exponents[i]));
+    }
+}
+
 TEST(ExponentiationTest, CosetElementPowersTest) {    
     libff::edwards_pp::init_public_params();
     typedef libff::edwards_Fr FieldT;
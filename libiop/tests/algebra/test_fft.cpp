@@ -5,6 +5,9 @@
 #include <libff/algebra/curves/edwards/edwards_pp.hpp>
 
 #include <libff/algebra/fields/binary/gf64.hpp>
+#include <libff/algebra/fields/binary/gf128.hpp>
+#include <libff/algebra/fields/binary/gf256.hpp>
+#include "libiop/common/parallel.hpp"
 #include "libiop/algebra/utils.hpp"
 #include "libiop/algebra/fft.hpp"
 #include "libiop/algebra/field_subset/subspace.hpp"
@@ -51,6 +54,130 @@ TEST(AdditiveTest, SimpleTest) {
     }
 }
 
+template<typename FieldT>
+void run_cantor_test(const size_t max_dim)
+{
+    for (size_t m = 1; m <= max_dim; ++m)
+    {
+        const std::vector<FieldT> poly_coeffs = random_FieldT_vector<FieldT>(1ull<<m);
+        const linear_subspace<FieldT> cantor_basis = linear_subspace<FieldT>::cantor_basis(m);
+        const std::vector<FieldT> shifts = {
+            FieldT::zero(),
+            affine_subspace<FieldT>(cantor_basis).element_outside_of_subset(),
+            FieldT::random_element() };
+
+        for (const FieldT &shift : shifts)
+        {
+            const affine_subspace<FieldT> domain(cantor_basis, shift);
+
+            /* Cantor equals naive */
+            const std::vector<FieldT> naive_result =
+                naive_FFT<FieldT>(poly_coeffs, field_subset<FieldT>(domain));
+            const std::vector<FieldT> cantor_result =
+                cantor_additive_FFT<FieldT>(poly_coeffs, domain);
+
+            EXPECT_EQ(naive_result, cantor_result);
+
+            /* Inverse interpolates naive */
+            const std::vector<FieldT> interpolation =
+                cantor_additive_IFFT<FieldT>(naive_result, domain);
+
+            EXPECT_EQ(interpolation, poly_coeffs);
+        }
+    }
+}
+
+TEST(CantorTest, SimpleTest) {
+    run_cantor_test<libff::gf128>(11);
+    run_cantor_test<libff::gf256>(9);
+}
+
+TEST(CantorTest, LowDegreeTest) {
+    typedef libff::gf128 FieldT;
+
+    const size_t m = 10;
+    const std::vector<FieldT> poly_coeffs = random_FieldT_vector<FieldT>(37);
+    const affine_subspace<FieldT> domain =
+        affine_subspace<FieldT>::shifted_cantor_basis(m, FieldT::random_element());
+
+    const std::vector<FieldT> naive_result =
+        naive_FFT<FieldT>(poly_coeffs, field_subset<FieldT>(domain));
+    const std::vector<FieldT> cantor_result =
+        cantor_additive_FFT<FieldT>(poly_coeffs, domain);
+
+    EXPECT_EQ(naive_result, cantor_result);
+}
+
+template<typename FieldT>
+void run_degree_aware_test(const field_subset<FieldT> &domain)
+{
+    std::vector<size_t> poly_sizes({1});
+    for (size_t k = 0; k < domain.dimension(); ++k)
+    {
+        poly_sizes.emplace_back((1ull<<k) + 1);
+        poly_sizes.emplace_back(2ull<<k);
+    }
+
+    for (const size_t poly_size : poly_sizes)
+    {
+        const std::vector<FieldT> poly_coeffs = random_vector<FieldT>(poly_size);
+        const std::vector<FieldT> naive_result = naive_FFT<FieldT>(poly_coeffs, domain);
+
+        EXPECT_EQ(FFT_over_field_subset<FieldT>(poly_coeffs, domain), naive_result);
+        EXPECT_EQ(additive_FFT<FieldT>(poly_coeffs, domain.subspace()), naive_result);
+        if (domain.subspace().is_cantor_basis())
+        {
+            EXPECT_EQ(cantor_additive_FFT<FieldT>(poly_coeffs, domain.subspace()), naive_result);
+        }
+
+        /* The batch is as long as its longest vector */
+        const std::vector<std::vector<FieldT>> batch_result = batch_FFT_over_field_subset<FieldT>(
+            {poly_coeffs, std::vector<FieldT>(poly_coeffs.begin(), poly_coeffs.begin() + poly_size/2 + 1)}, domain);
+        EXPECT_EQ(batch_result[0], naive_result);
+    }
+}
+
+TEST(DegreeAwareAdditiveTest, SimpleTest) {
+    typedef libff::gf256 FieldT;
+
+    for (size_t m = 1; m <= 8; ++m)
+    {
+        run_degree_aware_test<FieldT>(field_subset<FieldT>(
+            affine_subspace<FieldT>::random_affine_subspace(m)));
+        /* The external Cantor kernel only supports shifts that are Cantor basis elements */
+        const FieldT cantor_shift = linear_subspace<FieldT>::cantor_basis(m+1).basis()[m];
+        run_degree_aware_test<FieldT>(field_subset<FieldT>(
+            affine_subspace<FieldT>::shifted_cantor_basis(m, cantor_shift)));
+    }
+}
+
+#ifdef MULTICORE
+/* The parallel transforms must not depend on the number of threads used. */
+TEST(ParallelAdditiveTest, SimpleTest) {
+    typedef libff::gf128 FieldT;
+
+    const size_t m = 16;
+    const std::vector<FieldT> poly_coeffs = random_FieldT_vector<FieldT>(1ull<<m);
+    const affine_subspace<FieldT> gm_domain =
+        affine_subspace<FieldT>::random_affine_subspace(m);
+    const affine_subspace<FieldT> cantor_domain =
+        affine_subspace<FieldT>::shifted_cantor_basis(m, FieldT::random_element());
+
+    const int max_threads = omp_get_max_threads();
+    omp_set_num_threads(1);
+    const std::vector<FieldT> serial_gm = additive_FFT<FieldT>(poly_coeffs, gm_domain);
+    const std::vector<FieldT> serial_gm_inverse = additive_IFFT<FieldT>(poly_coeffs, gm_domain);
+    const std::vector<FieldT> serial_cantor = cantor_additive_FFT<FieldT>(poly_coeffs, cantor_domain);
+    const std::vector<FieldT> serial_cantor_inverse = cantor_additive_IFFT<FieldT>(poly_coeffs, cantor_domain);
+    omp_set_num_threads(max_threads);
+
+    EXPECT_EQ(serial_gm, additive_FFT<FieldT>(poly_coeffs, gm_domain));
+    EXPECT_EQ(serial_gm_inverse, additive_IFFT<FieldT>(poly_coeffs, gm_domain));
+    EXPECT_EQ(serial_cantor, cantor_additive_FFT<FieldT>(poly_coeffs, cantor_domain));
+    EXPECT_EQ(serial_cantor_inverse, cantor_additive_IFFT<FieldT>(poly_coeffs, cantor_domain));
+}
+#endif
+
 TEST(MultiplicativeSubgroupTest, SimpleTest) {
     libff::edwards_pp::init_public_params();
     typedef libff::edwards_Fr FieldT;
@@ -120,6 +247,177 @@ TEST(MultiplicativeCosetTest, SimpleTest) {
     }
 }
 
+template<typename FieldT>
+void run_batch_test(const field_subset<FieldT> &domain, const size_t num_polys)
+{
+    std::vector<std::vector<FieldT>> polys_coeffs;
+    for (size_t i = 0; i < num_polys; ++i)
+    {
+        /* Vectors shorter than the domain are zero padded */
+        polys_coeffs.emplace_back(elementwise_random_vector<FieldT>(domain.num_elements() - i));
+    }
+
+    const std::vector<std::vector<FieldT>> batch_evals =
+        batch_FFT_over_field_subset<FieldT>(polys_coeffs, domain);
+    ASSERT_EQ(batch_evals.size(), num_polys);
+    for (size_t i = 0; i < num_polys; ++i)
+    {
+        EXPECT_EQ(batch_evals[i], naive_FFT<FieldT>(polys_coeffs[i], domain));
+    }
+
+    const std::vector<std::vector<FieldT>> interpolations =
+        batch_IFFT_over_field_subset<FieldT>(batch_evals, domain);
+    ASSERT_EQ(interpolations.size(), num_polys);
+    for (size_t i = 0; i < num_polys; ++i)
+    {
+        std::vector<FieldT> padded_coeffs(polys_coeffs[i]);
+        padded_coeffs.resize(domain.num_elements(), FieldT::zero());
+        EXPECT_EQ(interpolations[i], padded_coeffs);
+    }
+}
+
+TEST(BatchTest, AdditiveTest) {
+    typedef libff::gf64 FieldT;
+
+    for (size_t m = 1; m <= 8; ++m)
+    {
+        const field_subset<FieldT> domain = field_subset<FieldT>(
+            affine_subspace<FieldT>::random_affine_subspace(m));
+        run_batch_test<FieldT>(domain, 1);
+        run_batch_test<FieldT>(domain, 2);
+    }
+}
+
+TEST(BatchTest, CantorTest) {
+    typedef libff::gf256 FieldT;
+
+    for (size_t m = 1; m <= 9; ++m)
+    {
+        const field_subset<FieldT> domain = field_subset<FieldT>(
+            affine_subspace<FieldT>::shifted_cantor_basis(m, FieldT::random_element()));
+        run_batch_test<FieldT>(domain, 1);
+        run_batch_test<FieldT>(domain, 3);
+    }
+}
+
+TEST(BatchTest, MultiplicativeTest) {
+    libff::edwards_pp::init_public_params();
+    typedef libff::edwards_Fr FieldT;
+
+    for (size_t m = 1; m <= 8; ++m)
+    {
+        const field_subset<FieldT> domain = field_subset<FieldT>(
+            multiplicative_coset<FieldT>(1ull<<m, FieldT::random_element()));
+        run_batch_test<FieldT>(domain, 3);
+    }
+}
+
+TEST(AdditiveFFTPlanTest, CachedTest) {
+    typedef libff::gf256 FieldT;
+
+    const field_subset<FieldT> domain = field_subset<FieldT>(
+        affine_subspace<FieldT>::random_affine_subspace(6));
+    const field_subset<FieldT> cantor_domain = field_subset<FieldT>(
+        affine_subspace<FieldT>::shifted_cantor_basis(6, FieldT::random_element()));
+
+    /* The plan is built once, and shared by all copies of the subspace */
+    EXPECT_EQ(domain.subspace().fft_plan(), domain.subspace().fft_plan());
+    EXPECT_EQ(domain.subspace().fft_plan()->type(), gao_mateer_additive_fft);
+    EXPECT_EQ(cantor_domain.subspace().fft_plan(), cantor_domain.subspace().fft_plan());
+    EXPECT_EQ(cantor_domain.subspace().fft_plan()->type(), cantor_additive_fft);
+
+    /* Repeated transforms with the cached plan agree with the naive FFT */
+    for (size_t i = 0; i < 3; ++i)
+    {
+        const std::vector<FieldT> poly_coeffs = random_vector<FieldT>(domain.num_elements());
+        EXPECT_EQ(FFT_over_field_subset<FieldT>(poly_coeffs, domain), naive_FFT<FieldT>(poly_coeffs, domain));
+        EXPECT_EQ(additive_FFT<FieldT>(poly_coeffs, cantor_domain.subspace()), naive_FFT<FieldT>(poly_coeffs, cantor_domain));
+        EXPECT_EQ(cantor_additive_FFT<FieldT>(poly_coeffs, cantor_domain.subspace()), naive_FFT<FieldT>(poly_coeffs, cantor_domain));
+    }
+}
+
+TEST(AdditiveFFTPlanTest, ConcurrentFirstUseTest) {
+    typedef libff::gf256 FieldT;
+
+    const field_subset<FieldT> domain = field_subset<FieldT>(
+        affine_subspace<FieldT>::random_affine_subspace(8));
+    const std::size_t num_transforms = 16;
+    std::vector<std::vector<FieldT>> poly_coeffs(num_transforms);
+    for (auto &coeffs : poly_coeffs)
+    {
+        coeffs = random_vector<FieldT>(domain.num_elements());
+    }
+
+    /* Every transform may be the first one on the domain, and so race to build its plan */
+    std::vector<std::vector<FieldT>> evals(num_transforms);
+#ifdef MULTICORE
+    #pragma omp parallel for
+#endif
+    for (std::size_t i = 0; i < num_transforms; ++i)
+    {
+        evals[i] = FFT_over_field_subset<FieldT>(poly_coeffs[i], domain);
+    }
+    for (std::size_t i = 0; i < num_transforms; ++i)
+    {
+        EXPECT_EQ(evals[i], naive_FFT<FieldT>(poly_coeffs[i], domain));
+    }
+}
+
+template<typename FieldT>
+void run_in_place_test(const field_subset<FieldT> &domain)
+{
+    for (size_t num_coeffs = 1; num_coeffs <= domain.num_elements(); num_coeffs *= 2)
+    {
+        const std::vector<FieldT> poly_coeffs = random_FieldT_vector<FieldT>(num_coeffs);
+
+        std::vector<FieldT> v;
+        v.reserve(domain.num_elements());
+        v.insert(v.end(), poly_coeffs.begin(), poly_coeffs.end());
+        const FieldT *buffer = v.data();
+        FFT_over_field_subset_in_place<FieldT>(v, domain);
+        /* Reserving the domain size up front means the transform never reallocates */
+        EXPECT_EQ(v.data(), buffer);
+        EXPECT_EQ(v, naive_FFT<FieldT>(poly_coeffs, domain));
+
+        IFFT_over_field_subset_in_place<FieldT>(v, domain);
+        EXPECT_EQ(v.data(), buffer);
+        std::vector<FieldT> padded_coeffs(poly_coeffs);
+        padded_coeffs.resize(domain.num_elements(), FieldT::zero());
+        EXPECT_EQ(v, padded_coeffs);
+    }
+}
+
+TEST(InPlaceTest, AdditiveTest) {
+    typedef libff::gf64 FieldT;
+
+    for (size_t m = 1; m <= 8; ++m)
+    {
+        run_in_place_test<FieldT>(field_subset<FieldT>(
+            affine_subspace<FieldT>::random_affine_subspace(m)));
+    }
+}
+
+TEST(InPlaceTest, CantorTest) {
+    typedef libff::gf256 FieldT;
+
+    for (size_t m = 1; m <= 8; ++m)
+    {
+        run_in_place_test<FieldT>(field_subset<FieldT>(
+            affine_subspace<FieldT>::shifted_cantor_basis(m, FieldT::random_element())));
+    }
+}
+
+TEST(InPlaceTest, MultiplicativeTest) {
+    libff::edwards_pp::init_public_params();
+    typedef libff::edwards_Fr FieldT;
+
+    for (size_t m = 1; m <= 8; ++m)
+    {
+        run_in_place_test<FieldT>(field_subset<FieldT>(
+            multiplicative_coset<FieldT>(1ull<<m, FieldT::random_element())));
+    }
+}
+
 TEST(ExtendedRangeTest, SimpleTest) {
     typedef libff::gf64 FieldT;
 
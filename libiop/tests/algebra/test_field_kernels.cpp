@@ -0,0 +1,91 @@
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include <libff/algebra/curves/edwards/edwards_pp.hpp>
+#include <libff/algebra/fields/binary/gf64.hpp>
+#include <libff/algebra/fields/binary/gf128.hpp>
+#include <libff/algebra/fields/binary/gf192.hpp>
+#include <libff/algebra/fields/binary/gf256.hpp>
+#include "libiop/algebra/field_kernels.hpp"
+#include "libiop/algebra/utils.hpp"
+
+namespace libiop {
+
+template<typename FieldT>
+void run_field_kernels_test()
+{
+    for (size_t n = 0; n <= 37; ++n)
+    {
+        const std::vector<FieldT> in = random_FieldT_vector<FieldT>(n);
+        const std::vector<FieldT> out = random_FieldT_vector<FieldT>(n);
+        const FieldT c = FieldT::random_element();
+
+        std::vector<FieldT> products(in);
+        mul_by_constant<FieldT>(products.data(), n, c);
+        std::vector<FieldT> sums(out);
+        fma_by_constant<FieldT>(sums.data(), in.data(), n, c);
+        for (size_t i = 0; i < n; ++i)
+        {
+            EXPECT_EQ(products[i], in[i] * c);
+            EXPECT_EQ(sums[i], out[i] + in[i] * c);
+        }
+    }
+}
+
+TEST(FieldKernelsTest, BinaryFieldTest) {
+    run_field_kernels_test<libff::gf64>();
+    run_field_kernels_test<libff::gf128>();
+    run_field_kernels_test<libff::gf192>();
+    run_field_kernels_test<libff::gf256>();
+}
+
+TEST(FieldKernelsTest, PrimeFieldTest) {
+    libff::edwards_pp::init_public_params();
+    run_field_kernels_test<libff::edwards_Fr>();
+}
+
+/* Checks every instruction set this CPU supports, not just the one picked at runtime */
+template<typename FieldT>
+void run_binary_field_kernels_isa_test()
+{
+    const size_t num_words = sizeof(FieldT) / sizeof(uint64_t);
+    for (int isa = pclmul_binary_field_kernels; isa <= avx512_vpclmul_binary_field_kernels; ++isa)
+    {
+        const binary_field_kernels *kernels =
+            binary_field_kernels_for(num_words, (binary_field_kernel_isa) isa);
+        if (kernels == nullptr)
+        {
+            continue;
+        }
+        EXPECT_LE(kernels->isa, isa);
+
+        for (size_t n = 0; n <= 37; ++n)
+        {
+            const std::vector<FieldT> in = random_FieldT_vector<FieldT>(n);
+            const std::vector<FieldT> out = random_FieldT_vector<FieldT>(n);
+            const FieldT c = FieldT::random_element();
+
+            std::vector<FieldT> products(in);
+            kernels->mul_by_constant(reinterpret_cast<uint64_t*>(products.data()), n,
+                                     reinterpret_cast<const uint64_t*>(&c));
+            std::vector<FieldT> sums(out);
+            kernels->fma_by_constant(reinterpret_cast<uint64_t*>(sums.data()),
+                                     reinterpret_cast<const uint64_t*>(in.data()), n,
+                                     reinterpret_cast<const uint64_t*>(&c));
+            for (size_t i = 0; i < n; ++i)
+            {
+                EXPECT_EQ(products[i], in[i] * c);
+                EXPECT_EQ(sums[i], out[i] + in[i] * c);
+            }
+        }
+    }
+}
+
+TEST(FieldKernelsTest, InstructionSetTest) {
+    run_binary_field_kernels_isa_test<libff::gf128>();
+    run_binary_field_kernels_isa_test<libff::gf192>();
+    run_binary_field_kernels_isa_test<libff::gf256>();
+}
+
+}
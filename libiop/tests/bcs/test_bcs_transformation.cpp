@@ -14,6 +14,7 @@
 #include "libiop/bcs/bcs_verifier.hpp"
 #include "libiop/bcs/hashing/blake2b.hpp"
 #include "libiop/bcs/hashing/dummy_algebraic_hash.hpp"
+#include "libiop/protocols/ldt/ldt_reducer_aux.hpp"
 
 namespace libiop {
 
@@ -86,13 +87,15 @@ void run_test(const field_subset<FieldT> codeword_domain,
               const std::vector<std::vector<size_t>> query_positions,
               const bool make_zk,
               const bool preprocessing,
-              const size_t expected_size = 0) {
+              const size_t expected_size = 0,
+              const bool spill_oracles = false) {
     bool use_algebraic_hashchain;
     for (size_t i = 0; i < 2; i++)
     {
         use_algebraic_hashchain = (i == 1) ? true : false;
         bcs_transformation_parameters<FieldT, MT_root_hash> bcs_parameters =
             get_bcs_parameters<FieldT, MT_root_hash>(use_algebraic_hashchain);
+        bcs_parameters.spill_oracles_ = spill_oracles;
         /* Decide on query positions according to round_params */
         /* Run indexer */
         bcs_indexer<FieldT, MT_root_hash> indexer_IOP(bcs_parameters);
@@ -490,4 +493,79 @@ TEST(DifferentRoundParameters, BCSTest) {
                      zk, preprocessing, expected_proof_size);
 }
 
+TEST(SpilledOraclesTest, BCSTest) {
+    const size_t num_rounds = 2;
+    typedef libff::gf64 FieldT;
+    size_t dim = 7;
+    field_subset<FieldT> codeword_domain(1ull << dim);
+    size_t num_oracles_per_round = 3;
+    round_parameters<FieldT> round1_params = round_parameters<FieldT>(codeword_domain.get_subset_of_order(2));
+    round_parameters<FieldT> round2_params = round_parameters<FieldT>(codeword_domain.get_subset_of_order(4));
+    std::vector<round_parameters<FieldT>> all_round_params({round1_params, round2_params});
+    std::vector<std::vector<size_t>> all_query_positions({{0, 1, 2, 3}, {32, 33, 34, 35}});
+
+    /* The transcript must not depend on where the prover keeps its oracles */
+    const bool spill_oracles = true;
+    const bool preprocessing = false;
+    for (size_t i = 0; i < 2; i++)
+    {
+        const bool zk = (i == 1);
+        run_test<FieldT, binary_hash_digest>(codeword_domain,
+                         num_oracles_per_round, num_rounds,
+                         all_round_params, all_query_positions,
+                         zk, preprocessing, 0, spill_oracles);
+    }
+}
+
+TEST(SpilledOraclesTest, CombinedOracleTest) {
+    typedef libff::gf64 FieldT;
+    typedef binary_hash_digest hash_type;
+    const size_t dim = 12;
+    const size_t num_oracles = 8;
+    field_subset<FieldT> codeword_domain(1ull << dim);
+    const round_parameters<FieldT> round_params(codeword_domain.get_subset_of_order(4));
+    const size_t codeword_bytes = codeword_domain.num_elements() * sizeof(FieldT);
+
+    /* A combined oracle over every committed oracle reads the spilled ones a block at a time,
+       so that they are never all back in memory at once */
+    std::vector<std::shared_ptr<const std::vector<FieldT>>> evaluations;
+    for (size_t i = 0; i < 2; i++)
+    {
+        const bool spill_oracles = (i == 1);
+        bcs_transformation_parameters<FieldT, hash_type> bcs_parameters =
+            get_bcs_parameters<FieldT, hash_type>(false);
+        bcs_parameters.spill_oracles_ = spill_oracles;
+
+        bcs_prover<FieldT, hash_type> prover_IOP(bcs_parameters);
+        const domain_handle codeword_domain_handle = prover_IOP.register_domain(codeword_domain);
+        dummy_protocol<FieldT> proto(prover_IOP, num_oracles, 1, { round_params },
+                                     codeword_domain_handle, false, false);
+        const std::vector<oracle_handle_ptr> handles = proto.get_oracle_handles_for_round(0);
+        const size_t degree = codeword_domain.num_elements() - 1;
+        const std::vector<size_t> degrees(num_oracles, degree);
+        std::shared_ptr<combined_LDT_virtual_oracle<FieldT>> combined_oracle =
+            std::make_shared<combined_LDT_virtual_oracle<FieldT>>(codeword_domain, degrees);
+        const oracle_handle_ptr combined_handle = std::make_shared<virtual_oracle_handle>(
+            prover_IOP.register_virtual_oracle(codeword_domain_handle, degree, handles, combined_oracle));
+        prover_IOP.seal_interaction_registrations();
+        prover_IOP.seal_query_registrations();
+        proto.calculate_and_submit_response();
+
+        std::vector<FieldT> coefficients(2 * num_oracles);
+        for (size_t j = 0; j < coefficients.size(); j++)
+        {
+            coefficients[j] = FieldT(j + 1);
+        }
+        combined_oracle->set_random_coefficients(coefficients);
+        evaluations.emplace_back(prover_IOP.get_oracle_evaluations(combined_handle));
+
+        EXPECT_EQ(prover_IOP.spill_file() != nullptr, spill_oracles);
+        if (spill_oracles)
+        {
+            EXPECT_LT(prover_IOP.spill_file()->peak_reloaded_bytes(), codeword_bytes);
+        }
+    }
+    EXPECT_EQ(*evaluations[0], *evaluations[1]);
+}
+
 }
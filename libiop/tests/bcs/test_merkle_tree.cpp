@@ -1,11 +1,17 @@
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <gtest/gtest.h>
+#include <numeric>
+#include <set>
 #include <vector>
 #include <type_traits>
 
 #include <libff/algebra/fields/binary/gf64.hpp>
+#include "sodium/crypto_generichash_blake2b.h"
 #include "libiop/algebra/utils.hpp"
 #include "libiop/bcs/hashing/blake2b.hpp"
+#include "libiop/bcs/hashing/blake3.hpp"
 #include "libiop/bcs/hashing/dummy_algebraic_hash.hpp"
 #include "libiop/bcs/hashing/hashing.hpp"
 #include "libiop/bcs/merkle_tree.hpp"
@@ -175,6 +181,96 @@ TEST(MerkleTreeZKTest, MultiTest) {
     run_multi_test(make_zk);
 }
 
+TEST(BinaryHashDigestTest, SimpleTest)
+{
+    const std::vector<uint8_t> bytes = random_vector<uint8_t>(32);
+    const binary_hash_digest a(bytes.begin(), bytes.end());
+    binary_hash_digest b = a;
+    EXPECT_EQ(a.size(), 32);
+    EXPECT_EQ(a, b);
+    EXPECT_TRUE(std::equal(a.begin(), a.end(), bytes.begin()));
+
+    b[31] ^= 1;
+    EXPECT_NE(a, b);
+    EXPECT_TRUE((a < b) != (b < a));
+
+    /* Digests of different lengths never compare equal, even with equal prefixes */
+    const binary_hash_digest prefix(bytes.begin(), bytes.begin() + 16);
+    EXPECT_NE(a, prefix);
+    EXPECT_TRUE(prefix < a);
+
+    EXPECT_EQ(binary_hash_digest(binary_hash_digest::max_size, 'X').size(), binary_hash_digest::max_size);
+    EXPECT_THROW(binary_hash_digest(binary_hash_digest::max_size + 1, 'X'), std::invalid_argument);
+
+    /* Shrinking then growing again does not bring back the old bytes */
+    binary_hash_digest c = a;
+    c.resize(8);
+    c.resize(32);
+    EXPECT_TRUE(std::equal(c.begin(), c.begin() + 8, bytes.begin()));
+    EXPECT_TRUE(std::all_of(c.begin() + 8, c.end(), [](const unsigned char x) { return x == 0; }));
+}
+
+/* Checks every batch instruction set this CPU supports against the scalar hash */
+TEST(MerkleTreeTwoToOneHashTest, BatchTest)
+{
+    for (const size_t digest_len_bytes : {16, 32, 64})
+    {
+        for (size_t num_parents = 0; num_parents <= 19; ++num_parents)
+        {
+            std::vector<binary_hash_digest> children;
+            for (size_t i = 0; i < 2 * num_parents; ++i)
+            {
+                const std::vector<uint8_t> bytes = random_vector<uint8_t>(digest_len_bytes);
+                children.emplace_back(bytes.begin(), bytes.end());
+            }
+
+            for (int isa = scalar_blake2b_batch; isa <= avx512_blake2b_batch; ++isa)
+            {
+                std::vector<binary_hash_digest> parents(num_parents);
+                blake2b_two_to_one_hash_batch(children.data(), parents.data(), num_parents,
+                                              digest_len_bytes, (blake2b_batch_isa) isa);
+                for (size_t i = 0; i < num_parents; ++i)
+                {
+                    EXPECT_EQ(parents[i],
+                              blake2b_two_to_one_hash(children[2*i], children[2*i + 1], digest_len_bytes));
+                }
+            }
+        }
+    }
+}
+
+/* Large enough for leaves and layers to be hashed in parallel chunks */
+TEST(MerkleTreeTest, LargeTreeRootTest)
+{
+    typedef libff::gf64 FieldT;
+    const size_t num_leaves = 1ull << 10;
+    const size_t security_parameter = 128;
+    const size_t digest_len_bytes = 256/8;
+
+    merkle_tree<FieldT, binary_hash_digest> tree = new_MT<FieldT, binary_hash_digest>(
+        num_leaves, digest_len_bytes, false, security_parameter);
+    const std::vector<FieldT> vec1 = random_vector<FieldT>(num_leaves);
+    const std::vector<FieldT> vec2 = random_vector<FieldT>(num_leaves);
+    tree.construct({ vec1, vec2 });
+
+    blake2b_leafhash<FieldT> leaf_hasher(security_parameter);
+    std::vector<binary_hash_digest> layer;
+    for (size_t i = 0; i < num_leaves; ++i)
+    {
+        layer.emplace_back(leaf_hasher.hash({ vec1[i], vec2[i] }));
+    }
+    while (layer.size() > 1)
+    {
+        std::vector<binary_hash_digest> next_layer;
+        for (size_t i = 0; i < layer.size(); i += 2)
+        {
+            next_layer.emplace_back(blake2b_two_to_one_hash(layer[i], layer[i + 1], digest_len_bytes));
+        }
+        layer = next_layer;
+    }
+    EXPECT_EQ(tree.get_root(), layer[0]);
+}
+
 TEST(MerkleTreeTwoToOneHashTest, SimpleTest)
 {
     typedef libff::gf64 FieldT;
@@ -196,4 +292,271 @@ TEST(MerkleTreeTwoToOneHashTest, SimpleTest)
     ASSERT_EQ(expected_num_hashes, actual_num_hashes);
 }
 
+
+static std::string to_hex(const unsigned char *bytes, const size_t num_bytes)
+{
+    static const char digits[] = "0123456789abcdef";
+    std::string hex;
+    for (size_t i = 0; i < num_bytes; ++i)
+    {
+        hex += digits[bytes[i] >> 4];
+        hex += digits[bytes[i] & 0xF];
+    }
+    return hex;
+}
+
+/* Test vectors in the format of BLAKE3's own: input byte i is i % 251. Lengths around the
+   block and chunk sizes, and over several levels of the chunk tree. */
+TEST(Blake3Test, KnownAnswerTest)
+{
+    const std::vector<std::pair<size_t, std::string>> vectors = {
+        { 0, "af1349b9f5f9a1a6a0404dea36dcc9499bcb25c9adc112b7cc9a93cae41f3262" },
+        { 1, "2d3adedff11b61f14c886e35afa036736dcd87a74d27b5c1510225d0f592e213" },
+        { 63, "e9bc37a594daad83be9470df7f7b3798297c3d834ce80ba85d6e207627b7db7b" },
+        { 64, "4eed7141ea4a5cd4b788606bd23f46e212af9cacebacdc7d1f4c6dc7f2511b98" },
+        { 65, "de1e5fa0be70df6d2be8fffd0e99ceaa8eb6e8c93a63f2d8d1c30ecb6b263dee" },
+        { 1023, "10108970eeda3eb932baac1428c7a2163b0e924c9a9e25b35bba72b28f70bd11" },
+        { 1024, "42214739f095a406f3fc83deb889744ac00df831c10daa55189b5d121c855af7" },
+        { 1025, "d00278ae47eb27b34faecf67b4fe263f82d5412916c1ffd97c8cb7fb814b8444" },
+        { 2048, "e776b6028c7cd22a4d0ba182a8bf62205d2ef576467e838ed6f2529b85fba24a" },
+        { 2049, "5f4d72f40d7a5f82b15ca2b2e44b1de3c2ef86c426c95c1af0b6879522563030" },
+        { 3072, "b98cb0ff3623be03326b373de6b9095218513e64f1ee2edd2525c7ad1e5cffd2" },
+        { 3073, "7124b49501012f81cc7f11ca069ec9226cecb8a2c850cfe644e327d22d3e1cd3" },
+        { 5121, "628bd2cb2004694adaab7bbd778a25df25c47b9d4155a55f8fbd79f2fe154cff" },
+        { 8193, "bab6c09cb8ce8cf459261398d2e7aef35700bf488116ceb94a36d0f5f1b7bc3b" },
+        { 16384, "f875d6646de28985646f34ee13be9a576fd515f76b5b0a26bb324735041ddde4" },
+        { 31744, "62b6960e1a44bcc1eb1a611a8d6235b6b4b78f32e7abc4fb4c6cdcce94895c47" },
+        { 102400, "bc3e3d41a1146b069abffad3c0d44860cf664390afce4d9661f7902e7943e085" },
+    };
+
+    std::vector<unsigned char> input(102400);
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+        input[i] = (unsigned char) (i % 251);
+    }
+
+    unsigned char out[32];
+    for (const std::pair<size_t, std::string> &vector : vectors)
+    {
+        blake3_hash(input.data(), vector.first, out, sizeof(out));
+        EXPECT_EQ(to_hex(out, sizeof(out)), vector.second) << "input length " << vector.first;
+    }
+
+    const std::string key = "whats the Elvish word for friend";
+    blake3_hash(input.data(), 3073, out, sizeof(out), (const unsigned char*) key.data());
+    EXPECT_EQ(to_hex(out, sizeof(out)), "68dede9bef00ba89e43f31a6825f4cf433389fedae75c04ee9f0cf16a427c95a");
+
+    /* The extendable output, read whole and from an offset */
+    const std::string expected_xof =
+        "d00278ae47eb27b34faecf67b4fe263f82d5412916c1ffd97c8cb7fb814b8444f4c4a22b4b399155358a994e52bf255d"
+        "e60035742ec71bd08ac275a1b51cc6bfe332b0ef84b409108cda080e6269ed4b3e2c3f7d722aa4cdc98d16deb554e562"
+        "7be8f955c98e1d5f9565a9194cad0c4285f93700062d9595adb992ae68ff12800ab67a";
+    unsigned char xof[131];
+    blake3_hash(input.data(), 1025, xof, sizeof(xof));
+    EXPECT_EQ(to_hex(xof, sizeof(xof)), expected_xof);
+    blake3_hash(input.data(), 1025, xof, 100, nullptr, 31);
+    EXPECT_EQ(to_hex(xof, 100), expected_xof.substr(2*31, 2*100));
+}
+
+/* Checks every batch instruction set this CPU supports against the scalar hash */
+TEST(MerkleTreeTwoToOneHashTest, Blake3BatchTest)
+{
+    for (const size_t digest_len_bytes : {16, 20, 32, 64})
+    {
+        for (size_t num_parents = 0; num_parents <= 35; ++num_parents)
+        {
+            std::vector<binary_hash_digest> children;
+            for (size_t i = 0; i < 2 * num_parents; ++i)
+            {
+                const std::vector<uint8_t> bytes = random_vector<uint8_t>(digest_len_bytes);
+                children.emplace_back(bytes.begin(), bytes.end());
+            }
+
+            for (int isa = scalar_blake3_batch; isa <= avx512_blake3_batch; ++isa)
+            {
+                std::vector<binary_hash_digest> parents(num_parents);
+                blake3_two_to_one_hash_batch(children.data(), parents.data(), num_parents,
+                                             digest_len_bytes, (blake3_batch_isa) isa);
+                for (size_t i = 0; i < num_parents; ++i)
+                {
+                    EXPECT_EQ(parents[i],
+                              blake3_two_to_one_hash(children[2*i], children[2*i + 1], digest_len_bytes));
+                }
+            }
+        }
+    }
+}
+
+TEST(MerkleTreeTest, Blake3RootTest)
+{
+    typedef libff::gf64 FieldT;
+    const size_t num_leaves = 1ull << 8;
+    const size_t security_parameter = 128;
+    const size_t digest_len_bytes = 256/8;
+
+    merkle_tree<FieldT, binary_hash_digest> tree(
+        num_leaves,
+        std::make_shared<blake3_leafhash<FieldT>>(security_parameter),
+        blake3_two_to_one_hash,
+        digest_len_bytes,
+        false,
+        security_parameter);
+    const std::vector<FieldT> vec1 = random_vector<FieldT>(num_leaves);
+    const std::vector<FieldT> vec2 = random_vector<FieldT>(num_leaves);
+    tree.construct({ vec1, vec2 });
+
+    blake3_leafhash<FieldT> leaf_hasher(security_parameter);
+    std::vector<binary_hash_digest> layer;
+    for (size_t i = 0; i < num_leaves; ++i)
+    {
+        layer.emplace_back(leaf_hasher.hash({ vec1[i], vec2[i] }));
+    }
+    while (layer.size() > 1)
+    {
+        std::vector<binary_hash_digest> next_layer;
+        for (size_t i = 0; i < layer.size(); i += 2)
+        {
+            next_layer.emplace_back(blake3_two_to_one_hash(layer[i], layer[i + 1], digest_len_bytes));
+        }
+        layer = next_layer;
+    }
+    EXPECT_EQ(tree.get_root(), layer[0]);
+
+    /* Zero knowledge leaves are hashed in batches, and checked one at a time by the verifier */
+    merkle_tree<FieldT, binary_hash_digest> zk_tree(
+        num_leaves,
+        std::make_shared<blake3_leafhash<FieldT>>(security_parameter),
+        blake3_two_to_one_hash,
+        digest_len_bytes,
+        true,
+        security_parameter);
+    zk_tree.construct({ vec1, vec2 });
+
+    const std::vector<size_t> positions = { 3, 100, 201 };
+    std::vector<std::vector<FieldT>> leaf_contents;
+    for (const size_t i : positions)
+    {
+        leaf_contents.emplace_back(std::vector<FieldT>({ vec1[i], vec2[i] }));
+    }
+    for (merkle_tree<FieldT, binary_hash_digest> *t : { &tree, &zk_tree })
+    {
+        const merkle_tree_set_membership_proof<binary_hash_digest> proof =
+            t->get_set_membership_proof(positions);
+        EXPECT_TRUE(t->validate_set_membership_proof(t->get_root(), positions, leaf_contents, proof));
+    }
+}
+
+TEST(MerkleTreeZKTest, Blake2bLeafHashVersionTest)
+{
+    typedef libff::gf64 FieldT;
+    const size_t num_leaves = 1ull << 6;
+    const size_t security_parameter = 128;
+    const size_t digest_len_bytes = 256/8;
+
+    const std::vector<FieldT> leaf = random_vector<FieldT>(5);
+    zk_salt_type salt(digest_len_bytes);
+    for (size_t i = 0; i < digest_len_bytes; ++i)
+    {
+        salt.data()[i] = (unsigned char) (3 * i + 1);
+    }
+
+    /* v1 is what older proofs were made with, so it must not change */
+    blake2b_leafhash<FieldT> v1_hasher(security_parameter);
+    EXPECT_EQ(v1_hasher.zk_hash(leaf, salt),
+              blake2b_two_to_one_hash(v1_hasher.hash(leaf), salt, digest_len_bytes));
+
+    /* v2 is one BLAKE2b call over the leaf followed by the salt */
+    blake2b_leafhash<FieldT> v2_hasher(security_parameter, blake2b_zk_leaf_hash_v2);
+    std::vector<unsigned char> leaf_plus_salt(sizeof(FieldT) * leaf.size() + salt.size());
+    std::memcpy(leaf_plus_salt.data(), &leaf[0], sizeof(FieldT) * leaf.size());
+    std::memcpy(leaf_plus_salt.data() + sizeof(FieldT) * leaf.size(), salt.data(), salt.size());
+    binary_hash_digest expected(digest_len_bytes);
+    crypto_generichash_blake2b(expected.data(), digest_len_bytes,
+                               leaf_plus_salt.data(), leaf_plus_salt.size(), NULL, 0);
+    EXPECT_EQ(v2_hasher.zk_hash(leaf, salt), expected);
+    EXPECT_NE(v2_hasher.zk_hash(leaf, salt), v1_hasher.zk_hash(leaf, salt));
+    EXPECT_EQ(v2_hasher.hash(leaf), v1_hasher.hash(leaf));
+
+    /* A proof only verifies with the leaf hash version it was made with */
+    const std::vector<FieldT> vec1 = random_vector<FieldT>(num_leaves);
+    const std::vector<FieldT> vec2 = random_vector<FieldT>(num_leaves);
+    merkle_tree<FieldT, binary_hash_digest> v1_tree(
+        num_leaves,
+        std::make_shared<blake2b_leafhash<FieldT>>(security_parameter),
+        blake2b_two_to_one_hash,
+        digest_len_bytes,
+        true,
+        security_parameter);
+    merkle_tree<FieldT, binary_hash_digest> v2_tree(
+        num_leaves,
+        std::make_shared<blake2b_leafhash<FieldT>>(security_parameter, blake2b_zk_leaf_hash_v2),
+        blake2b_two_to_one_hash,
+        digest_len_bytes,
+        true,
+        security_parameter);
+    v1_tree.construct({ vec1, vec2 });
+    v2_tree.construct({ vec1, vec2 });
+
+    const std::vector<size_t> positions = { 0, 17, 63 };
+    std::vector<std::vector<FieldT>> leaf_contents;
+    for (const size_t i : positions)
+    {
+        leaf_contents.emplace_back(std::vector<FieldT>({ vec1[i], vec2[i] }));
+    }
+    const merkle_tree_set_membership_proof<binary_hash_digest> v1_proof =
+        v1_tree.get_set_membership_proof(positions);
+    const merkle_tree_set_membership_proof<binary_hash_digest> v2_proof =
+        v2_tree.get_set_membership_proof(positions);
+    EXPECT_TRUE(v1_tree.validate_set_membership_proof(v1_tree.get_root(), positions, leaf_contents, v1_proof));
+    EXPECT_TRUE(v2_tree.validate_set_membership_proof(v2_tree.get_root(), positions, leaf_contents, v2_proof));
+    EXPECT_FALSE(v1_tree.validate_set_membership_proof(v2_tree.get_root(), positions, leaf_contents, v2_proof));
+}
+
+TEST(MerkleTreeZKTest, SaltTest)
+{
+    typedef libff::gf64 FieldT;
+    const size_t num_leaves = 1ull << 10;
+    const size_t security_parameter = 128;
+    const size_t digest_len_bytes = 256/8;
+    const size_t num_zk_bytes = (2 * security_parameter + 7) / 8;
+
+    const std::vector<FieldT> vec = random_vector<FieldT>(num_leaves);
+    std::vector<merkle_tree<FieldT, binary_hash_digest>> trees;
+    for (size_t t = 0; t < 2; ++t)
+    {
+        trees.emplace_back(num_leaves,
+                           std::make_shared<blake2b_leafhash<FieldT>>(security_parameter),
+                           blake2b_two_to_one_hash,
+                           digest_len_bytes,
+                           true,
+                           security_parameter);
+        trees[t].construct({ vec });
+    }
+
+    /* Salts are regenerated for every proof, and must match the ones the leaves were hashed with */
+    std::vector<size_t> positions(num_leaves);
+    std::iota(positions.begin(), positions.end(), 0);
+    const merkle_tree_set_membership_proof<binary_hash_digest> proof =
+        trees[0].get_set_membership_proof(positions);
+    ASSERT_EQ(proof.randomness_hashes.size(), num_leaves);
+    EXPECT_EQ(trees[0].get_set_membership_proof({ 5 }).randomness_hashes[0], proof.randomness_hashes[5]);
+    std::vector<std::vector<FieldT>> leaf_contents;
+    for (const FieldT &x : vec)
+    {
+        leaf_contents.emplace_back(std::vector<FieldT>({ x }));
+    }
+    EXPECT_TRUE(trees[0].validate_set_membership_proof(trees[0].get_root(), positions, leaf_contents, proof));
+
+    /* Every leaf, and every tree, gets its own salt */
+    std::set<binary_hash_digest> distinct_salts;
+    for (const zk_salt_type &salt : proof.randomness_hashes)
+    {
+        EXPECT_EQ(salt.size(), num_zk_bytes);
+        distinct_salts.insert(salt);
+    }
+    EXPECT_EQ(distinct_salts.size(), num_leaves);
+    EXPECT_NE(trees[1].get_set_membership_proof({ 0 }).randomness_hashes[0], proof.randomness_hashes[0]);
+    EXPECT_NE(trees[1].get_root(), trees[0].get_root());
+}
+
 }
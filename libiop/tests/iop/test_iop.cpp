@@ -34,8 +34,274 @@ TEST(IOPTest, OracleRegistration) {
     }
 }
 
+TEST(IOPTest, SharedOracleSubmission) {
+    typedef libff::gf64 FieldT;
+
+    const std::size_t L_dim = 10;
+    iop_protocol<FieldT> IOP;
+    const affine_subspace<FieldT> L = linear_subspace<FieldT>::standard_basis(L_dim);
+    const domain_handle L_handle = IOP.register_subspace(L);
+    const oracle_handle_ptr R_handle = std::make_shared<oracle_handle>(
+        IOP.register_oracle("", L_handle, 20, false));
+    IOP.seal_interaction_registrations();
+    IOP.seal_query_registrations();
+
+    /* A buffer of the wrong size is rejected */
+    EXPECT_THROW(IOP.submit_oracle(R_handle, std::make_shared<std::vector<FieldT>>(L.num_elements() - 1)),
+                 std::invalid_argument);
+
+    const polynomial<FieldT> R = polynomial<FieldT>::random_polynomial(21);
+    const std::shared_ptr<std::vector<FieldT>> R_evaluations =
+        std::make_shared<std::vector<FieldT>>(additive_FFT_wrapper<FieldT>(R.coefficients(), L));
+    IOP.submit_oracle(R_handle, R_evaluations);
+    IOP.signal_prover_round_done();
+
+    /* The IOP holds on to the submitted buffer instead of a copy of it */
+    EXPECT_EQ(IOP.get_oracle_evaluations(R_handle).get(), R_evaluations.get());
+}
+
+TEST(IOPTest, SpilledOracleTest) {
+    typedef libff::gf64 FieldT;
+
+    const std::shared_ptr<oracle_spill_file> spill_file = std::make_shared<oracle_spill_file>();
+    std::vector<std::vector<FieldT>> contents;
+    std::vector<oracle<FieldT>> oracles;
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        contents.emplace_back(random_FieldT_vector<FieldT>(1000 + i));
+        oracles.emplace_back(oracle<FieldT>(contents[i]));
+        oracles[i].spill_contents(spill_file);
+        EXPECT_TRUE(oracles[i].is_spilled());
+    }
+    EXPECT_EQ(spill_file->num_bytes(), (3 * 1000 + 3) * sizeof(FieldT));
+
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        EXPECT_EQ(*oracles[i].evaluated_contents(), contents[i]);
+        for (std::size_t j = 0; j < contents[i].size(); j += 37)
+        {
+            EXPECT_EQ(oracles[i].evaluation_at_position(j), contents[i][j]);
+        }
+    }
+
+    oracles[0].erase_contents();
+    EXPECT_THROW(oracles[0].evaluated_contents(), std::invalid_argument);
+}
+
+/* Sums its constituent oracles */
+template<typename FieldT>
+class sum_virtual_oracle : public virtual_oracle<FieldT> {
+public:
+    virtual std::shared_ptr<std::vector<FieldT>> evaluated_contents(
+        const std::vector<std::shared_ptr<const std::vector<FieldT>>> &constituent_oracle_evaluations) const
+    {
+        std::shared_ptr<std::vector<FieldT>> result =
+            std::make_shared<std::vector<FieldT>>(*constituent_oracle_evaluations[0]);
+        for (std::size_t i = 1; i < constituent_oracle_evaluations.size(); ++i)
+        {
+            for (std::size_t j = 0; j < result->size(); ++j)
+            {
+                result->operator[](j) += constituent_oracle_evaluations[i]->operator[](j);
+            }
+        }
+        return result;
+    }
+
+    virtual FieldT evaluation_at_point(
+        const std::size_t evaluation_position,
+        const FieldT evaluation_point,
+        const std::vector<FieldT> &constituent_oracle_evaluations) const
+    {
+        libff::UNUSED(evaluation_position, evaluation_point);
+        FieldT result = FieldT::zero();
+        for (auto &evaluation : constituent_oracle_evaluations)
+        {
+            result += evaluation;
+        }
+        return result;
+    }
+};
+
+TEST(IOPTest, NestedVirtualOracleTest) {
+    typedef libff::gf64 FieldT;
+
+    const std::size_t L_dim = 12;
+    const std::size_t num_oracles = 6;
+    iop_protocol<FieldT> IOP;
+    const affine_subspace<FieldT> L = linear_subspace<FieldT>::standard_basis(L_dim);
+    const domain_handle L_handle = IOP.register_subspace(L);
+
+    std::vector<oracle_handle_ptr> oracle_handles;
+    for (std::size_t i = 0; i < num_oracles; ++i)
+    {
+        oracle_handles.emplace_back(std::make_shared<oracle_handle>(
+            IOP.register_oracle("", L_handle, L.num_elements() - 1, false)));
+    }
+    /* Three virtual oracles over pairs of oracles, summed by a fourth one */
+    std::vector<oracle_handle_ptr> pair_handles;
+    for (std::size_t i = 0; i < num_oracles; i += 2)
+    {
+        const bool cache = (i == 0);
+        pair_handles.emplace_back(std::make_shared<virtual_oracle_handle>(
+            IOP.register_virtual_oracle(L_handle, L.num_elements() - 1,
+                                        { oracle_handles[i], oracle_handles[i+1] },
+                                        std::make_shared<sum_virtual_oracle<FieldT>>(), cache)));
+    }
+    const oracle_handle_ptr total_handle = std::make_shared<virtual_oracle_handle>(
+        IOP.register_virtual_oracle(L_handle, L.num_elements() - 1, pair_handles,
+                                    std::make_shared<sum_virtual_oracle<FieldT>>()));
+    IOP.seal_interaction_registrations();
+    IOP.seal_query_registrations();
+
+    std::vector<FieldT> expected(L.num_elements(), FieldT::zero());
+    for (std::size_t i = 0; i < num_oracles; ++i)
+    {
+        const std::vector<FieldT> evaluations = random_FieldT_vector<FieldT>(L.num_elements());
+        for (std::size_t j = 0; j < expected.size(); ++j)
+        {
+            expected[j] += evaluations[j];
+        }
+        IOP.submit_oracle(oracle_handles[i], oracle<FieldT>(evaluations));
+    }
+    IOP.signal_prover_round_done();
+
+    /* Twice, so that the cached constituent is read back the second time */
+    EXPECT_EQ(*IOP.get_oracle_evaluations(total_handle), expected);
+    EXPECT_EQ(*IOP.get_oracle_evaluations(total_handle), expected);
+}
+
+/* Multiplies its constituent oracles, and adds the position, so that blocks
+   evaluated at the wrong offset are caught */
+template<typename FieldT>
+class product_virtual_oracle : public pointwise_virtual_oracle<FieldT> {
+public:
+    virtual void evaluate_block(
+        const std::size_t begin,
+        const std::size_t end,
+        const std::vector<const FieldT*> &constituent_blocks,
+        FieldT *out) const
+    {
+        for (std::size_t j = 0; j < end - begin; ++j)
+        {
+            FieldT product = FieldT(begin + j);
+            for (auto &block : constituent_blocks)
+            {
+                product *= block[j];
+            }
+            out[j] = product + FieldT(begin + j);
+        }
+    }
+
+    virtual FieldT evaluation_at_point(
+        const std::size_t evaluation_position,
+        const FieldT evaluation_point,
+        const std::vector<FieldT> &constituent_oracle_evaluations) const
+    {
+        libff::UNUSED(evaluation_point);
+        FieldT product = FieldT(evaluation_position);
+        for (auto &evaluation : constituent_oracle_evaluations)
+        {
+            product *= evaluation;
+        }
+        return product + FieldT(evaluation_position);
+    }
+};
+
+TEST(IOPTest, FusedVirtualOracleTest) {
+    typedef libff::gf64 FieldT;
+
+    /* Large enough to span several evaluation blocks */
+    const std::size_t L_dim = 14;
+    const std::size_t num_oracles = 5;
+    iop_protocol<FieldT> IOP;
+    const affine_subspace<FieldT> L = linear_subspace<FieldT>::standard_basis(L_dim);
+    const domain_handle L_handle = IOP.register_subspace(L);
+    const std::size_t degree = L.num_elements() - 1;
+
+    std::vector<oracle_handle_ptr> o;
+    for (std::size_t i = 0; i < num_oracles; ++i)
+    {
+        o.emplace_back(std::make_shared<oracle_handle>(IOP.register_oracle("", L_handle, degree, false)));
+    }
+    /* p1 and p2 are fused into the root, and p1 is used twice. The sum isn't pointwise,
+       and p3 is cached, so both of those are materialized. */
+    const oracle_handle_ptr p1 = std::make_shared<virtual_oracle_handle>(IOP.register_virtual_oracle(
+        L_handle, degree, { o[0], o[1] }, std::make_shared<product_virtual_oracle<FieldT>>()));
+    const oracle_handle_ptr p2 = std::make_shared<virtual_oracle_handle>(IOP.register_virtual_oracle(
+        L_handle, degree, { p1, o[2] }, std::make_shared<product_virtual_oracle<FieldT>>()));
+    const oracle_handle_ptr sum = std::make_shared<virtual_oracle_handle>(IOP.register_virtual_oracle(
+        L_handle, degree, { o[3], o[4] }, std::make_shared<sum_virtual_oracle<FieldT>>()));
+    const oracle_handle_ptr p3 = std::make_shared<virtual_oracle_handle>(IOP.register_virtual_oracle(
+        L_handle, degree, { o[0], o[2] }, std::make_shared<product_virtual_oracle<FieldT>>(), true));
+    const oracle_handle_ptr root = std::make_shared<virtual_oracle_handle>(IOP.register_virtual_oracle(
+        L_handle, degree, { p2, sum, p1, p3 }, std::make_shared<product_virtual_oracle<FieldT>>()));
+    IOP.seal_interaction_registrations();
+    IOP.seal_query_registrations();
+
+    std::vector<std::vector<FieldT>> evaluations;
+    for (std::size_t i = 0; i < num_oracles; ++i)
+    {
+        evaluations.emplace_back(random_FieldT_vector<FieldT>(L.num_elements()));
+        IOP.submit_oracle(o[i], oracle<FieldT>(evaluations[i]));
+    }
+    IOP.signal_prover_round_done();
+
+    std::vector<FieldT> expected(L.num_elements());
+    for (std::size_t j = 0; j < L.num_elements(); ++j)
+    {
+        const FieldT pos = FieldT(j);
+        const FieldT e1 = pos * evaluations[0][j] * evaluations[1][j] + pos;
+        const FieldT e2 = pos * e1 * evaluations[2][j] + pos;
+        const FieldT e3 = pos * evaluations[0][j] * evaluations[2][j] + pos;
+        const FieldT s = evaluations[3][j] + evaluations[4][j];
+        expected[j] = pos * e2 * s * e1 * e3 + pos;
+    }
+    EXPECT_EQ(*IOP.get_oracle_evaluations(root), expected);
+    /* Evaluating p1 on its own gives the same codeword as the one fused into the root */
+    const std::vector<FieldT> p1_evaluations = *IOP.get_oracle_evaluations(p1);
+    for (std::size_t j = 0; j < L.num_elements(); ++j)
+    {
+        ASSERT_EQ(p1_evaluations[j], FieldT(j) * evaluations[0][j] * evaluations[1][j] + FieldT(j));
+        ASSERT_EQ(IOP.get_oracle_evaluation_at_point(root, j), expected[j]);
+    }
+}
+
 /* TODO: add more tests for the basic IOP scaffolding */
 
+TEST(IOPTest, FlatTablesTest) {
+    dense_id_map<std::size_t> ids;
+    ids.reserve(4);
+    EXPECT_EQ(ids.find(2), nullptr);
+    EXPECT_EQ(ids.find(100), nullptr);
+    ids.insert(2, 20);
+    ids.insert(9, 90); /* grows past the reserved ids */
+    ids.insert(2, 21);
+    ASSERT_NE(ids.find(2), nullptr);
+    EXPECT_EQ(*ids.find(2), 21);
+    EXPECT_EQ(*ids.find(9), 90);
+    EXPECT_EQ(ids.find(3), nullptr);
+    EXPECT_EQ(ids.size(), 2u);
+
+    /* Keys that are multiples of a power of two, as query positions of a coset often are,
+       inserted past several rehashes */
+    flat_hash_map<std::size_t> positions;
+    EXPECT_EQ(positions.find(0), nullptr);
+    const std::size_t num_keys = 5000;
+    for (std::size_t i = 0; i < num_keys; ++i)
+    {
+        positions.insert(i << 12, i);
+    }
+    positions.insert(0, num_keys);
+    EXPECT_EQ(positions.size(), num_keys);
+    EXPECT_EQ(*positions.find(0), num_keys);
+    for (std::size_t i = 1; i < num_keys; ++i)
+    {
+        ASSERT_NE(positions.find(i << 12), nullptr);
+        EXPECT_EQ(*positions.find(i << 12), i);
+        EXPECT_EQ(positions.find((i << 12) + 1), nullptr);
+    }
+}
+
 TEST(IOPTest, SumcheckTest) {
     typedef libff::gf64 FieldT;
 
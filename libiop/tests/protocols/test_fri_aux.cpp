@@ -3,6 +3,7 @@
 #include <vector>
 
 #include <libff/algebra/fields/binary/gf64.hpp>
+#include <libff/algebra/fields/binary/gf128.hpp>
 #include <libff/algebra/curves/edwards/edwards_pp.hpp>
 #include <libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp>
 #include "libiop/algebra/utils.hpp"
@@ -32,7 +33,7 @@ void run_lagrange_test(const field_subset<FieldT> &domain) {
     const FieldT point = FieldT::random_element();
     const FieldT evaluation = poly.evaluation_at_point(point);
 
-    const std::shared_ptr<std::vector<FieldT>> shared_poly_evals = std::make_shared<std::vector<FieldT>>(poly_evals);
+    const std::shared_ptr<const std::vector<FieldT>> shared_poly_evals = std::make_shared<const std::vector<FieldT>>(poly_evals);
     const std::vector<FieldT> interpolations = *evaluate_next_f_i_over_entire_domain(
         shared_poly_evals, domain, poly_deg, point).get();
     ASSERT_EQ(interpolations.size(), num_cosets);
@@ -85,6 +86,132 @@ TEST(Test, LagrangeTest) {
     run_lagrange_test<libff::edwards_Fr>(multiplicative_domain_with_offset);
 }
 
+/* Interpolates the coset of f_i_domain with the given index at x_i, one coset at a time */
+template<typename FieldT>
+FieldT fold_coset(const std::vector<FieldT> &f_i_evals,
+                  const field_subset<FieldT> &f_i_domain,
+                  const size_t coset_size,
+                  const size_t coset_index,
+                  const FieldT x_i)
+{
+    const size_t num_cosets = f_i_domain.num_elements() / coset_size;
+    std::vector<FieldT> coset_evals;
+    if (f_i_domain.type() == affine_subspace_type) {
+        for (size_t k = 0; k < coset_size; k++) {
+            coset_evals.emplace_back(f_i_evals[coset_index*coset_size + k]);
+        }
+        const field_subset<FieldT> unshifted_coset(affine_subspace<FieldT>(
+            f_i_domain.get_subset_of_order(coset_size).basis(), FieldT::zero()));
+        return additive_evaluate_next_f_i_at_coset(
+            coset_evals, unshifted_coset, f_i_domain.element_by_index(coset_index*coset_size),
+            localizer_polynomial<FieldT>(unshifted_coset), x_i);
+    }
+    for (size_t k = 0; k < coset_size; k++) {
+        coset_evals.emplace_back(f_i_evals[coset_index + k*num_cosets]);
+    }
+    const field_subset<FieldT> unshifted_coset(coset_size);
+    return multiplicative_evaluate_next_f_i_at_coset(
+        coset_evals, unshifted_coset.generator(), f_i_domain.element_by_index(coset_index), x_i);
+}
+
+template<typename FieldT>
+void run_batched_fold_test(const field_subset<FieldT> &domain, const size_t coset_size) {
+    const size_t num_cosets = domain.num_elements() / coset_size;
+    /* Two codewords share a challenge, and the third is folded at a point of the domain,
+       which lies in a coset far past the first block */
+    const FieldT x = FieldT::random_element();
+    const FieldT x_in_domain = domain.element_by_index(domain.num_elements() - 3);
+    const std::vector<FieldT> challenges({ x, x_in_domain, x });
+    std::vector<std::shared_ptr<const std::vector<FieldT>>> codewords;
+    for (size_t c = 0; c < challenges.size(); c++) {
+        codewords.emplace_back(std::make_shared<std::vector<FieldT>>(
+            random_FieldT_vector<FieldT>(domain.num_elements())));
+    }
+
+    const std::vector<std::shared_ptr<std::vector<FieldT>>> folded =
+        evaluate_next_f_i_over_entire_domain(codewords, domain, coset_size, challenges);
+    ASSERT_EQ(folded.size(), codewords.size());
+    for (size_t c = 0; c < codewords.size(); c++) {
+        ASSERT_EQ(folded[c]->size(), num_cosets);
+        for (size_t j = 0; j < num_cosets; j++) {
+            ASSERT_TRUE(folded[c]->operator[](j) ==
+                fold_coset(*codewords[c], domain, coset_size, j, challenges[c]));
+        }
+        ASSERT_TRUE(*folded[c] == *evaluate_next_f_i_over_entire_domain(
+            codewords[c], domain, coset_size, challenges[c]));
+    }
+}
+
+TEST(Test, BatchedFoldTest) {
+    const std::size_t dim = 14;
+    const field_subset<libff::gf64> additive_domain(
+        affine_subspace<libff::gf64>::random_affine_subspace(dim));
+    libff::edwards_pp::init_public_params();
+    const field_subset<libff::edwards_Fr> multiplicative_domain(
+        1ull << dim, libff::edwards_Fr::multiplicative_generator);
+    for (const size_t coset_size : { 2, 8, 1 << 13 }) {
+        run_batched_fold_test<libff::gf64>(additive_domain, coset_size);
+        run_batched_fold_test<libff::edwards_Fr>(multiplicative_domain, coset_size);
+    }
+
+    /* Cosets of size 2 are folded with butterflies, whose twiddle factors need no rescaling
+       over a Cantor basis */
+    const field_subset<libff::gf128> cantor_domain(
+        affine_subspace<libff::gf128>::shifted_cantor_basis(dim, libff::gf128::random_element()));
+    run_batched_fold_test<libff::gf128>(cantor_domain, 2);
+}
+
+template<typename FieldT>
+void run_batched_interpolation_test(const field_subset<FieldT> &domain, const size_t coset_size) {
+    const size_t num_cosets = domain.num_elements() / coset_size;
+    const field_subset<FieldT> localizer_domain = domain.get_subset_of_order(coset_size);
+    const localizer_polynomial<FieldT> localizer_vp(localizer_domain);
+    const std::vector<FieldT> f_i_evals = random_FieldT_vector<FieldT>(domain.num_elements());
+
+    /* Enough query sets to be split across threads, one of which is interpolated at a point of its coset */
+    const size_t num_query_sets = 300;
+    std::vector<size_t> coset_indices;
+    std::vector<std::vector<FieldT>> cosets;
+    std::vector<FieldT> shifts;
+    std::vector<FieldT> x_i;
+    for (size_t q = 0; q < num_query_sets; q++) {
+        const size_t j = std::rand() % num_cosets;
+        coset_indices.emplace_back(j);
+        std::vector<FieldT> coset_evals;
+        for (size_t k = 0; k < coset_size; k++) {
+            const size_t position = domain.position_by_coset_indices(j, k, coset_size);
+            coset_evals.emplace_back(f_i_evals[position]);
+        }
+        cosets.emplace_back(coset_evals);
+        shifts.emplace_back(domain.element_by_index(domain.position_by_coset_indices(j, 0, coset_size)));
+        x_i.emplace_back((q == 7) ?
+            domain.element_by_index(domain.position_by_coset_indices(j, coset_size - 1, coset_size)) :
+            FieldT::random_element());
+    }
+
+    const std::vector<FieldT> interpolations =
+        evaluate_next_f_i_at_cosets(cosets, localizer_domain, shifts, localizer_vp, x_i);
+    ASSERT_EQ(interpolations.size(), num_query_sets);
+    for (size_t q = 0; q < num_query_sets; q++) {
+        ASSERT_TRUE(interpolations[q] ==
+            fold_coset(f_i_evals, domain, coset_size, coset_indices[q], x_i[q]));
+    }
+    ASSERT_TRUE(interpolations[7] == cosets[7][coset_size - 1]);
+}
+
+TEST(Test, BatchedInterpolationTest) {
+    const std::size_t dim = 12;
+    const field_subset<libff::gf64> additive_domain(
+        affine_subspace<libff::gf64>::random_affine_subspace(dim));
+    libff::edwards_pp::init_public_params();
+    const field_subset<libff::edwards_Fr> multiplicative_domain(
+        1ull << dim, libff::edwards_Fr::multiplicative_generator);
+    for (const size_t coset_size : { 2, 4, 16 }) {
+        run_batched_interpolation_test<libff::gf64>(additive_domain, coset_size);
+        run_batched_interpolation_test<libff::edwards_Fr>(multiplicative_domain, coset_size);
+    }
+}
+
 template<typename FieldT>
 void run_calculate_next_coset_query_positions_test(
     const field_subset<FieldT> codeword_domain,
@@ -135,7 +135,7 @@ bool run_test(naive_sparse_matrix<FieldT> &constraint_matrix,
                                                             num_interactions,
                                                             make_zk,
                                                             domain_type,
-                                                            constraint_matrix,
+                                                            csr_sparse_matrix<FieldT>(constraint_matrix),
                                                             target_vector);
     linconstraints.attach_input_vector_row_oracles(input_vector_handles);
     if (make_zk)
@@ -144,7 +144,7 @@ bool run_test(naive_sparse_matrix<FieldT> &constraint_matrix,
                                                             num_interactions,
                                                             make_zk,
                                                             domain_type,
-                                                            constraint_matrix);
+                                                            csr_sparse_matrix<FieldT>(constraint_matrix));
     linconstraints.attach_input_vector_row_oracles(input_vector_handles);
     linconstraints.attach_target_vector_row_oracles(target_vector_handles);
     if (make_zk)
@@ -360,7 +360,7 @@ for (std::size_t variable_domain_dim = 7; variable_domain_dim < 9; variable_doma
         params.Cz_vec = IFFT_over_field_subset(
             *IOP.get_oracle_evaluations(std::make_shared<oracle_handle>(proto.fCz_handle_)).get(),
             params.codeword_domain_);
-        std::shared_ptr<std::vector<FieldT>> fw_over_codeword_domain = IOP.get_oracle_evaluations(
+        std::shared_ptr<const std::vector<FieldT>> fw_over_codeword_domain = IOP.get_oracle_evaluations(
             std::make_shared<oracle_handle>(proto.fw_handle_));
         std::vector<FieldT> fz_over_codeword_domain = *proto.fz_oracle_->evaluated_contents(
             {fw_over_codeword_domain}).get();
@@ -455,7 +455,7 @@ for (std::size_t variable_domain_dim = 6; variable_domain_dim < 8; variable_doma
         params.Cz_vec = IFFT_over_field_subset(
             *IOP.get_oracle_evaluations(std::make_shared<oracle_handle>(proto.fCz_handle_)).get(),
             params.codeword_domain_);
-        std::shared_ptr<std::vector<FieldT>> fw_over_codeword_domain = IOP.get_oracle_evaluations(
+        std::shared_ptr<const std::vector<FieldT>> fw_over_codeword_domain = IOP.get_oracle_evaluations(
             std::make_shared<oracle_handle>(proto.fw_handle_));
         std::vector<FieldT> fz_over_codeword_domain = *proto.fz_oracle_->evaluated_contents(
             {fw_over_codeword_domain}).get();
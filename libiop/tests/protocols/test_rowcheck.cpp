@@ -31,7 +31,7 @@ void run_test(const field_subset<FieldT> constraint_domain,
         constraint_domain);
 
     // calculate rowcheck output
-    const std::vector<std::shared_ptr<std::vector<FieldT>>> codewords(
+    const std::vector<std::shared_ptr<const std::vector<FieldT>>> codewords(
         {std::make_shared<std::vector<FieldT>>(Az_over_codeword_domain),
          std::make_shared<std::vector<FieldT>>(Bz_over_codeword_domain),
          std::make_shared<std::vector<FieldT>>(Cz_over_codeword_domain)});
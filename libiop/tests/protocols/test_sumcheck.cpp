@@ -234,6 +234,31 @@ TEST(SumcheckMultiplicativeTest, SimpleTest) {
     run_random_sumcheck_test<FieldT>(summation_domain_dim, codeword_domain_dim, poly_degree_bound, 3, true, multiplicative_coset_type);
 }
 
+TEST(SumcheckDomainEvaluationCacheTest, SimpleTest) {
+    typedef libff::gf64 FieldT;
+
+    const field_subset<FieldT> summation_domain(1ull << 4);
+    const field_subset<FieldT> codeword_domain(1ull << 7, FieldT(1ull << 7));
+    const field_subset<FieldT> other_codeword_domain(1ull << 8, FieldT(1ull << 8));
+    domain_evaluation_cache<FieldT> cache;
+
+    const std::shared_ptr<const std::vector<FieldT>> Z_over_L =
+        cache.vanishing_polynomial_evaluations(summation_domain, codeword_domain);
+    EXPECT_EQ(*Z_over_L, vanishing_polynomial<FieldT>(summation_domain).evaluations_over_field_subset(codeword_domain));
+    EXPECT_EQ(*cache.inverse_vanishing_polynomial_evaluations(summation_domain, codeword_domain),
+              batch_inverse(*Z_over_L));
+    EXPECT_EQ(*subspace_to_order_H_minus_1(cache, summation_domain, codeword_domain),
+              constant_times_subspace_to_order_H_minus_1(
+                  FieldT::one(), codeword_domain.subspace(), summation_domain.num_elements()));
+    EXPECT_EQ(cache.num_tables(), std::size_t(3));
+
+    /* Tables are computed once per pair of domains, and then shared */
+    EXPECT_EQ(cache.vanishing_polynomial_evaluations(summation_domain, codeword_domain), Z_over_L);
+    EXPECT_EQ(cache.num_tables(), std::size_t(3));
+    EXPECT_NE(cache.vanishing_polynomial_evaluations(summation_domain, other_codeword_domain), Z_over_L);
+    EXPECT_EQ(cache.num_tables(), std::size_t(4));
+}
+
 /** Test that when choosing random polynomials, randomly changing one sum
  *  will cause the verification to fail.
  *  TODO: create test vectors which cover more interesting cases. */
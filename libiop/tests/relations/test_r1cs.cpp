@@ -7,7 +7,9 @@
 #include <libff/algebra/curves/edwards/edwards_pp.hpp>
 #include <libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp>
 #include <libff/common/utils.hpp>
+#include "libiop/algebra/utils.hpp"
 #include "libiop/relations/r1cs.hpp"
+#include "libiop/relations/sparse_matrix.hpp"
 #include "libiop/relations/variable.hpp"
 #include "libiop/relations/examples/r1cs_examples.hpp"
 
@@ -59,4 +61,73 @@ TEST(R1CSGeneratorTest, SimpleTests) {
     }
 }
 
+template<typename FieldT>
+void run_csr_sparse_matrix_test(const std::size_t num_constraints, const std::size_t num_variables)
+{
+    const r1cs_example<FieldT> example = generate_r1cs_example<FieldT>(
+        num_constraints, (1ull << 2) - 1, num_variables);
+    const std::shared_ptr<r1cs_constraint_system<FieldT>> constraint_system =
+        std::make_shared<r1cs_constraint_system<FieldT>>(example.constraint_system_);
+    /* z = (1, v, w) */
+    r1cs_variable_assignment<FieldT> z({FieldT::one()});
+    z.insert(z.end(), example.primary_input_.begin(), example.primary_input_.end());
+    z.insert(z.end(), example.auxiliary_input_.begin(), example.auxiliary_input_.end());
+
+    std::vector<FieldT> Az, Bz, Cz;
+    constraint_system->create_Az_Bz_Cz_from_variable_assignment(z, Az, Bz, Cz);
+    const std::vector<std::vector<FieldT>> expected_Mz({Az, Bz, Cz});
+    const std::vector<FieldT> v = random_FieldT_vector<FieldT>(num_constraints);
+
+    for (std::size_t m = 0; m < all_r1cs_sparse_matrix_types.size(); ++m)
+    {
+        const std::shared_ptr<sparse_matrix<FieldT>> M = std::make_shared<r1cs_sparse_matrix<FieldT>>(
+            constraint_system, all_r1cs_sparse_matrix_types[m]);
+        EXPECT_EQ(M->num_rows(), num_constraints);
+        EXPECT_EQ(M->num_columns(), num_variables + 1);
+        EXPECT_EQ(M->multiply(z), expected_Mz[m]);
+
+        std::vector<FieldT> expected_transpose(num_variables + 1, FieldT::zero());
+        std::size_t num_entries = 0;
+        for (std::size_t i = 0; i < num_constraints; ++i)
+        {
+            for (auto &term : M->get_row(i).terms)
+            {
+                expected_transpose[term.index_] += term.coeff_ * v[i];
+                num_entries++;
+            }
+        }
+        EXPECT_EQ(M->num_nonzero_entries(), num_entries);
+        EXPECT_EQ(M->transpose_multiply(v), expected_transpose);
+        /* The same as the generic sparse_matrix products */
+        EXPECT_EQ(M->transpose_multiply(v), M->sparse_matrix<FieldT>::transpose_multiply(v));
+        EXPECT_EQ(M->multiply(z), M->sparse_matrix<FieldT>::multiply(z));
+
+        /* The same products from a CSR copy */
+        const std::shared_ptr<sparse_matrix<FieldT>> csr = std::make_shared<csr_sparse_matrix<FieldT>>(*M);
+        EXPECT_EQ(csr->num_nonzero_entries(), num_entries);
+        EXPECT_EQ(csr->multiply(z), expected_Mz[m]);
+        EXPECT_EQ(csr->transpose_multiply(v), expected_transpose);
+
+        /* Padding adds empty rows, whose products are zero */
+        csr_sparse_matrix<FieldT> padded(*M);
+        padded.pad_rows(2 * num_constraints);
+        std::vector<FieldT> padded_Mz = padded.multiply(z);
+        EXPECT_EQ(padded_Mz.size(), 2 * num_constraints);
+        EXPECT_EQ(std::vector<FieldT>(padded_Mz.begin(), padded_Mz.begin() + num_constraints), expected_Mz[m]);
+        EXPECT_EQ(padded_Mz.back(), FieldT::zero());
+        EXPECT_THROW(M->get_row(num_constraints), std::invalid_argument);
+        EXPECT_THROW(M->transpose_multiply(random_FieldT_vector<FieldT>(num_constraints + 1)), std::invalid_argument);
+    }
+
+    /* From the map based matrices */
+    const csr_sparse_matrix<FieldT> A(constraint_system->A_matrix());
+    EXPECT_EQ(A.multiply(z), Az);
+}
+
+TEST(CSRSparseMatrixTest, SimpleTest) {
+    run_csr_sparse_matrix_test<libff::gf64>(1ull << 11, (1ull << 10) - 1);
+    libff::alt_bn128_pp::init_public_params();
+    run_csr_sparse_matrix_test<libff::alt_bn128_Fr>(1ull << 11, (1ull << 10) - 1);
+}
+
 }
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cstdint>
 
 #include <gtest/gtest.h>
@@ -8,6 +9,7 @@
 #include "libiop/bcs/hashing/poseidon.hpp"
 #include "libiop/bcs/hashing/algebraic_sponge.hpp"
 #include "libiop/bcs/hashing/hash_enum.hpp"
+#include "libiop/algebra/utils.hpp"
 
 namespace libiop {
 
@@ -118,4 +120,63 @@ TEST(TwoToOneTest, PoseidonTest) {
     ASSERT_TRUE(result == expected);
 }
 
-}
\ No newline at end of file
+TEST(BatchTest, PoseidonTest) {
+    libff::alt_bn128_pp::init_public_params();
+    typedef libff::alt_bn128_Fr FieldT;
+
+    /* Near-MDS with state sizes 3 and 4, and a dense MDS matrix */
+    const poseidon_params<FieldT> params3 = high_alpha_128_bit_altbn_poseidon_params<FieldT>(3);
+    const poseidon_params<FieldT> params4 = high_alpha_128_bit_altbn_poseidon_params<FieldT>(4);
+    const poseidon_params<FieldT> dense_params = default_params<FieldT>();
+    const poseidon_permutation<FieldT, 3, 17> permutation3(params3);
+    const poseidon_permutation<FieldT, 4, 17> permutation4(params4);
+    const poseidon_permutation<FieldT, 3, 5> dense_permutation(dense_params);
+    EXPECT_THROW((poseidon_permutation<FieldT, 3, 17>(dense_params)), std::invalid_argument);
+
+    /* The state size 4 sponge on an empty state, as the generic permutation computes it */
+    poseidon<FieldT> poseidon_sponge4(params4);
+    const FieldT result = poseidon_sponge4.squeeze_vector(1)[0];
+    const FieldT expected = FieldT(bigint<FieldT::num_limbs>("4591479969477772210117313463031620746854841175717972139117724310135444834566"));
+    ASSERT_TRUE(result == expected);
+
+    /* One more state than a multiple of the lanes */
+    const size_t num_states = 2 * poseidon_batch_lanes + 1;
+    const std::vector<FieldT> states3 = random_FieldT_vector<FieldT>(num_states * 3);
+    const std::vector<FieldT> states4 = random_FieldT_vector<FieldT>(num_states * 4);
+    const std::vector<FieldT> dense_states = random_FieldT_vector<FieldT>(num_states * 3);
+
+    std::vector<FieldT> batched3(states3), batched4(states4), dense_batched(dense_states);
+    permutation3.permute_batch(batched3.data(), num_states);
+    permutation4.permute_batch(batched4.data(), num_states);
+    dense_permutation.permute_batch(dense_batched.data(), num_states);
+    for (size_t s = 0; s < num_states; s++)
+    {
+        std::vector<FieldT> single(states3.begin() + 3*s, states3.begin() + 3*(s + 1));
+        permutation3.permute(single.data());
+        ASSERT_TRUE(std::equal(single.begin(), single.end(), batched3.begin() + 3*s));
+
+        single.assign(states4.begin() + 4*s, states4.begin() + 4*(s + 1));
+        permutation4.permute(single.data());
+        ASSERT_TRUE(std::equal(single.begin(), single.end(), batched4.begin() + 4*s));
+
+        single.assign(dense_states.begin() + 3*s, dense_states.begin() + 3*(s + 1));
+        dense_permutation.permute(single.data());
+        ASSERT_TRUE(std::equal(single.begin(), single.end(), dense_batched.begin() + 3*s));
+    }
+
+    /* The batched two to one hash agrees with the sponge based one */
+    std::shared_ptr<algebraic_sponge<FieldT>> sponge = std::make_shared<poseidon<FieldT>>(params4);
+    algebraic_two_to_one_hash<FieldT> sponge_hash(sponge, 128);
+    const poseidon_two_to_one_hash<FieldT> batched_hash(params4);
+    const std::vector<FieldT> children = random_FieldT_vector<FieldT>(num_states * 2);
+    std::vector<FieldT> parents(num_states);
+    batched_hash.hash_batch(children.data(), parents.data(), num_states);
+    for (size_t i = 0; i < num_states; i++)
+    {
+        const FieldT expected = sponge_hash.hash(children[2*i], children[2*i + 1]);
+        ASSERT_TRUE(parents[i] == expected);
+        ASSERT_TRUE(batched_hash(children[2*i], children[2*i + 1], 32) == expected);
+    }
+}
+
+}
@@ -1,7 +1,12 @@
 #include <cstdint>
+#include <cstring>
+#include <vector>
 
 #include <gtest/gtest.h>
 
+#include "libiop/algebra/utils.hpp"
+#include "libiop/bcs/hashing/blake2b.hpp"
+#include "libiop/bcs/hashing/blake3.hpp"
 #include "libiop/bcs/hashing/hashing.hpp"
 #include "libiop/bcs/hashing/hash_enum.hpp"
 #include "libiop/bcs/pow.hpp"
@@ -32,6 +37,62 @@ TEST(BinaryPoWTest, SimpleTest) {
     EXPECT_TRUE(prover.verify_pow(compressive_hash, challenge, proof));
 }
 
+/* The answer a serial search over nonces finds */
+template<typename FieldT>
+binary_hash_digest serial_pow_answer(const pow<FieldT, binary_hash_digest> &prover,
+                                     const two_to_one_hash_function<binary_hash_digest> &compressive_hash,
+                                     const binary_hash_digest &challenge)
+{
+    binary_hash_digest answer = challenge;
+    const size_t nonce_offset = (answer.length() / sizeof(size_t) - 1) * sizeof(size_t);
+    for (size_t nonce = 0; !prover.verify_pow(compressive_hash, challenge, answer); ++nonce)
+    {
+        std::memcpy(&answer[nonce_offset], &nonce, sizeof(size_t));
+    }
+    return answer;
+}
+
+/* Parallel search finds the same smallest nonce as a serial one, both through the batched
+   path for the given hash type and with the hash wrapped so that it is called once per nonce */
+void run_smallest_nonce_test(const bcs_hash_type hash_enum,
+                             const two_to_one_hash_function<binary_hash_digest> &unwrapped_hash)
+{
+    libff::alt_bn128_pp::init_public_params();
+    typedef libff::alt_bn128_Fr FieldT;
+    typedef binary_hash_digest hash_type;
+    const size_t security_parameter = 128;
+    const size_t digest_len_bytes = 2 * security_parameter/8;
+
+    const two_to_one_hash_function<hash_type> hash =
+        get_two_to_one_hash<hash_type, FieldT>(hash_enum, security_parameter);
+    /* Not recognized as the hash type, so it is called once per nonce */
+    const two_to_one_hash_function<hash_type> wrapped_hash =
+        [unwrapped_hash](const hash_type &first, const hash_type &second, const size_t digest_len) {
+            return unwrapped_hash(first, second, digest_len);
+        };
+
+    for (size_t log_work = 0; log_work <= 14; log_work += 7)
+    {
+        const pow<FieldT, hash_type> prover(pow_parameters(log_work, 1), digest_len_bytes);
+        for (size_t trial = 0; trial < 4; ++trial)
+        {
+            const std::vector<uint8_t> bytes = random_vector<uint8_t>(digest_len_bytes);
+            const hash_type challenge(bytes.begin(), bytes.end());
+            const hash_type expected = serial_pow_answer<FieldT>(prover, hash, challenge);
+            EXPECT_EQ(prover.solve_pow(hash, challenge), expected);
+            EXPECT_EQ(prover.solve_pow(wrapped_hash, challenge), expected);
+        }
+    }
+}
+
+TEST(BinaryPoWTest, SmallestNonceTest) {
+    run_smallest_nonce_test(blake2b_type, blake2b_two_to_one_hash);
+}
+
+TEST(BinaryPoWTest, Blake3SmallestNonceTest) {
+    run_smallest_nonce_test(blake3_type, blake3_two_to_one_hash);
+}
+
 TEST(AlgeraicPoWTest, SimpleTest) {
     /* Set up field / pow params */
     libff::alt_bn128_pp::init_public_params();
@@ -94,4 +94,103 @@ TEST(TranscriptSerializationOnSnark, SimpleTest) {
     }
 }
 
+
+template<typename FieldT, typename hash_type>
+void run_binary_transcript_serialization_test(const aurora_snark_parameters<FieldT, hash_type> &params)
+{
+    const size_t num_constraints = 1 << 5;
+    const size_t num_inputs = (1 << 2) - 1;
+    const size_t num_variables = (1 << 4) - 1;
+    r1cs_example<FieldT> r1cs_params = generate_r1cs_example<FieldT>(
+        num_constraints, num_inputs, num_variables);
+
+    const aurora_snark_argument<FieldT, hash_type> argument = aurora_snark_prover<FieldT>(
+        r1cs_params.constraint_system_,
+        r1cs_params.primary_input_,
+        r1cs_params.auxiliary_input_,
+        params);
+
+    std::ostringstream s1;
+    argument.serialize_binary(s1);
+    const std::string bytes = s1.str();
+
+    /* From a buffer, and through deserialize, which recognizes the format */
+    aurora_snark_argument<FieldT, hash_type> from_buffer;
+    from_buffer.deserialize_binary(reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size());
+    std::istringstream s2(bytes);
+    aurora_snark_argument<FieldT, hash_type> from_stream;
+    from_stream.deserialize(s2);
+
+    std::ostringstream s3, s4;
+    from_buffer.serialize_binary(s3);
+    from_stream.serialize_binary(s4);
+    EXPECT_EQ(s3.str(), bytes);
+    EXPECT_EQ(s4.str(), bytes);
+    EXPECT_TRUE(from_buffer.proof_of_work_ == argument.proof_of_work_);
+
+    EXPECT_TRUE(aurora_snark_verifier<FieldT>(
+        r1cs_params.constraint_system_,
+        r1cs_params.primary_input_,
+        from_buffer,
+        params));
+
+    /* Malformed proofs are rejected, and leave the transcript as it was */
+    const unsigned char *data = reinterpret_cast<const unsigned char*>(bytes.data());
+    EXPECT_THROW(from_buffer.deserialize_binary(data, bytes.size() - 1), std::invalid_argument);
+    std::string corrupt_version(bytes);
+    corrupt_version[4] ^= 1;
+    EXPECT_THROW(from_buffer.deserialize_binary(
+        reinterpret_cast<const unsigned char*>(corrupt_version.data()), corrupt_version.size()), std::invalid_argument);
+    std::string trailing(bytes + "x");
+    EXPECT_THROW(from_buffer.deserialize_binary(
+        reinterpret_cast<const unsigned char*>(trailing.data()), trailing.size()), std::invalid_argument);
+    std::ostringstream s5;
+    from_buffer.serialize_binary(s5);
+    EXPECT_EQ(s5.str(), bytes);
+}
+
+TEST(TranscriptBinarySerializationOnSnark, MultiplicativeTest) {
+    libff::alt_bn128_pp::init_public_params();
+    typedef libff::alt_bn128_Fr FieldT;
+    typedef FieldT hash_type;
+
+    for (std::size_t i = 0; i < 2; i++) {
+        const bool make_zk = (i == 1);
+        aurora_snark_parameters<FieldT, hash_type> params(
+            128,
+            LDT_reducer_soundness_type::optimistic_heuristic,
+            FRI_soundness_type::heuristic,
+            high_alpha_poseidon_type,
+            3,
+            2,
+            make_zk,
+            multiplicative_coset_type,
+            1 << 5,
+            (1 << 4) - 1);
+        run_binary_transcript_serialization_test<FieldT, hash_type>(params);
+    }
+}
+
+TEST(TranscriptBinarySerializationOnSnark, BinaryFieldTest) {
+    typedef libff::gf64 FieldT;
+    typedef binary_hash_digest hash_type;
+
+    for (std::size_t i = 0; i < 2; i++) {
+        const bool make_zk = (i == 1);
+        aurora_snark_parameters<FieldT, hash_type> params(
+            128,
+            LDT_reducer_soundness_type::optimistic_heuristic,
+            FRI_soundness_type::heuristic,
+            blake2b_type,
+            2,
+            2,
+            make_zk,
+            affine_subspace_type,
+            false,
+            1 << 5,
+            (1 << 4) - 1);
+        run_binary_transcript_serialization_test<FieldT, hash_type>(params);
+    }
+}
+
 }